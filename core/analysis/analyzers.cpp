@@ -35,6 +35,7 @@
 #include "analysis/text_token_stream.hpp"
 #include "analysis/token_stopwords_stream.hpp"
 #include "analysis/pipeline_token_stream.hpp"
+#include "analysis/shingle_token_stream.hpp"
 #include "analysis/segmentation_token_stream.hpp"
 #endif
 
@@ -217,6 +218,7 @@ namespace analysis {
   irs::analysis::text_token_stream::init();
   irs::analysis::token_stopwords_stream::init();
   irs::analysis::pipeline_token_stream::init();
+  irs::analysis::shingle_token_stream::init();
   irs::analysis::segmentation_token_stream::init();
 #endif
 }
@@ -0,0 +1,357 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shingle_token_stream.hpp"
+
+#include "velocypack/Slice.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Parser.h"
+#include "velocypack/velocypack-aliases.h"
+#include "utils/vpack_utils.hpp"
+
+#include <string_view>
+
+namespace {
+
+constexpr std::string_view DELIMITER_PARAM_NAME  {"delimiter"};
+constexpr std::string_view ANALYZER_PARAM_NAME   {"analyzer"};
+constexpr std::string_view TYPE_PARAM_NAME       {"type"};
+constexpr std::string_view PROPERTIES_PARAM_NAME {"properties"};
+
+struct normalized_options {
+  std::string type;
+  std::string properties; // normalized properties in VPack format
+  std::string delimiter{irs::analysis::shingle_token_stream::kDefaultDelimiter};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parses a definition of a wrapped analyzer
+////////////////////////////////////////////////////////////////////////////////
+bool parse_analyzer(
+    const VPackSlice slice,
+    irs::string_ref& type,
+    VPackSlice& properties) {
+  if (!slice.isObject()) {
+    IR_FRMT_ERROR(
+      "Failed to read '%s' attribute as object while constructing "
+      "shingle_token_stream from VPack arguments",
+      ANALYZER_PARAM_NAME.data());
+    return false;
+  }
+
+  auto type_slice = slice.get(TYPE_PARAM_NAME);
+  if (!type_slice.isString()) {
+    IR_FRMT_ERROR(
+      "Failed to read '%s' attribute of '%s' member as string while "
+      "constructing shingle_token_stream from VPack arguments",
+      TYPE_PARAM_NAME.data(), ANALYZER_PARAM_NAME.data());
+    return false;
+  }
+  type = irs::get_string<irs::string_ref>(type_slice);
+
+  properties = slice.get(PROPERTIES_PARAM_NAME);
+  if (properties.isNone()) {
+    IR_FRMT_ERROR(
+      "Failed to get '%s' attribute of '%s' member while constructing "
+      "shingle_token_stream from VPack arguments",
+      PROPERTIES_PARAM_NAME.data(), ANALYZER_PARAM_NAME.data());
+    return false;
+  }
+
+  return true;
+}
+
+template<typename Options>
+bool parse_vpack_options(const VPackSlice slice, Options& options) {
+  if (!slice.isObject()) {
+    IR_FRMT_ERROR(
+      "Not a VPack object passed while constructing shingle_token_stream");
+    return false;
+  }
+
+  if (slice.hasKey(DELIMITER_PARAM_NAME)) {
+    auto delimiter_slice = slice.get(DELIMITER_PARAM_NAME);
+    if (!delimiter_slice.isString()) {
+      IR_FRMT_ERROR(
+        "Invalid type '%s' (string expected) for shingle_token_stream from "
+        "VPack arguments",
+        DELIMITER_PARAM_NAME.data());
+      return false;
+    }
+    options.delimiter = irs::get_string<irs::string_ref>(delimiter_slice);
+  }
+
+  if (!slice.hasKey(ANALYZER_PARAM_NAME)) {
+    IR_FRMT_ERROR(
+      "Not found parameter '%s' while constructing shingle_token_stream",
+      ANALYZER_PARAM_NAME.data());
+    return false;
+  }
+
+  irs::string_ref type;
+  VPackSlice properties;
+  if (!parse_analyzer(slice.get(ANALYZER_PARAM_NAME), type, properties)) {
+    return false;
+  }
+
+  if constexpr (std::is_same_v<Options, irs::analysis::shingle_token_stream::options_t>) {
+    options.analyzer = irs::analysis::analyzers::get(
+      type, irs::type<irs::text_format::vpack>::get(),
+      { properties.startAs<char>(), properties.byteSize() });
+
+    // fallback to json format if vpack isn't available
+    if (!options.analyzer) {
+      options.analyzer = irs::analysis::analyzers::get(
+        type, irs::type<irs::text_format::json>::get(),
+        irs::slice_to_string(properties));
+    }
+
+    if (!options.analyzer) {
+      IR_FRMT_ERROR(
+        "Failed to create analyzer of type '%s' with properties '%s' while "
+        "constructing shingle_token_stream from VPack arguments",
+        type.c_str(), irs::slice_to_string(properties).c_str());
+      return false;
+    }
+  } else {
+    options.type = type;
+
+    std::string normalized;
+    if (irs::analysis::analyzers::normalize(
+          normalized, type, irs::type<irs::text_format::vpack>::get(),
+          { properties.startAs<char>(), properties.byteSize() })) {
+      options.properties = std::move(normalized);
+    } else if (irs::analysis::analyzers::normalize(
+                 normalized, type, irs::type<irs::text_format::json>::get(),
+                 irs::slice_to_string(properties))) {
+      // in options we'll store vpack as string
+      auto vpack = VPackParser::fromJson(normalized.c_str(), normalized.size());
+      options.properties.assign(
+        vpack->slice().startAs<char>(), vpack->slice().byteSize());
+    } else {
+      IR_FRMT_ERROR(
+        "Failed to normalize analyzer of type '%s' with properties '%s' while "
+        "constructing shingle_token_stream from VPack arguments",
+        type.c_str(), irs::slice_to_string(properties).c_str());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool normalize_vpack_config(const VPackSlice slice, VPackBuilder* builder) {
+  normalized_options options;
+  if (!parse_vpack_options(slice, options)) {
+    return false;
+  }
+
+  VPackObjectBuilder object(builder);
+  {
+    builder->add(DELIMITER_PARAM_NAME, VPackValue(options.delimiter));
+    VPackObjectBuilder analyzer(builder, ANALYZER_PARAM_NAME.data());
+    {
+      builder->add(TYPE_PARAM_NAME, VPackValue(options.type));
+      VPackSlice properties(
+        reinterpret_cast<const uint8_t*>(options.properties.c_str()));
+      builder->add(PROPERTIES_PARAM_NAME, properties);
+    }
+  }
+
+  return true;
+}
+
+bool normalize_vpack_config(irs::string_ref args, std::string& config) {
+  VPackSlice slice(reinterpret_cast<const uint8_t*>(args.c_str()));
+  VPackBuilder builder;
+  if (normalize_vpack_config(slice, &builder)) {
+    config.assign(builder.slice().startAs<char>(), builder.slice().byteSize());
+    return true;
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief args is a jSON encoded object with the following attributes:
+///        "analyzer"(object): definition of an analyzer producing tokens to
+///                            combine, an object with "type" and "properties"
+///                            attributes <required>
+///        "delimiter"(string): separates tokens in a pair (default: " ")
+////////////////////////////////////////////////////////////////////////////////
+irs::analysis::analyzer::ptr make_vpack(const VPackSlice slice) {
+  irs::analysis::shingle_token_stream::options_t options;
+  if (parse_vpack_options(slice, options)) {
+    return irs::memory::make_unique<irs::analysis::shingle_token_stream>(
+      std::move(options));
+  } else {
+    return nullptr;
+  }
+}
+
+irs::analysis::analyzer::ptr make_vpack(irs::string_ref args) {
+  VPackSlice slice(reinterpret_cast<const uint8_t*>(args.c_str()));
+  return make_vpack(slice);
+}
+
+irs::analysis::analyzer::ptr make_json(irs::string_ref args) {
+  try {
+    if (args.null()) {
+      IR_FRMT_ERROR("Null arguments while constructing shingle_token_stream");
+      return nullptr;
+    }
+    auto vpack = VPackParser::fromJson(args.c_str(), args.size());
+    return make_vpack(vpack->slice());
+  } catch(const VPackException& ex) {
+    IR_FRMT_ERROR(
+      "Caught error '%s' while constructing shingle_token_stream from JSON",
+      ex.what());
+  } catch (...) {
+    IR_FRMT_ERROR(
+      "Caught error while constructing shingle_token_stream from JSON");
+  }
+  return nullptr;
+}
+
+bool normalize_json_config(irs::string_ref args, std::string& definition) {
+  try {
+    if (args.null()) {
+      IR_FRMT_ERROR("Null arguments while normalizing shingle_token_stream");
+      return false;
+    }
+    auto vpack = VPackParser::fromJson(args.c_str(), args.size());
+    VPackBuilder builder;
+    if (normalize_vpack_config(vpack->slice(), &builder)) {
+      definition = builder.toString();
+      return !definition.empty();
+    }
+  } catch(const VPackException& ex) {
+    IR_FRMT_ERROR(
+      "Caught error '%s' while normalizing shingle_token_stream from JSON",
+      ex.what());
+  } catch (...) {
+    IR_FRMT_ERROR(
+      "Caught error while normalizing shingle_token_stream from JSON");
+  }
+  return false;
+}
+
+REGISTER_ANALYZER_JSON(irs::analysis::shingle_token_stream, make_json,
+  normalize_json_config);
+
+REGISTER_ANALYZER_VPACK(irs::analysis::shingle_token_stream, make_vpack,
+  normalize_vpack_config);
+
+} // namespace
+
+namespace iresearch {
+namespace analysis {
+
+shingle_token_stream::shingle_token_stream(options_t&& options)
+  : analyzer{irs::type<shingle_token_stream>::get()},
+    analyzer_{std::move(options.analyzer)},
+    term_{analyzer_ ? irs::get<term_attribute>(*analyzer_) : nullptr},
+    inc_{analyzer_ ? irs::get<increment>(*analyzer_) : nullptr},
+    offs_{analyzer_ ? irs::get<offset>(*analyzer_) : nullptr},
+    delimiter_{std::move(options.delimiter)} {
+  if (!term_ || !inc_) {
+    analyzer_ = nullptr; // the analyzer is useless without its tokens
+  }
+
+  if (offs_) {
+    std::get<attribute_ptr<offset>>(attrs_) = &offset_;
+  }
+}
+
+/*static*/ void shingle_token_stream::init() {
+  REGISTER_ANALYZER_JSON(shingle_token_stream, make_json,
+    normalize_json_config);  // match registration above
+
+  REGISTER_ANALYZER_VPACK(shingle_token_stream, make_vpack,
+    normalize_vpack_config); // match registration above
+}
+
+bool shingle_token_stream::next() {
+  if (!analyzer_) {
+    return false;
+  }
+
+  // the last token is paired with every token at the previous position,
+  // e.g. synonyms, otherwise a phrase over any of them wouldn't find a pair
+  while (next_prev_ >= prev_.size()) {
+    if (!analyzer_->next()) {
+      return false;
+    }
+
+    const uint32_t pos = pos_ + inc_->value;
+
+    if (cur_.empty() || pos != pos_) {
+      if (!cur_.empty() && pos == pos_ + 1) {
+        prev_.swap(cur_);
+        prev_pos_ = pos_;
+      } else {
+        prev_.clear(); // a gap, nothing to pair with
+      }
+
+      cur_.clear();
+      pos_ = pos;
+    }
+
+    const bytes_ref term = term_->value;
+    cur_.emplace_back(token{
+      bstring(term.c_str(), term.size()), offs_ ? offs_->start : 0 });
+    end_ = offs_ ? offs_->end : 0;
+    next_prev_ = 0;
+  }
+
+  const auto& prev = prev_[next_prev_++];
+  const auto& last = cur_.back();
+
+  term_buf_.assign(prev.term);
+  term_buf_.append(ref_cast<byte_type>(string_ref(delimiter_)));
+  term_buf_.append(last.term);
+
+  // a pair is placed at the position of its first token
+  std::get<increment>(attrs_).value = prev_pos_ - last_pos_;
+  std::get<term_attribute>(attrs_).value = term_buf_;
+  last_pos_ = prev_pos_;
+
+  if (offs_) {
+    offset_.start = prev.start;
+    offset_.end = end_;
+  }
+
+  return true;
+}
+
+bool shingle_token_stream::reset(string_ref data) {
+  pos_ = pos_limits::invalid();
+  last_pos_ = pos_limits::invalid();
+  prev_pos_ = pos_limits::invalid();
+  prev_.clear();
+  cur_.clear();
+  next_prev_ = 0;
+
+  return analyzer_ && analyzer_->reset(data);
+}
+
+} // analysis
+} // ROOT
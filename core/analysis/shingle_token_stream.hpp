@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_SHINGLE_TOKEN_STREAM_H
+#define IRESEARCH_SHINGLE_TOKEN_STREAM_H
+
+#include <vector>
+
+#include "analysis/analyzers.hpp"
+#include "analysis/token_attributes.hpp"
+#include "utils/frozen_attributes.hpp"
+
+namespace iresearch {
+namespace analysis {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class shingle_token_stream
+/// @brief produces pairs of adjacent tokens (word bigrams) emitted by a
+///        wrapped analyzer, e.g. "new york city" -> "new york", "york city"
+/// @note a pair is emitted at the position of its first token, i.e. positions
+///       of pairs match positions of the words they start with, every token
+///       at a position is combined with every token at the next one (e.g.
+///       synonyms), pairs of tokens separated by a gap (e.g. a removed
+///       stopword) or sharing the same position are not emitted
+/// @note intended for a companion field of a text field, see
+///       'by_phrase_options::shingles(...)'
+////////////////////////////////////////////////////////////////////////////////
+class shingle_token_stream final
+    : public analyzer,
+      private util::noncopyable {
+ public:
+  struct options_t {
+    irs::analysis::analyzer::ptr analyzer; // produces tokens to combine
+    std::string delimiter{kDefaultDelimiter}; // separates tokens in a pair
+  };
+
+  static constexpr string_ref kDefaultDelimiter{" "};
+
+  static constexpr string_ref type_name() noexcept { return "shingle"; }
+  static void init(); // for triggering registration in a static build
+
+  explicit shingle_token_stream(options_t&& options);
+
+  virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    return irs::get_mutable(attrs_, type);
+  }
+  virtual bool next() override;
+  virtual bool reset(string_ref data) override;
+
+  const std::string& delimiter() const noexcept { return delimiter_; }
+
+ private:
+  using attributes = std::tuple<
+    increment,
+    attribute_ptr<offset>,
+    term_attribute>;
+
+  struct token {
+    bstring term;
+    uint32_t start;
+  };
+
+  analyzer::ptr analyzer_;
+  const term_attribute* term_;
+  const increment* inc_;
+  const offset* offs_;
+  std::string delimiter_;
+  std::vector<token> prev_; // tokens at the previous position
+  std::vector<token> cur_; // tokens at the current position
+  bstring term_buf_; // buffer for the last emitted pair
+  size_t next_prev_{}; // next token of 'prev_' to pair with the last of 'cur_'
+  uint32_t prev_pos_{}; // position of the previous tokens
+  uint32_t pos_{}; // position of the current tokens
+  uint32_t end_{}; // end offset of the last token
+  uint32_t last_pos_{}; // position of the last emitted pair
+  offset offset_;
+  attributes attrs_;
+}; // shingle_token_stream
+
+} // analysis
+} // ROOT
+
+#endif // IRESEARCH_SHINGLE_TOKEN_STREAM_H
@@ -110,6 +110,46 @@ struct frequency final : attribute {
   uint32_t value{0};
 }; // frequency
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class impact
+/// @brief upper bound of the number of times term appears in a document
+///        within a block of postings, allows to evaluate score upper bounds
+///        without decoding the block
+//////////////////////////////////////////////////////////////////////////////
+class impact final : public attribute {
+ public:
+  using shallow_seek_f = std::function<doc_id_t(doc_id_t)>;
+
+  // DO NOT CHANGE NAME
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::impact";
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief moves to the block containing the specified 'target' without
+  ///        decoding postings and updates 'max_doc' and 'max_freq'
+  /// @note 'target' is expected to not decrease between the calls
+  /// @returns the last document of the block
+  ////////////////////////////////////////////////////////////////////////////
+  doc_id_t shallow_seek(doc_id_t target) {
+    assert(seek_);
+    return seek_(target);
+  }
+
+  void reset(shallow_seek_f&& seek) noexcept {
+    seek_ = std::move(seek);
+  }
+
+  // last document of the current block, 'doc_limits::eof()' if
+  // the current block is the last one
+  doc_id_t max_doc{doc_limits::invalid()};
+  // maximum number of times term appears in a document of the current block
+  uint32_t max_freq{std::numeric_limits<uint32_t>::max()};
+
+ private:
+  shallow_seek_f seek_;
+}; // impact
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class granularity_prefix
 /// @brief indexed tokens are prefixed with one byte indicating granularity
@@ -29,6 +29,7 @@
 #include "search/score.hpp"
 #include "utils/compression.hpp"
 #include "utils/directory_utils.hpp"
+#include "utils/memory_pool.hpp"
 #include "utils/string_utils.hpp"
 
 namespace {
@@ -164,11 +165,13 @@ std::vector<uint64_t> read_blocks_dense(
 template<typename PayloadReader>
 class range_column_iterator final
     : public resettable_doc_iterator,
+      public memory::pooled_object<range_column_iterator<PayloadReader>>,
       private PayloadReader {
  private:
   using payload_reader = PayloadReader;
 
-  using attributes = std::tuple<document, cost, score, irs::payload>;
+  using attributes = std::tuple<
+    document, cost, score, irs::payload, column_batch>;
 
  public:
   template<typename... Args>
@@ -180,6 +183,10 @@ class range_column_iterator final
     assert(min_doc_ <= max_doc_);
     assert(!doc_limits::eof(max_doc_));
     std::get<irs::cost>(attrs_).reset(header.docs_count);
+
+    auto& batch = std::get<column_batch>(attrs_);
+    batch.ctx = this;
+    batch.read = &read_batch;
   }
 
   virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
@@ -234,6 +241,40 @@ class range_column_iterator final
   }
 
  private:
+  static size_t read_batch(
+      void* ctx, const doc_id_t* docs,
+      bytes_ref* values, size_t count) {
+    assert(ctx);
+    auto& self = *static_cast<range_column_iterator*>(ctx);
+    auto& doc = std::get<document>(self.attrs_);
+
+    self.batch_.clear();
+
+    if (count && docs[0] < self.min_doc_) {
+      self.reset();
+    }
+
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i) {
+      const doc_id_t target = docs[i];
+      assert(!i || docs[i - 1] < target);
+
+      if (self.min_doc_ <= target && target <= self.max_doc_) {
+        // no need to go through the document index
+        self.batch_.push(values, i, self.payload(target - self.min_base_));
+        self.min_doc_ = target + 1;
+        doc.value = target;
+        ++found;
+      } else {
+        values[i] = bytes_ref::NIL;
+      }
+    }
+
+    self.batch_.flush(values);
+    return found;
+  }
+
+  value_batch<payload_reader::kDirect> batch_;
   doc_id_t min_base_;
   doc_id_t min_doc_;
   doc_id_t max_doc_;
@@ -247,6 +288,7 @@ class range_column_iterator final
 template<typename PayloadReader>
 class bitmap_column_iterator final
     : public resettable_doc_iterator,
+      public memory::pooled_object<bitmap_column_iterator<PayloadReader>>,
       private PayloadReader {
  private:
   using payload_reader = PayloadReader;
@@ -255,7 +297,8 @@ class bitmap_column_iterator final
     attribute_ptr<document>,
     cost,
     attribute_ptr<score>,
-    irs::payload>;
+    irs::payload,
+    column_batch>;
 
  public:
   template<typename... Args>
@@ -269,6 +312,10 @@ class bitmap_column_iterator final
     std::get<irs::cost>(attrs_).reset(cost);
     std::get<attribute_ptr<document>>(attrs_) = irs::get_mutable<document>(&bitmap_);
     std::get<attribute_ptr<score>>(attrs_) = irs::get_mutable<score>(&bitmap_);
+
+    auto& batch = std::get<column_batch>(attrs_);
+    batch.ctx = this;
+    batch.read = &read_batch;
   }
 
   virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
@@ -307,6 +354,47 @@ class bitmap_column_iterator final
   }
 
  private:
+  static size_t read_batch(
+      void* ctx, const doc_id_t* docs,
+      bytes_ref* values, size_t count) {
+    assert(ctx);
+    auto& self = *static_cast<bitmap_column_iterator*>(ctx);
+    auto& bitmap = self.bitmap_;
+
+    self.batch_.clear();
+
+    if (count && docs[0] < bitmap.value()) {
+      bitmap.reset();
+    }
+
+    size_t found = 0;
+    size_t i = 0;
+    for (; i < count; ++i) {
+      const doc_id_t target = docs[i];
+      assert(!i || docs[i - 1] < target);
+
+      doc_id_t doc = bitmap.value();
+      if (doc < target) {
+        doc = bitmap.seek(target);
+      }
+
+      if (doc == target) {
+        self.batch_.push(values, i, self.payload(bitmap.index()));
+        ++found;
+      } else if (doc_limits::eof(doc)) {
+        break;
+      } else {
+        values[i] = bytes_ref::NIL;
+      }
+    }
+
+    std::fill(values + i, values + count, bytes_ref::NIL);
+
+    self.batch_.flush(values);
+    return found;
+  }
+
+  value_batch<payload_reader::kDirect> batch_;
   sparse_bitmap_iterator bitmap_;
   attributes attrs_;
 }; // bitmap_column_iterator
@@ -528,6 +616,8 @@ class encrypted_value_reader {
 ////////////////////////////////////////////////////////////////////////////////
 struct mask_column final : public column_base {
   struct payload_reader {
+    static constexpr bool kDirect = true;
+
     bytes_ref payload(doc_id_t) noexcept {
       return bytes_ref::NIL;
     }
@@ -632,6 +722,10 @@ class dense_fixed_length_column final : public column_base {
   template<typename ValueReader>
   class payload_reader : private ValueReader {
    public:
+    // returned values remain valid until the reader is destroyed
+    static constexpr bool kDirect =
+      std::is_same_v<ValueReader, value_direct_reader>;
+
     template<typename... Args>
     payload_reader(
         uint64_t len, uint64_t data,
@@ -749,6 +843,10 @@ class fixed_length_column final : public column_base {
   template<typename ValueReader>
   class payload_reader : private ValueReader {
    public:
+    // returned values remain valid until the reader is destroyed
+    static constexpr bool kDirect =
+      std::is_same_v<ValueReader, value_direct_reader>;
+
     template<typename... Args>
     payload_reader(
         const column_block* blocks,
@@ -851,6 +949,10 @@ class sparse_column final : public column_base {
   template<typename ValueReader>
   class payload_reader : private ValueReader {
    public:
+    // returned values remain valid until the reader is destroyed
+    static constexpr bool kDirect =
+      std::is_same_v<ValueReader, value_direct_reader>;
+
     template<typename... Args>
     payload_reader(
         const column_block* blocks,
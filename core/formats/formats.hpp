@@ -23,6 +23,8 @@
 #ifndef IRESEARCH_FORMAT_H
 #define IRESEARCH_FORMAT_H
 
+#include <vector>
+
 #include <absl/container/flat_hash_set.h>
 
 #include "shared.hpp"
@@ -338,6 +340,83 @@ struct columnstore_writer {
 
 namespace iresearch {
 
+////////////////////////////////////////////////////////////////////////////////
+/// @struct column_batch
+/// @brief an optional attribute of a column iterator, reads values of
+///        multiple documents at once without going through 'seek(...)'
+////////////////////////////////////////////////////////////////////////////////
+struct column_batch final : attribute {
+  // Reads values of 'count' documents 'docs' into 'values'.
+  using read_f = size_t(*)(void* ctx, const doc_id_t* docs,
+                           bytes_ref* values, size_t count);
+
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::column_batch";
+  }
+
+  // Documents 'docs' must be sorted in ascending order, the iterator is
+  // rewound if they precede its current position, i.e. an iterator can be
+  // reused for subsequent batches. A document without a value gets
+  // 'bytes_ref::NIL', a document of a column without data (e.g. a mask) gets
+  // 'bytes_ref::EMPTY'. Returned values are valid until the next call or
+  // until the iterator is moved. Afterwards the iterator may only be moved
+  // via 'seek(...)' to a document following the last one in 'docs'.
+  // Returns number of documents having a value.
+  size_t operator()(const doc_id_t* docs, bytes_ref* values, size_t count) const {
+    assert(read);
+    return read(ctx, docs, values, count);
+  }
+
+  void* ctx{};
+  read_f read{};
+}; // column_batch
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class value_batch
+/// @brief keeps values read by a 'column_batch' call valid until the next one,
+///        'Direct' denotes values that remain valid without copying
+////////////////////////////////////////////////////////////////////////////////
+template<bool Direct>
+class value_batch {
+ public:
+  void clear() noexcept { }
+
+  void push(bytes_ref* values, size_t i, bytes_ref value) noexcept {
+    values[i] = value.null() ? bytes_ref::EMPTY : value;
+  }
+
+  void flush(bytes_ref* /*values*/) noexcept { }
+}; // value_batch
+
+template<>
+class value_batch<false> {
+ public:
+  void clear() noexcept {
+    buf_.clear();
+    offsets_.clear();
+  }
+
+  void push(bytes_ref* values, size_t i, bytes_ref value) {
+    // a value is overwritten by the next read, hence copy it, the
+    // address is fixed on 'flush(...)' since the buffer may grow
+    offsets_.emplace_back(i, buf_.size());
+    if (!value.empty()) {
+      buf_.append(value.c_str(), value.size());
+    }
+    values[i] = { nullptr, value.size() };
+  }
+
+  void flush(bytes_ref* values) noexcept {
+    for (const auto& [i, offset] : offsets_) {
+      values[i] = { buf_.c_str() + offset, values[i].size() };
+    }
+  }
+
+ private:
+  bstring buf_;
+  std::vector<std::pair<size_t, size_t>> offsets_;
+}; // value_batch
+
 struct column_reader {
   virtual ~column_reader() = default;
 
@@ -401,6 +480,19 @@ struct document_mask_writer {
     directory& dir,
     const segment_meta& meta,
     const document_mask& docs_mask) = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief writes documents 'docs_mask' removed from a segment since its
+  ///        version 'prev_version', i.e. the mask of 'meta' is a union of
+  ///        'docs_mask' and the mask of the segment at 'prev_version' (if any)
+  /// @returns names of files of the previous mask which aren't referenced
+  ///          by the new one anymore
+  //////////////////////////////////////////////////////////////////////////////
+  virtual std::vector<std::string> update(
+    directory& dir,
+    const segment_meta& meta,
+    uint64_t prev_version,
+    const document_mask& docs_mask) = 0;
 }; // document_mask_writer
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -58,6 +58,7 @@ extern "C" {
 #include "utils/memory.hpp"
 #include "utils/memory_pool.hpp"
 #include "utils/noncopyable.hpp"
+#include "utils/simd_dispatch.hpp"
 #include "utils/timer_utils.hpp"
 #include "utils/type_limits.hpp"
 #include "utils/std.hpp"
@@ -78,6 +79,9 @@ struct format_traits {
 
   static constexpr uint32_t BLOCK_SIZE = 128;
 
+  // blocks of documents are stored as any other block
+  static constexpr bool DENSE_DOCS = false;
+
   FORCE_INLINE static void pack_block32(
       const uint32_t* RESTRICT decoded,
       uint32_t* RESTRICT encoded,
@@ -135,6 +139,47 @@ struct format_traits {
   }
 }; // format_traits
 
+// blocks with a few outliers are stored patched (PFOR), i.e. outliers
+// don't inflate a number of bits used to pack the whole block
+struct format_traits_pfor : format_traits {
+  FORCE_INLINE static void write_block(
+      index_output& out, const uint32_t* in, uint32_t* buf) {
+    bitpack::write_block32_patched<BLOCK_SIZE>(&pack_block32, out, in, buf);
+  }
+
+  FORCE_INLINE static void read_block(
+      index_input& in, uint32_t* buf,  uint32_t* out) {
+    bitpack::read_block32_patched<BLOCK_SIZE>(&unpack_block32, in, buf, out);
+  }
+
+  FORCE_INLINE static void skip_block(index_input& in) {
+    bitpack::skip_block32_patched(in, BLOCK_SIZE);
+  }
+}; // format_traits_pfor
+
+// dense blocks of documents are stored as bitmaps, e.g. they're
+// OR'ed into a resulting bitset without decoding
+struct format_traits_dense : format_traits_pfor {
+  static constexpr bool DENSE_DOCS = true;
+
+  FORCE_INLINE static void write_doc_block(
+      index_output& out, const uint32_t* in, uint32_t* buf) {
+    bitpack::write_block32_dense<BLOCK_SIZE>(&pack_block32, out, in, buf);
+  }
+
+  FORCE_INLINE static void read_doc_block(
+      index_input& in, uint32_t* buf,  uint32_t* out) {
+    bitpack::read_block32_dense<BLOCK_SIZE>(&unpack_block32, in, buf, out);
+  }
+
+  template<typename Visitor>
+  FORCE_INLINE static bool visit_doc_block(
+      index_input& in, uint32_t* buf, uint32_t* out, Visitor&& visitor) {
+    return bitpack::visit_block32_dense<BLOCK_SIZE>(
+      &unpack_block32, in, buf, out, std::forward<Visitor>(visitor));
+  }
+}; // format_traits_dense
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                             forward declarations
 // ----------------------------------------------------------------------------
@@ -231,7 +276,9 @@ class postings_writer_base : public irs::postings_writer {
 
  public:
   static constexpr int32_t TERMS_FORMAT_MIN = 0;
-  static constexpr int32_t TERMS_FORMAT_MAX = TERMS_FORMAT_MIN;
+  // postings of terms with a few documents are stored in a term dictionary
+  static constexpr int32_t TERMS_FORMAT_PULSED = TERMS_FORMAT_MIN + 1;
+  static constexpr int32_t TERMS_FORMAT_MAX = TERMS_FORMAT_PULSED;
 
   static constexpr int32_t FORMAT_MIN = 0;
   // positions are stored one based (if first osition is 1 first offset is 0)
@@ -250,7 +297,20 @@ class postings_writer_base : public irs::postings_writer {
   static constexpr int32_t FORMAT_POSITIONS_ZEROBASED = FORMAT_SSE_POSITIONS_ONEBASED + 1;
   // positions are stored zero based, sse used
   static constexpr int32_t FORMAT_SSE_POSITIONS_ZEROBASED = FORMAT_POSITIONS_ZEROBASED + 1;
-  static constexpr int32_t FORMAT_MAX = FORMAT_SSE_POSITIONS_ZEROBASED;
+
+  // skip data contains max document frequency of each skip interval
+  static constexpr int32_t FORMAT_BLOCK_MAX_FREQ = FORMAT_SSE_POSITIONS_ZEROBASED + 1;
+  // skip data contains max document frequency of each skip interval, sse used
+  static constexpr int32_t FORMAT_SSE_BLOCK_MAX_FREQ = FORMAT_BLOCK_MAX_FREQ + 1;
+  // blocks with outliers are stored patched (PFOR)
+  static constexpr int32_t FORMAT_PFOR = FORMAT_SSE_BLOCK_MAX_FREQ + 1;
+  // blocks with outliers are stored patched (PFOR), sse used
+  static constexpr int32_t FORMAT_SSE_PFOR = FORMAT_PFOR + 1;
+  // dense blocks of documents are stored as bitmaps
+  static constexpr int32_t FORMAT_DENSE = FORMAT_SSE_PFOR + 1;
+  // dense blocks of documents are stored as bitmaps, sse used
+  static constexpr int32_t FORMAT_SSE_DENSE = FORMAT_DENSE + 1;
+  static constexpr int32_t FORMAT_MAX = FORMAT_SSE_DENSE;
 
   static constexpr uint32_t MAX_SKIP_LEVELS = 10;
   static constexpr uint32_t BLOCK_SIZE = 128;
@@ -270,7 +330,8 @@ class postings_writer_base : public irs::postings_writer {
       postings_format_version_(postings_format_version),
       terms_format_version_(terms_format_version),
       pos_min_(postings_format_version_ >= FORMAT_POSITIONS_ZEROBASED ?   // first position offsets now is format dependent
-               pos_limits::invalid(): pos_limits::min()) {
+               pos_limits::invalid(): pos_limits::min()),
+      block_max_freq_(postings_format_version_ >= FORMAT_BLOCK_MAX_FREQ) {
     assert(postings_format_version >= FORMAT_MIN && postings_format_version <= FORMAT_MAX);
     assert(terms_format_version >= TERMS_FORMAT_MIN && terms_format_version <= TERMS_FORMAT_MAX);
   }
@@ -343,6 +404,7 @@ class postings_writer_base : public irs::postings_writer {
     doc_id_t docs[BLOCK_SIZE]{}; // document deltas
     uint32_t freqs[BLOCK_SIZE]{};
     doc_id_t skip_doc[MAX_SKIP_LEVELS]{};
+    uint32_t skip_freq[MAX_SKIP_LEVELS]{}; // max frequency within a skip interval
     doc_id_t* doc{ docs };
     uint32_t* freq{ freqs };
     doc_id_t last{ doc_limits::invalid() }; // last buffered document id
@@ -434,6 +496,7 @@ class postings_writer_base : public irs::postings_writer {
   const int32_t postings_format_version_;
   const int32_t terms_format_version_;
   uint32_t pos_min_; // initial base value for writing positions offsets
+  const bool block_max_freq_; // store max frequency in skip data
 };
 
 void postings_writer_base::prepare(index_output& out, const irs::flush_state& state) {
@@ -492,7 +555,10 @@ void postings_writer_base::encode(
     out.write_vint(meta.freq - meta.docs_count);
   }
 
-  out.write_vlong(meta.doc_start - last_state_.doc_start);
+  // pulsed postings don't refer to a postings file
+  if (!meta.pulsed) {
+    out.write_vlong(meta.doc_start - last_state_.doc_start);
+  }
   if (features_.position()) {
     out.write_vlong(meta.pos_start - last_state_.pos_start);
     if (type_limits<type_t::address_t>::valid(meta.pos_end)) {
@@ -507,7 +573,28 @@ void postings_writer_base::encode(
     out.write_vlong(meta.e_skip_start);
   }
 
-  last_state_ = meta;
+  if (meta.pulsed) {
+    assert(meta.docs_count <= version10::term_meta::MAX_PULSED_DOCS);
+    for (uint32_t i = 0; i < meta.docs_count; ++i) {
+      const doc_id_t delta = meta.pulsed_docs[i];
+
+      if (!features_.freq()) {
+        out.write_vint(delta);
+      } else if (const uint32_t freq = meta.pulsed_freqs[i]; 1 == freq) {
+        out.write_vint(shift_pack_32(delta, true));
+      } else {
+        out.write_vint(shift_pack_32(delta, false));
+        out.write_vint(freq);
+      }
+    }
+
+    // keep decoding of the subsequent document pointers relative
+    const auto doc_start = last_state_.doc_start;
+    last_state_ = meta;
+    last_state_.doc_start = doc_start;
+  } else {
+    last_state_ = meta;
+  }
 }
 
 void postings_writer_base::end() {
@@ -535,6 +622,22 @@ void postings_writer_base::write_skip(size_t level, index_output& out) {
   doc_.skip_doc[level] = doc_.block_last;
   doc_.skip_ptr[level] = doc_ptr;
 
+  if (block_max_freq_ && features_.freq()) {
+    if (0 == level) {
+      // skip data is written right after the block is flushed,
+      // i.e. 'doc_.freqs' still contains frequencies of the block
+      const uint32_t block_max = *std::max_element(
+        std::begin(doc_.freqs), std::end(doc_.freqs));
+
+      for (auto& max_freq : doc_.skip_freq) {
+        max_freq = std::max(max_freq, block_max);
+      }
+    }
+
+    out.write_vint(doc_.skip_freq[level]);
+    doc_.skip_freq[level] = 0;
+  }
+
   if (features_.position()) {
     assert(pos_);
 
@@ -576,6 +679,7 @@ void postings_writer_base::begin_term() {
 
   doc_.last = doc_limits::invalid();
   doc_.block_last = doc_limits::min();
+  std::fill_n(doc_.skip_freq, MAX_SKIP_LEVELS, 0);
   skip_.reset();
 }
 
@@ -608,6 +712,17 @@ void postings_writer_base::end_term(version10::term_meta& meta, const uint32_t*
 
   if (1 == meta.docs_count) {
     meta.e_single_doc = doc_.docs[0] - doc_limits::min();
+  } else if (terms_format_version_ >= TERMS_FORMAT_PULSED &&
+             meta.docs_count <= version10::term_meta::MAX_PULSED_DOCS) {
+    // inline documents into a term dictionary
+    meta.pulsed = true;
+
+    doc_id_t prev = 0;
+    for (uint32_t i = 0; i < meta.docs_count; ++i) {
+      meta.pulsed_docs[i] = doc_.docs[i] - prev;
+      meta.pulsed_freqs[i] = features_.freq() ? doc_.freqs[i] : 0;
+      prev = doc_.docs[i];
+    }
   } else {
     // write remaining documents using
     // variable length encoding
@@ -746,9 +861,13 @@ void postings_writer_base::begin_doc(doc_id_t id, const frequency* freq) {
   doc_.push(id, freq ? freq->value : 0);
 
   if (doc_.full()) {
-    // FIXME do aligned
-    simd::delta_encode<BLOCK_SIZE, false>(doc_.docs, doc_.block_last);
-    FormatTraits::write_block(*doc_out_, doc_.docs, buf_);
+    static_assert(BLOCK_SIZE == simd::dispatch::kDeltaBlockSize);
+    simd::dispatch::delta_encode(doc_.docs, doc_.block_last);
+    if constexpr (FormatTraits::DENSE_DOCS) {
+      FormatTraits::write_doc_block(*doc_out_, doc_.docs, buf_);
+    } else {
+      FormatTraits::write_block(*doc_out_, doc_.docs, buf_);
+    }
 
     if (freq) {
       FormatTraits::write_block(*doc_out_, doc_.freqs, buf_);
@@ -812,8 +931,9 @@ void postings_writer_base::add_position(uint32_t pos, const offset* offs, const
 template<typename FormatTraits, bool VolatileAttributes>
 class postings_writer final: public postings_writer_base {
  public:
-  explicit postings_writer(int32_t version)
-    : postings_writer_base(version, TERMS_FORMAT_MAX) {
+  explicit postings_writer(int32_t version,
+                           int32_t terms_version = TERMS_FORMAT_MIN)
+    : postings_writer_base(version, terms_version) {
   }
 
   virtual irs::postings_writer::state write(irs::doc_iterator& docs) override;
@@ -914,6 +1034,7 @@ struct skip_state {
   size_t pend_pos{}; // positions to skip before new document block
   doc_id_t doc{ doc_limits::invalid() }; // last document in a previous block
   uint32_t pay_pos{}; // payload size to skip before in new document block
+  uint32_t max_freq{}; // max document frequency within a skip interval
 }; // skip_state
 
 struct skip_context : skip_state {
@@ -1556,7 +1677,9 @@ struct position<IteratorTraits, FieldTraits, false> : attribute {
 /// @class doc_iterator
 ///////////////////////////////////////////////////////////////////////////////
 template<typename IteratorTraits, typename FieldTraits>
-class doc_iterator final : public irs::doc_iterator {
+class doc_iterator final
+    : public irs::doc_iterator,
+      public memory::pooled_object<doc_iterator<IteratorTraits, FieldTraits>> {
  private:
   using attributes = std::conditional_t<
     IteratorTraits::frequency() && IteratorTraits::position(),
@@ -1594,7 +1717,14 @@ class doc_iterator final : public irs::doc_iterator {
     term_state_ = static_cast<const version10::term_meta&>(meta);
 
     // init document stream
-    if (term_state_.docs_count > 1) {
+    if (term_state_.pulsed) {
+      // documents are read along with the term dictionary
+      assert(term_state_.docs_count <= version10::term_meta::MAX_PULSED_DOCS);
+      std::copy_n(term_state_.pulsed_docs, term_state_.docs_count, docs_);
+      std::copy_n(term_state_.pulsed_freqs, term_state_.docs_count, doc_freqs_);
+      doc_freq_ = doc_freqs_;
+      end_ += term_state_.docs_count;
+    } else if (term_state_.docs_count > 1) {
       if (!doc_in_) {
         doc_in_ = doc_in->reopen(); // reopen thread-safe stream
 
@@ -1643,9 +1773,26 @@ class doc_iterator final : public irs::doc_iterator {
       doc_freq_ = doc_freqs_;
       ++end_;
     }
+
+    if constexpr (FieldTraits::block_max_freq()) {
+      if (term_state_.docs_count > postings_writer_base::BLOCK_SIZE) {
+        impact_.reset([this](doc_id_t target) { return shallow_seek(target); });
+      } else {
+        // there is no skip data, the whole postings is a single block
+        impact_.max_doc = doc_limits::eof();
+        impact_.max_freq = term_state_.freq;
+        impact_.reset([](doc_id_t) noexcept { return doc_limits::eof(); });
+      }
+    }
   }
 
   virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    if constexpr (FieldTraits::block_max_freq()) {
+      if (irs::type<impact>::id() == type) {
+        return &impact_;
+      }
+    }
+
     return irs::get_mutable(attrs_, type);
   }
 
@@ -1756,19 +1903,74 @@ class doc_iterator final : public irs::doc_iterator {
   #pragma GCC diagnostic pop
 #endif
 
+  virtual size_t next_batch(doc_id_t* docs, uint32_t* freqs, size_t count) override {
+    if constexpr (IteratorTraits::position()) {
+      // position has to be notified about every document
+      return irs::doc_iterator::next_batch(docs, freqs, count);
+    } else {
+      auto& doc = std::get<document>(attrs_);
+      size_t read = 0;
+
+      while (read < count) {
+        if (begin_ == end_) {
+          cur_pos_ += relative_pos();
+
+          if (cur_pos_ == term_state_.docs_count) {
+            doc.value = doc_limits::eof();
+            begin_ = end_ = docs_; // seal the iterator
+            break;
+          }
+
+          refill();
+        }
+
+        // copy as much as possible from the decoded block
+        const size_t size = std::min(count - read, size_t(end_ - begin_));
+        uint32_t* doc_freq = doc_freqs_ + relative_pos();
+
+        doc_id_t value = doc.value;
+        for (auto* it = docs + read, *end = it + size; it != end; ++it) {
+          *it = (value += *begin_++);
+        }
+        doc.value = value;
+
+        if constexpr (IteratorTraits::frequency()) {
+          if (freqs) {
+            std::memcpy(freqs + read, doc_freq, size*sizeof(uint32_t));
+          }
+
+          doc_freq_ = doc_freq + size;
+          std::get<frequency>(attrs_).value = doc_freq_[-1];
+        } else if (freqs) {
+          std::fill_n(freqs + read, size, 0);
+        }
+
+        read += size;
+      }
+
+      return read;
+    }
+  }
+
  private:
   void seek_to_block(doc_id_t target);
 
+  doc_id_t shallow_seek(doc_id_t target);
+
   // returns current position in the document block 'docs_'
   size_t relative_pos() noexcept {
     assert(begin_ >= docs_);
     return begin_ - docs_;
   }
 
-  doc_id_t read_skip(skip_state& state, data_input& in) {
+  static doc_id_t read_skip(skip_state& state, data_input& in) {
     state.doc = in.read_vint();
     state.doc_ptr += in.read_vlong();
 
+    if constexpr (FieldTraits::block_max_freq()) {
+      state.max_freq = in.read_vint();
+    }
+
     if constexpr (FieldTraits::position()) {
       state.pend_pos = in.read_vint();
       state.pos_ptr += in.read_vlong();
@@ -1808,10 +2010,17 @@ class doc_iterator final : public irs::doc_iterator {
 
     if (left >= postings_writer_base::BLOCK_SIZE) {
       // read doc deltas
-      IteratorTraits::read_block(
-        *doc_in_,
-        enc_buf_,
-        docs_);
+      if constexpr (IteratorTraits::DENSE_DOCS) {
+        IteratorTraits::read_doc_block(
+          *doc_in_,
+          enc_buf_,
+          docs_);
+      } else {
+        IteratorTraits::read_block(
+          *doc_in_,
+          enc_buf_,
+          docs_);
+      }
 
       if constexpr (IteratorTraits::frequency()) {
         IteratorTraits::read_block(
@@ -1852,8 +2061,63 @@ class doc_iterator final : public irs::doc_iterator {
   index_input::ptr doc_in_;
   version10::term_meta term_state_;
   attributes attrs_;
+  impact impact_;
+  std::unique_ptr<skip_reader> impact_skip_; // skip reader used by 'impact_'
+  std::vector<skip_state> impact_levels_;
 }; // doc_iterator
 
+template<typename IteratorTraits, typename FieldTraits>
+doc_id_t doc_iterator<IteratorTraits, FieldTraits>::shallow_seek(doc_id_t target) {
+  static_assert(FieldTraits::block_max_freq());
+  assert(term_state_.docs_count > postings_writer_base::BLOCK_SIZE);
+
+  if (target <= impact_.max_doc) {
+    return impact_.max_doc;
+  }
+
+  // use a dedicated skip reader to not interfere with the iterator state
+  if (!impact_skip_) {
+    auto skip_in = doc_in_->dup();
+
+    if (!skip_in) {
+      IR_FRMT_ERROR("Failed to duplicate input in: %s", __FUNCTION__);
+
+      throw io_error("Failed to duplicate document input");
+    }
+
+    skip_in->seek(term_state_.doc_start + term_state_.e_skip_start);
+
+    impact_skip_ = memory::make_unique<skip_reader>(
+      postings_writer_base::BLOCK_SIZE, postings_writer_base::SKIP_N);
+    impact_skip_->prepare(std::move(skip_in),
+      [this](size_t level, data_input& in) {
+        auto& next = impact_levels_[level];
+
+        if (in.eof()) {
+          // stream exhausted
+          return (next.doc = doc_limits::eof());
+        }
+
+        return read_skip(next, in);
+    });
+
+    impact_levels_.resize(std::max(size_t(1), impact_skip_->num_levels()));
+  }
+
+  impact_skip_->seek(target);
+
+  if (const auto& block = impact_levels_.front(); doc_limits::eof(block.doc)) {
+    // the last block isn't covered by skip data
+    impact_.max_doc = doc_limits::eof();
+    impact_.max_freq = term_state_.freq;
+  } else {
+    impact_.max_doc = block.doc;
+    impact_.max_freq = block.max_freq;
+  }
+
+  return impact_.max_doc;
+}
+
 template<typename IteratorTraits, typename FieldTraits>
 void doc_iterator<IteratorTraits, FieldTraits>::seek_to_block(doc_id_t target) {
   // check whether it make sense to use skip-list
@@ -2359,7 +2623,26 @@ class document_mask_writer final: public irs::document_mask_writer {
   static constexpr string_ref FORMAT_EXT = "doc_mask";
 
   static constexpr int32_t FORMAT_MIN = 0;
-  static constexpr int32_t FORMAT_MAX = FORMAT_MIN;
+  // masked ids are stored either as a bitmap or as sorted deltas
+  static constexpr int32_t FORMAT_BITMAP = FORMAT_MIN + 1;
+  // mask may be stacked on top of masks of previous segment versions
+  static constexpr int32_t FORMAT_DELTA = FORMAT_BITMAP + 1;
+  static constexpr int32_t FORMAT_MAX = FORMAT_DELTA;
+
+  // encodings of masked ids since 'FORMAT_BITMAP'
+  static constexpr byte_type ENCODING_DELTAS = 0;
+  static constexpr byte_type ENCODING_BITMAP = 1;
+
+  // mask file of a previous segment version a mask is stacked on
+  struct generation {
+    uint64_t version;
+    uint32_t count; // number of ids stored in a file
+  };
+
+  explicit document_mask_writer(int32_t version) noexcept
+    : version_(version) {
+    assert(version_ >= FORMAT_MIN && version_ <= FORMAT_MAX);
+  }
 
   virtual ~document_mask_writer() = default;
 
@@ -2368,6 +2651,22 @@ class document_mask_writer final: public irs::document_mask_writer {
   virtual void write(directory& dir,
                      const segment_meta& meta,
                      const document_mask& docs_mask) override;
+
+  virtual std::vector<std::string> update(
+    directory& dir,
+    const segment_meta& meta,
+    uint64_t prev_version,
+    const document_mask& docs_mask) override;
+
+ private:
+  static void write_ids(index_output& out, const document_mask& docs_mask);
+
+  void write(directory& dir,
+             const std::string& filename,
+             const document_mask& docs_mask,
+             const std::vector<generation>& generations);
+
+  int32_t version_;
 }; // document_mask_writer
 
 template<>
@@ -2383,7 +2682,16 @@ void document_mask_writer::write(
     directory& dir,
     const segment_meta& meta,
     const document_mask& docs_mask) {
-  const auto filename = file_name<irs::document_mask_writer>(meta);
+  write(dir, file_name<irs::document_mask_writer>(meta), docs_mask, {});
+}
+
+void document_mask_writer::write(
+    directory& dir,
+    const std::string& filename,
+    const document_mask& docs_mask,
+    const std::vector<generation>& generations) {
+  assert(generations.empty() || version_ >= FORMAT_DELTA);
+
   auto out = dir.create(filename);
 
   if (!out) {
@@ -2396,83 +2704,365 @@ void document_mask_writer::write(
   assert(docs_mask.size() <= std::numeric_limits<uint32_t>::max());
   const auto count = static_cast<uint32_t>(docs_mask.size());
 
-  format_utils::write_header(*out, FORMAT_NAME, FORMAT_MAX);
+  format_utils::write_header(*out, FORMAT_NAME, version_);
   out->write_vint(count);
 
-  for (auto mask : docs_mask) {
-    out->write_vint(mask);
+  if (version_ >= FORMAT_DELTA) {
+    out->write_vint(static_cast<uint32_t>(generations.size()));
+    for (auto& prev : generations) {
+      out->write_vlong(prev.version);
+      out->write_vint(prev.count);
+    }
+  }
+
+  if (version_ >= FORMAT_BITMAP) {
+    write_ids(*out, docs_mask);
+  } else {
+    for (auto mask : docs_mask) {
+      out->write_vint(mask);
+    }
   }
 
   format_utils::write_footer(*out);
 }
 
+/*static*/ void document_mask_writer::write_ids(
+    index_output& out,
+    const document_mask& docs_mask) {
+  if (docs_mask.empty()) {
+    return;
+  }
+
+  std::vector<doc_id_t> docs(docs_mask.begin(), docs_mask.end());
+  std::sort(docs.begin(), docs.end());
+
+  // choose the smaller of the encodings, a bitmap wins as soon as
+  // an average gap gets less than 64/vsize(gap) ids
+  const size_t words = size_t(docs.back()) / bits_required<uint64_t>() + 1;
+
+  size_t deltas_size = 0;
+  doc_id_t prev = 0;
+  for (const auto doc : docs) {
+    deltas_size += bytes_io<uint32_t>::vsize(doc - prev);
+    prev = doc;
+  }
+
+  if (words*sizeof(uint64_t) < deltas_size) {
+    std::vector<uint64_t> bitmap(words);
+    for (const auto doc : docs) {
+      set_bit(bitmap[doc / bits_required<uint64_t>()],
+              doc % bits_required<uint64_t>());
+    }
+
+    out.write_byte(ENCODING_BITMAP);
+    out.write_vint(static_cast<uint32_t>(words));
+    for (const auto word : bitmap) {
+      out.write_long(static_cast<int64_t>(word));
+    }
+  } else {
+    out.write_byte(ENCODING_DELTAS);
+    prev = 0;
+    for (const auto doc : docs) {
+      out.write_vint(doc - prev);
+      prev = doc;
+    }
+  }
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                             document_mask_reader
 // ----------------------------------------------------------------------------
 
 class document_mask_reader final: public irs::document_mask_reader {
  public:
+  using generation = document_mask_writer::generation;
+
   virtual ~document_mask_reader() = default;
 
   virtual bool read(
     const directory& dir,
     const segment_meta& meta,
     document_mask& docs_mask) override;
-}; // document_mask_reader
 
-bool document_mask_reader::read(
+  // reads ids stored in a mask file 'filename' into 'docs_mask' along
+  // with masks of previous segment versions it's stacked on if requested
+  // returns false if file doesn't exist
+  static bool read(
     const directory& dir,
-    const segment_meta& meta,
-    document_mask& docs_mask
-) {
-  const auto in_name = file_name<irs::document_mask_writer>(meta);
+    const std::string& filename,
+    document_mask& docs_mask,
+    std::vector<generation>* generations);
+
+  // reads masks of previous segment versions a mask file 'filename' is
+  // stacked on followed by the mask file itself, ids aren't read
+  // returns false if file doesn't exist
+  static bool read_generations(
+    const directory& dir,
+    const std::string& filename,
+    uint64_t version,
+    std::vector<generation>& generations);
 
+ private:
+  static index_input::ptr open(const directory& dir,
+                               const std::string& filename,
+                               IOAdvice advice);
+
+  static void read_generations(index_input& in,
+                               int32_t version,
+                               std::vector<generation>& generations);
+
+  static void read_ids(index_input& in, size_t count, document_mask& docs_mask);
+}; // document_mask_reader
+
+/*static*/ index_input::ptr document_mask_reader::open(
+    const directory& dir,
+    const std::string& filename,
+    IOAdvice advice) {
   bool exists;
 
-  if (!dir.exists(exists, in_name)) {
+  if (!dir.exists(exists, filename)) {
     throw io_error(string_utils::to_string(
       "failed to check existence of file, path: %s",
-      in_name.c_str()));
+      filename.c_str()));
   }
 
   if (!exists) {
     // possible that the file does not exist since document_mask is optional
-    return false;
+    return nullptr;
   }
 
-  auto in = dir.open(
-    in_name, irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::READONCE);
+  auto in = dir.open(filename, advice);
 
   if (!in) {
     throw io_error(string_utils::to_string(
       "failed to open file, path: %s",
-      in_name.c_str()));
+      filename.c_str()));
+  }
+
+  return in;
+}
+
+/*static*/ void document_mask_reader::read_generations(
+    index_input& in,
+    int32_t version,
+    std::vector<generation>& generations) {
+  if (version < document_mask_writer::FORMAT_DELTA) {
+    return;
+  }
+
+  const size_t count = in.read_vint();
+  generations.reserve(generations.size() + count + 1);
+
+  for (size_t i = 0; i < count; ++i) {
+    const auto prev_version = in.read_vlong();
+    generations.emplace_back(generation{ prev_version, in.read_vint() });
+  }
+}
+
+/*static*/ void document_mask_reader::read_ids(
+    index_input& in,
+    size_t count,
+    document_mask& docs_mask) {
+  if (!count) {
+    return;
+  }
+
+  const auto encoding = in.read_byte();
+  size_t read = 0;
+
+  if (document_mask_writer::ENCODING_BITMAP == encoding) {
+    const size_t words = in.read_vint();
+
+    for (size_t i = 0; i < words; ++i) {
+      const auto base = doc_id_t(i*bits_required<uint64_t>());
+      auto word = static_cast<uint64_t>(in.read_long());
+      read += std::popcount(word);
+
+      for (; word; word &= word - 1) {
+        docs_mask.insert(base + doc_id_t(std::countr_zero(word)));
+      }
+    }
+  } else if (document_mask_writer::ENCODING_DELTAS == encoding) {
+    doc_id_t doc = 0;
+
+    for (; read < count; ++read) {
+      doc += in.read_vint();
+      docs_mask.insert(doc);
+    }
+  } else {
+    throw index_error(string_utils::to_string(
+      "unknown document mask encoding '%d'", int(encoding)));
+  }
+
+  if (read != count) {
+    throw index_error(string_utils::to_string(
+      "invalid document mask, expected '" IR_SIZE_T_SPECIFIER "' ids, got '" IR_SIZE_T_SPECIFIER "'",
+      count, read));
+  }
+}
+
+/*static*/ bool document_mask_reader::read(
+    const directory& dir,
+    const std::string& filename,
+    document_mask& docs_mask,
+    std::vector<generation>* generations) {
+  auto in = open(dir, filename,
+                 irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::READONCE);
+
+  if (!in) {
+    return false;
   }
 
   const auto checksum = format_utils::checksum(*in);
 
-  format_utils::check_header(
+  const auto version = format_utils::check_header(
     *in,
     document_mask_writer::FORMAT_NAME,
     document_mask_writer::FORMAT_MIN,
     document_mask_writer::FORMAT_MAX);
 
   size_t count = in->read_vint();
-  docs_mask.reserve(count);
+  docs_mask.reserve(docs_mask.size() + count);
 
-  while (count--) {
-    static_assert(
-      sizeof(doc_id_t) == sizeof(decltype(in->read_vint())),
-      "sizeof(doc_id) != sizeof(decltype(id))");
+  std::vector<generation> stacked;
+  read_generations(*in, version, stacked);
 
-    docs_mask.insert(in->read_vint());
+  static_assert(
+    sizeof(doc_id_t) == sizeof(decltype(in->read_vint())),
+    "sizeof(doc_id) != sizeof(decltype(id))");
+
+  if (version >= document_mask_writer::FORMAT_BITMAP) {
+    read_ids(*in, count, docs_mask);
+  } else {
+    while (count--) {
+      docs_mask.insert(in->read_vint());
+    }
   }
 
   format_utils::check_footer(*in, checksum);
 
+  if (generations) {
+    *generations = std::move(stacked);
+  }
+
+  return true;
+}
+
+/*static*/ bool document_mask_reader::read_generations(
+    const directory& dir,
+    const std::string& filename,
+    uint64_t version,
+    std::vector<generation>& generations) {
+  auto in = open(dir, filename, irs::IOAdvice::READONCE);
+
+  if (!in) {
+    return false;
+  }
+
+  const auto format_version = format_utils::check_header(
+    *in,
+    document_mask_writer::FORMAT_NAME,
+    document_mask_writer::FORMAT_MIN,
+    document_mask_writer::FORMAT_MAX);
+
+  const uint32_t count = in->read_vint();
+  read_generations(*in, format_version, generations);
+  generations.emplace_back(generation{ version, count });
+
+  return true;
+}
+
+bool document_mask_reader::read(
+    const directory& dir,
+    const segment_meta& meta,
+    document_mask& docs_mask) {
+  std::vector<generation> generations;
+
+  if (!read(dir, file_name<irs::document_mask_writer>(meta),
+            docs_mask, &generations)) {
+    return false;
+  }
+
+  // masks stacked on are merged on read
+  for (auto& prev : generations) {
+    const auto filename = file_name(
+      meta.name, prev.version, document_mask_writer::FORMAT_EXT);
+
+    if (!read(dir, filename, docs_mask, nullptr)) {
+      throw index_error(string_utils::to_string(
+        "missing document mask file, path: %s",
+        filename.c_str()));
+    }
+  }
+
   return true;
 }
 
+std::vector<std::string> document_mask_writer::update(
+    directory& dir,
+    const segment_meta& meta,
+    uint64_t prev_version,
+    const document_mask& docs_mask) {
+  assert(prev_version < meta.version);
+
+  const auto filename = file_name<irs::document_mask_writer>(meta);
+  auto prev_filename = file_name(meta.name, prev_version, FORMAT_EXT);
+  std::vector<std::string> unused;
+
+  if (version_ < FORMAT_DELTA) {
+    // the whole mask gets rewritten
+    document_mask mask;
+
+    if (::document_mask_reader::read(dir, prev_filename, mask, nullptr)) {
+      unused.emplace_back(std::move(prev_filename));
+    }
+
+    mask.insert(docs_mask.begin(), docs_mask.end());
+    write(dir, filename, mask, {});
+
+    return unused;
+  }
+
+  std::vector<generation> generations;
+  ::document_mask_reader::read_generations(
+    dir, prev_filename, prev_version, generations);
+
+  // new mask absorbs trailing masks not larger than twice the mask
+  // accumulated so far, therefore every stacked mask is more than twice
+  // as large as the one on top of it, i.e. there are at most log(N) of
+  // them regardless of the order of updates, while writing a small mask
+  // on top of a much larger one costs proportionally to the small one only
+  auto begin = generations.end();
+  for (size_t count = docs_mask.size();
+       begin != generations.begin() && std::prev(begin)->count <= 2*count;) {
+    --begin;
+    count += begin->count;
+  }
+
+  if (begin == generations.end()) {
+    write(dir, filename, docs_mask, generations);
+    return unused;
+  }
+
+  document_mask mask = docs_mask;
+  for (auto it = begin; it != generations.end(); ++it) {
+    auto absorbed = file_name(meta.name, it->version, FORMAT_EXT);
+
+    if (!::document_mask_reader::read(dir, absorbed, mask, nullptr)) {
+      throw index_error(string_utils::to_string(
+        "missing document mask file, path: %s",
+        absorbed.c_str()));
+    }
+
+    unused.emplace_back(std::move(absorbed));
+  }
+  generations.erase(begin, generations.end());
+
+  write(dir, filename, mask, generations);
+
+  return unused;
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                  postings_reader
 // ----------------------------------------------------------------------------
@@ -2493,6 +3083,7 @@ class postings_reader_base : public irs::postings_reader {
   index_input::ptr doc_in_;
   index_input::ptr pos_in_;
   index_input::ptr pay_in_;
+  int32_t terms_version_{ postings_writer_base::TERMS_FORMAT_MIN };
 }; // postings_reader
 
 void postings_reader_base::prepare(
@@ -2551,7 +3142,7 @@ void postings_reader_base::prepare(
   }
 
   // check postings format
-  format_utils::check_header(in,
+  terms_version_ = format_utils::check_header(in,
     postings_writer_base::TERMS_FORMAT_NAME,
     postings_writer_base::TERMS_FORMAT_MIN,
     postings_writer_base::TERMS_FORMAT_MAX);
@@ -2579,7 +3170,15 @@ size_t postings_reader_base::decode(
     term_meta.freq = term_meta.docs_count + vread<uint32_t>(p);
   }
 
-  term_meta.doc_start += vread<uint64_t>(p);
+  term_meta.pulsed =
+    terms_version_ >= postings_writer_base::TERMS_FORMAT_PULSED &&
+    term_meta.docs_count > 1 &&
+    term_meta.docs_count <= version10::term_meta::MAX_PULSED_DOCS;
+
+  // pulsed postings don't refer to a postings file
+  if (!term_meta.pulsed) {
+    term_meta.doc_start += vread<uint64_t>(p);
+  }
   if (has_freq && term_meta.freq && IndexFeatures::NONE != (features & IndexFeatures::POS)) {
     term_meta.pos_start += vread<uint64_t>(p);
 
@@ -2596,13 +3195,31 @@ size_t postings_reader_base::decode(
     term_meta.e_skip_start = vread<uint64_t>(p);
   }
 
-  assert(p >= in);
-  return size_t(std::distance(in, p));
-}
+  if (term_meta.pulsed) {
+    for (uint32_t i = 0; i < term_meta.docs_count; ++i) {
+      auto& delta = term_meta.pulsed_docs[i];
+      auto& freq = term_meta.pulsed_freqs[i];
 
-template<typename FormatTraits, bool OneBasedPositionStorage>
-class postings_reader final: public postings_reader_base {
- public:
+      if (!has_freq) {
+        delta = vread<uint32_t>(p);
+        freq = 0;
+      } else if (shift_unpack_32(vread<uint32_t>(p), delta)) {
+        freq = 1;
+      } else {
+        freq = vread<uint32_t>(p);
+      }
+    }
+  }
+
+  assert(p >= in);
+  return size_t(std::distance(in, p));
+}
+
+template<typename FormatTraits,
+         bool OneBasedPositionStorage,
+         bool BlockMaxFreq = false>
+class postings_reader final: public postings_reader_base {
+ public:
   template<bool Freq, bool Pos, bool Offset, bool Payload>
   struct iterator_traits : FormatTraits {
     static constexpr bool frequency() noexcept { return Freq; }
@@ -2612,6 +3229,9 @@ class postings_reader final: public postings_reader_base {
     static constexpr bool one_based_position_storage() noexcept {
       return OneBasedPositionStorage;
     }
+    static constexpr bool block_max_freq() noexcept {
+      return Freq && BlockMaxFreq;
+    }
   };
 
   virtual irs::doc_iterator::ptr iterator(
@@ -2650,9 +3270,9 @@ class postings_reader final: public postings_reader_base {
   #pragma GCC diagnostic ignored "-Wswitch"
 #endif
 
-template<typename FormatTraits, bool OneBasedPositionStorage>
+template<typename FormatTraits, bool OneBasedPositionStorage, bool BlockMaxFreq>
 template<typename FieldTraits, typename... Args>
-irs::doc_iterator::ptr postings_reader<FormatTraits, OneBasedPositionStorage>::iterator_impl(
+irs::doc_iterator::ptr postings_reader<FormatTraits, OneBasedPositionStorage, BlockMaxFreq>::iterator_impl(
     IndexFeatures enabled, Args&&... args) {
   switch (enabled) {
     case IndexFeatures::ALL : {
@@ -2691,8 +3311,8 @@ irs::doc_iterator::ptr postings_reader<FormatTraits, OneBasedPositionStorage>::i
   return irs::doc_iterator::empty();
 }
 
-template<typename FormatTraits, bool OneBasedPositionStorage>
-irs::doc_iterator::ptr postings_reader<FormatTraits, OneBasedPositionStorage>::iterator(
+template<typename FormatTraits, bool OneBasedPositionStorage, bool BlockMaxFreq>
+irs::doc_iterator::ptr postings_reader<FormatTraits, OneBasedPositionStorage, BlockMaxFreq>::iterator(
     IndexFeatures field_features,
     IndexFeatures required_features,
     const term_meta& meta) {
@@ -2733,6 +3353,27 @@ irs::doc_iterator::ptr postings_reader<FormatTraits, OneBasedPositionStorage>::i
   #pragma GCC diagnostic pop
 #endif
 
+// ORs 64 bits of 'word' into 'set' starting at bit 'offset'
+FORCE_INLINE void or_bits(size_t* set, size_t offset, uint64_t word) noexcept {
+  constexpr auto BITS{bits_required<size_t>()};
+
+  if constexpr (BITS == bits_required<uint64_t>()) {
+    const size_t shift = offset % BITS;
+    set += offset / BITS;
+
+    *set |= word << shift;
+    // don't touch words beyond the highest set bit
+    if (shift && (word >>= (BITS - shift))) {
+      set[1] |= word;
+    }
+  } else {
+    for (; word; word &= word - 1) {
+      const size_t bit = offset + std::countr_zero(word);
+      irs::set_bit(set[bit / BITS], bit % BITS);
+    }
+  }
+}
+
 template<typename IteratorTraits, size_t N>
 void bit_union(
     index_input& doc_in, doc_id_t docs_count,
@@ -2743,7 +3384,32 @@ void bit_union(
 
   doc_id_t doc = doc_limits::min();
   while (num_blocks--) {
-    IteratorTraits::read_block(doc_in, enc_buf, docs);
+    if constexpr (IteratorTraits::DENSE_DOCS) {
+      // bitmap words are OR'ed into 'set' as is
+      size_t base = doc;
+      doc_id_t last = doc;
+      const bool dense = IteratorTraits::visit_doc_block(
+        doc_in, enc_buf, docs,
+        [&](uint64_t word) noexcept {
+          if (word) {
+            or_bits(set, base, word);
+            last = doc_id_t(base + bits_required<uint64_t>() - 1
+                            - std::countl_zero(word));
+          }
+          base += bits_required<uint64_t>();
+      });
+
+      if (dense) {
+        if constexpr (IteratorTraits::frequency()) {
+          IteratorTraits::skip_block(doc_in);
+        }
+        doc = last;
+        continue;
+      }
+    } else {
+      IteratorTraits::read_block(doc_in, enc_buf, docs);
+    }
+
     if constexpr (IteratorTraits::frequency()) {
       IteratorTraits::skip_block(doc_in);
     }
@@ -2772,8 +3438,8 @@ void bit_union(
   }
 }
 
-template<typename FormatTraits, bool OneBasedPositionStorage>
-size_t postings_reader<FormatTraits, OneBasedPositionStorage>::bit_union(
+template<typename FormatTraits, bool OneBasedPositionStorage, bool BlockMaxFreq>
+size_t postings_reader<FormatTraits, OneBasedPositionStorage, BlockMaxFreq>::bit_union(
     const IndexFeatures field_features,
     const term_provider_f& provider,
     size_t* set) {
@@ -2796,7 +3462,15 @@ size_t postings_reader<FormatTraits, OneBasedPositionStorage>::bit_union(
   while (const irs::term_meta* meta = provider()) {
     auto& term_state = static_cast<const version10::term_meta&>(*meta);
 
-    if (term_state.docs_count > 1) {
+    if (term_state.pulsed) {
+      doc_id_t doc = 0;
+      for (uint32_t i = 0; i < term_state.docs_count; ++i) {
+        doc += term_state.pulsed_docs[i];
+        irs::set_bit(set[doc / BITS], doc % BITS);
+      }
+
+      count += term_state.docs_count;
+    } else if (term_state.docs_count > 1) {
       doc_in->seek(term_state.doc_start);
       assert(!doc_in->eof());
 
@@ -2840,7 +3514,7 @@ class format10 : public irs::version10::format {
   virtual segment_meta_writer::ptr get_segment_meta_writer() const override;
   virtual segment_meta_reader::ptr get_segment_meta_reader() const override final;
 
-  virtual document_mask_writer::ptr get_document_mask_writer() const override final;
+  virtual document_mask_writer::ptr get_document_mask_writer() const override;
   virtual document_mask_reader::ptr get_document_mask_reader() const override final;
 
   virtual field_writer::ptr get_field_writer(bool consolidation) const override;
@@ -2888,7 +3562,7 @@ segment_meta_reader::ptr format10::get_segment_meta_reader() const {
 
 document_mask_writer::ptr format10::get_document_mask_writer() const {
   // can reuse stateless writer
-  static ::document_mask_writer INSTANCE;
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_MIN);
 
   return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
 }
@@ -3133,6 +3807,258 @@ columnstore_reader::ptr format14::get_columnstore_reader() const {
 
 REGISTER_FORMAT_MODULE(::format14, MODULE_NAME);
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                         format15
+// ----------------------------------------------------------------------------
+
+class format15 : public format14 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_5";
+  }
+
+  static ptr make();
+
+  format15() noexcept : format14(irs::type<format15>::get()) { }
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool consolidation) const override;
+  virtual irs::postings_reader::ptr get_postings_reader() const override;
+
+ protected:
+  explicit format15(const irs::type_info& type) noexcept
+    : format14(type) {
+  }
+};
+
+const ::format15 FORMAT15_INSTANCE;
+
+irs::postings_writer::ptr format15::get_postings_writer(bool consolidation) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_BLOCK_MAX_FREQ;
+
+  if (consolidation) {
+    return memory::make_unique<::postings_writer<format_traits, true>>(VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits, false>>(VERSION);
+}
+
+irs::postings_reader::ptr format15::get_postings_reader() const {
+  return memory::make_unique<::postings_reader<format_traits, false, true>>();
+}
+
+/*static*/ irs::format::ptr format15::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT15_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format15, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                         format16
+// ----------------------------------------------------------------------------
+
+class format16 : public format15 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_6";
+  }
+
+  static ptr make();
+
+  format16() noexcept : format15(irs::type<format16>::get()) { }
+
+  virtual document_mask_writer::ptr get_document_mask_writer() const override;
+
+ protected:
+  explicit format16(const irs::type_info& type) noexcept
+    : format15(type) {
+  }
+};
+
+const ::format16 FORMAT16_INSTANCE;
+
+document_mask_writer::ptr format16::get_document_mask_writer() const {
+  // can reuse stateless writer
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_BITMAP);
+
+  return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
+}
+
+/*static*/ irs::format::ptr format16::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT16_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format16, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                         format17
+// ----------------------------------------------------------------------------
+
+class format17 : public format16 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_7";
+  }
+
+  static ptr make();
+
+  format17() noexcept : format16(irs::type<format17>::get()) { }
+
+  virtual document_mask_writer::ptr get_document_mask_writer() const override final;
+
+ protected:
+  explicit format17(const irs::type_info& type) noexcept
+    : format16(type) {
+  }
+};
+
+const ::format17 FORMAT17_INSTANCE;
+
+document_mask_writer::ptr format17::get_document_mask_writer() const {
+  // can reuse stateless writer
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_DELTA);
+
+  return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
+}
+
+/*static*/ irs::format::ptr format17::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT17_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format17, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                         format18
+// ----------------------------------------------------------------------------
+
+class format18 : public format17 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_8";
+  }
+
+  static ptr make();
+
+  format18() noexcept : format17(irs::type<format18>::get()) { }
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool consolidation) const override;
+  virtual irs::postings_reader::ptr get_postings_reader() const override;
+
+ protected:
+  explicit format18(const irs::type_info& type) noexcept
+    : format17(type) {
+  }
+};
+
+const ::format18 FORMAT18_INSTANCE;
+
+irs::postings_writer::ptr format18::get_postings_writer(bool consolidation) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_PFOR;
+
+  if (consolidation) {
+    return memory::make_unique<::postings_writer<format_traits_pfor, true>>(VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits_pfor, false>>(VERSION);
+}
+
+irs::postings_reader::ptr format18::get_postings_reader() const {
+  return memory::make_unique<::postings_reader<format_traits_pfor, false, true>>();
+}
+
+/*static*/ irs::format::ptr format18::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT18_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format18, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                         format19
+// ----------------------------------------------------------------------------
+
+class format19 : public format18 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_9";
+  }
+
+  static ptr make();
+
+  format19() noexcept : format18(irs::type<format19>::get()) { }
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool consolidation) const override;
+  virtual irs::postings_reader::ptr get_postings_reader() const override;
+
+ protected:
+  explicit format19(const irs::type_info& type) noexcept
+    : format18(type) {
+  }
+};
+
+const ::format19 FORMAT19_INSTANCE;
+
+irs::postings_writer::ptr format19::get_postings_writer(bool consolidation) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_DENSE;
+
+  if (consolidation) {
+    return memory::make_unique<::postings_writer<format_traits_dense, true>>(VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits_dense, false>>(VERSION);
+}
+
+irs::postings_reader::ptr format19::get_postings_reader() const {
+  return memory::make_unique<::postings_reader<format_traits_dense, false, true>>();
+}
+
+/*static*/ irs::format::ptr format19::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT19_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format19, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                        format110
+// ----------------------------------------------------------------------------
+
+class format110 : public format19 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_10";
+  }
+
+  static ptr make();
+
+  format110() noexcept : format19(irs::type<format110>::get()) { }
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool consolidation) const override;
+
+ protected:
+  explicit format110(const irs::type_info& type) noexcept
+    : format19(type) {
+  }
+};
+
+const ::format110 FORMAT110_INSTANCE;
+
+irs::postings_writer::ptr format110::get_postings_writer(bool consolidation) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_DENSE;
+  constexpr const auto TERMS_VERSION = postings_writer_base::TERMS_FORMAT_PULSED;
+
+  if (consolidation) {
+    return memory::make_unique<::postings_writer<format_traits_dense, true>>(
+      VERSION, TERMS_VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits_dense, false>>(
+    VERSION, TERMS_VERSION);
+}
+
+/*static*/ irs::format::ptr format110::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT110_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format110, MODULE_NAME);
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                      format12sse
 // ----------------------------------------------------------------------------
@@ -3144,6 +4070,9 @@ struct format_traits_sse4 {
 
   static constexpr uint32_t BLOCK_SIZE = SIMDBlockSize;
 
+  // see 'format_traits'
+  static constexpr bool DENSE_DOCS = false;
+
   FORCE_INLINE static void pack_block(
       const uint32_t* RESTRICT decoded,
       uint32_t* RESTRICT encoded,
@@ -3171,6 +4100,45 @@ struct format_traits_sse4 {
   }
 }; // format_traits_sse
 
+// see 'format_traits_pfor'
+struct format_traits_sse4_pfor : format_traits_sse4 {
+  FORCE_INLINE static void write_block(
+      index_output& out, const uint32_t* in, uint32_t* buf) {
+    bitpack::write_block32_patched<BLOCK_SIZE>(&pack_block, out, in, buf);
+  }
+
+  FORCE_INLINE static void read_block(
+      index_input& in, uint32_t* buf, uint32_t* out) {
+    bitpack::read_block32_patched<BLOCK_SIZE>(&unpack_block, in, buf, out);
+  }
+
+  FORCE_INLINE static void skip_block(index_input& in) {
+    bitpack::skip_block32_patched(in, BLOCK_SIZE);
+  }
+}; // format_traits_sse4_pfor
+
+// see 'format_traits_dense'
+struct format_traits_sse4_dense : format_traits_sse4_pfor {
+  static constexpr bool DENSE_DOCS = true;
+
+  FORCE_INLINE static void write_doc_block(
+      index_output& out, const uint32_t* in, uint32_t* buf) {
+    bitpack::write_block32_dense<BLOCK_SIZE>(&pack_block, out, in, buf);
+  }
+
+  FORCE_INLINE static void read_doc_block(
+      index_input& in, uint32_t* buf, uint32_t* out) {
+    bitpack::read_block32_dense<BLOCK_SIZE>(&unpack_block, in, buf, out);
+  }
+
+  template<typename Visitor>
+  FORCE_INLINE static bool visit_doc_block(
+      index_input& in, uint32_t* buf, uint32_t* out, Visitor&& visitor) {
+    return bitpack::visit_block32_dense<BLOCK_SIZE>(
+      &unpack_block, in, buf, out, std::forward<Visitor>(visitor));
+  }
+}; // format_traits_sse4_dense
+
 class format12simd final : public format12 {
  public:
   static constexpr string_ref type_name() noexcept {
@@ -3302,6 +4270,258 @@ columnstore_reader::ptr format14simd::get_columnstore_reader() const {
 
 REGISTER_FORMAT_MODULE(::format14simd, MODULE_NAME);
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                     format15simd
+// ----------------------------------------------------------------------------
+
+class format15simd : public format14simd {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_5simd";
+  }
+
+  static ptr make();
+
+  format15simd() noexcept : format14simd(irs::type<format15simd>::get()) { }
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool consolidation) const override;
+  virtual irs::postings_reader::ptr get_postings_reader() const override;
+
+ protected:
+  explicit format15simd(const irs::type_info& type) noexcept
+    : format14simd(type) {
+  }
+};
+
+const ::format15simd FORMAT15SIMD_INSTANCE;
+
+irs::postings_writer::ptr format15simd::get_postings_writer(bool consolidation) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_SSE_BLOCK_MAX_FREQ;
+
+  if (consolidation) {
+    return memory::make_unique<::postings_writer<format_traits_sse4, true>>(VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits_sse4, false>>(VERSION);
+}
+
+irs::postings_reader::ptr format15simd::get_postings_reader() const {
+  return memory::make_unique<::postings_reader<format_traits_sse4, false, true>>();
+}
+
+/*static*/ irs::format::ptr format15simd::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT15SIMD_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format15simd, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                     format16simd
+// ----------------------------------------------------------------------------
+
+class format16simd : public format15simd {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_6simd";
+  }
+
+  static ptr make();
+
+  format16simd() noexcept : format15simd(irs::type<format16simd>::get()) { }
+
+  virtual document_mask_writer::ptr get_document_mask_writer() const override;
+
+ protected:
+  explicit format16simd(const irs::type_info& type) noexcept
+    : format15simd(type) {
+  }
+};
+
+const ::format16simd FORMAT16SIMD_INSTANCE;
+
+document_mask_writer::ptr format16simd::get_document_mask_writer() const {
+  // can reuse stateless writer
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_BITMAP);
+
+  return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
+}
+
+/*static*/ irs::format::ptr format16simd::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT16SIMD_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format16simd, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                     format17simd
+// ----------------------------------------------------------------------------
+
+class format17simd : public format16simd {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_7simd";
+  }
+
+  static ptr make();
+
+  format17simd() noexcept : format16simd(irs::type<format17simd>::get()) { }
+
+  virtual document_mask_writer::ptr get_document_mask_writer() const override final;
+
+ protected:
+  explicit format17simd(const irs::type_info& type) noexcept
+    : format16simd(type) {
+  }
+};
+
+const ::format17simd FORMAT17SIMD_INSTANCE;
+
+document_mask_writer::ptr format17simd::get_document_mask_writer() const {
+  // can reuse stateless writer
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_DELTA);
+
+  return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
+}
+
+/*static*/ irs::format::ptr format17simd::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT17SIMD_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format17simd, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                     format18simd
+// ----------------------------------------------------------------------------
+
+class format18simd : public format17simd {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_8simd";
+  }
+
+  static ptr make();
+
+  format18simd() noexcept : format17simd(irs::type<format18simd>::get()) { }
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool consolidation) const override;
+  virtual irs::postings_reader::ptr get_postings_reader() const override;
+
+ protected:
+  explicit format18simd(const irs::type_info& type) noexcept
+    : format17simd(type) {
+  }
+};
+
+const ::format18simd FORMAT18SIMD_INSTANCE;
+
+irs::postings_writer::ptr format18simd::get_postings_writer(bool consolidation) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_SSE_PFOR;
+
+  if (consolidation) {
+    return memory::make_unique<::postings_writer<format_traits_sse4_pfor, true>>(VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits_sse4_pfor, false>>(VERSION);
+}
+
+irs::postings_reader::ptr format18simd::get_postings_reader() const {
+  return memory::make_unique<::postings_reader<format_traits_sse4_pfor, false, true>>();
+}
+
+/*static*/ irs::format::ptr format18simd::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT18SIMD_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format18simd, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                     format19simd
+// ----------------------------------------------------------------------------
+
+class format19simd : public format18simd {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_9simd";
+  }
+
+  static ptr make();
+
+  format19simd() noexcept : format18simd(irs::type<format19simd>::get()) { }
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool consolidation) const override;
+  virtual irs::postings_reader::ptr get_postings_reader() const override;
+
+ protected:
+  explicit format19simd(const irs::type_info& type) noexcept
+    : format18simd(type) {
+  }
+};
+
+const ::format19simd FORMAT19SIMD_INSTANCE;
+
+irs::postings_writer::ptr format19simd::get_postings_writer(bool consolidation) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_SSE_DENSE;
+
+  if (consolidation) {
+    return memory::make_unique<::postings_writer<format_traits_sse4_dense, true>>(VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits_sse4_dense, false>>(VERSION);
+}
+
+irs::postings_reader::ptr format19simd::get_postings_reader() const {
+  return memory::make_unique<::postings_reader<format_traits_sse4_dense, false, true>>();
+}
+
+/*static*/ irs::format::ptr format19simd::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT19SIMD_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format19simd, MODULE_NAME);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                    format110simd
+// ----------------------------------------------------------------------------
+
+class format110simd : public format19simd {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_10simd";
+  }
+
+  static ptr make();
+
+  format110simd() noexcept : format19simd(irs::type<format110simd>::get()) { }
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool consolidation) const override;
+
+ protected:
+  explicit format110simd(const irs::type_info& type) noexcept
+    : format19simd(type) {
+  }
+};
+
+const ::format110simd FORMAT110SIMD_INSTANCE;
+
+irs::postings_writer::ptr format110simd::get_postings_writer(bool consolidation) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_SSE_DENSE;
+  constexpr const auto TERMS_VERSION = postings_writer_base::TERMS_FORMAT_PULSED;
+
+  if (consolidation) {
+    return memory::make_unique<::postings_writer<format_traits_sse4_dense, true>>(
+      VERSION, TERMS_VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits_sse4_dense, false>>(
+    VERSION, TERMS_VERSION);
+}
+
+/*static*/ irs::format::ptr format110simd::make() {
+  return irs::format::ptr(irs::format::ptr(), &FORMAT110SIMD_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format110simd, MODULE_NAME);
+
 #endif // IRESEARCH_SSE2
 
 }
@@ -3316,10 +4536,22 @@ void init() {
   REGISTER_FORMAT(::format12);
   REGISTER_FORMAT(::format13);
   REGISTER_FORMAT(::format14);
+  REGISTER_FORMAT(::format15);
+  REGISTER_FORMAT(::format16);
+  REGISTER_FORMAT(::format17);
+  REGISTER_FORMAT(::format18);
+  REGISTER_FORMAT(::format19);
+  REGISTER_FORMAT(::format110);
 #ifdef IRESEARCH_SSE2
   REGISTER_FORMAT(::format12simd);
   REGISTER_FORMAT(::format13simd);
   REGISTER_FORMAT(::format14simd);
+  REGISTER_FORMAT(::format15simd);
+  REGISTER_FORMAT(::format16simd);
+  REGISTER_FORMAT(::format17simd);
+  REGISTER_FORMAT(::format18simd);
+  REGISTER_FORMAT(::format19simd);
+  REGISTER_FORMAT(::format110simd);
 #endif // IRESEARCH_SSE2
 #endif // IRESEARCH_DLL
 }
@@ -45,12 +45,16 @@ struct documents final : attribute {
 }; // documents
 
 struct term_meta : irs::term_meta {
+  // max number of documents of a term to inline into a term dictionary
+  static constexpr uint32_t MAX_PULSED_DOCS = 4;
+
   term_meta() noexcept : e_skip_start(0) {} // GCC 4.9 does not initialize unions properly
 
   void clear() noexcept {
     irs::term_meta::clear();
     doc_start = pos_start = pay_start = 0;
     pos_end = type_limits<type_t::address_t>::invalid();
+    pulsed = false;
   }
 
   uint64_t doc_start = 0; // where this term's postings start in the .doc file
@@ -61,6 +65,11 @@ struct term_meta : irs::term_meta {
     doc_id_t e_single_doc; // singleton document id delta
     uint64_t e_skip_start; // pointer where skip data starts (after doc_start)
   };
+  // documents of a pulsed term, i.e. stored in a term dictionary
+  // rather than in a postings file, the first one is absolute
+  doc_id_t pulsed_docs[MAX_PULSED_DOCS]{}; // document id deltas
+  uint32_t pulsed_freqs[MAX_PULSED_DOCS]{}; // document frequencies
+  bool pulsed = false; // postings are inlined into a term dictionary
 }; // term_meta
 
 } // version10
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "column_values_reader.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "analysis/token_attributes.hpp"
+#include "formats/formats.hpp"
+#include "index/index_reader.hpp"
+
+namespace iresearch {
+
+/*static*/ size_t column_values_reader::read(
+    column_state& state,
+    const column_reader& column,
+    std::span<const doc_id_t> docs,
+    bytes_ref* values) {
+  assert(state.it);
+  assert(std::is_sorted(docs.begin(), docs.end()));
+
+  if (state.batch) {
+    return (*state.batch)(docs.data(), values, docs.size());
+  }
+
+  // the iterator doesn't support batch reads, values are read one by one
+  if (!docs.empty() && docs.front() < state.it->value()) {
+    // can't seek backwards
+    state.it = column.iterator(false);
+    state.value = irs::get<payload>(*state.it);
+  }
+
+  auto& it = *state.it;
+  state.values.clear();
+  size_t found = 0;
+
+  for (size_t i = 0; i < docs.size(); ++i) {
+    const doc_id_t doc = docs[i];
+
+    if (it.value() > doc || it.seek(doc) != doc) {
+      values[i] = bytes_ref::NIL;
+      continue;
+    }
+
+    // a value is valid until the next 'seek(...)'
+    state.values.push(
+      values, i, state.value ? state.value->value : bytes_ref::NIL);
+    ++found;
+  }
+
+  state.values.flush(values);
+
+  return found;
+}
+
+size_t column_values_reader::read(
+    const sub_reader& segment,
+    std::span<const doc_id_t> docs,
+    bytes_ref* values) {
+  const auto* column = segment.column(field_);
+
+  if (!column) {
+    std::fill_n(values, docs.size(), bytes_ref::NIL);
+    return 0;
+  }
+
+  auto& state = columns_[column];
+
+  if (!state.it) {
+    state.it = column->iterator(false);
+    state.batch = irs::get<column_batch>(*state.it);
+    state.value = irs::get<payload>(*state.it);
+  }
+
+  return read(state, *column, docs, values);
+}
+
+size_t column_values_reader::read(
+    const index_reader& index,
+    bytes_ref* values) {
+  // visit documents segment by segment in ascending order
+  order_.resize(refs_.size());
+  std::iota(order_.begin(), order_.end(), size_t{0});
+  std::sort(
+    order_.begin(), order_.end(),
+    [this](size_t lhs, size_t rhs) noexcept {
+      const auto& lhs_ref = refs_[lhs];
+      const auto& rhs_ref = refs_[rhs];
+
+      return lhs_ref.segment == rhs_ref.segment
+        ? lhs_ref.doc < rhs_ref.doc
+        : lhs_ref.segment < rhs_ref.segment;
+  });
+
+  size_t found = 0;
+
+  for (auto begin = order_.begin(), end = order_.end(); begin != end;) {
+    const size_t segment = refs_[*begin].segment;
+    assert(segment < index.size());
+
+    docs_.clear();
+    auto it = begin;
+    for (; it != end && refs_[*it].segment == segment; ++it) {
+      docs_.emplace_back(refs_[*it].doc);
+    }
+
+    values_.resize(docs_.size());
+    found += read(index[segment], docs_, values_.data());
+
+    for (auto value = values_.begin(); begin != it; ++begin, ++value) {
+      values[*begin] = *value;
+    }
+  }
+
+  return found;
+}
+
+void column_values_reader::clear() noexcept {
+  columns_.clear();
+}
+
+} // ROOT
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_COLUMN_VALUES_READER_H
+#define IRESEARCH_COLUMN_VALUES_READER_H
+
+#include <span>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "formats/formats.hpp"
+#include "index/iterators.hpp"
+#include "utils/noncopyable.hpp"
+#include "utils/string.hpp"
+
+namespace iresearch {
+
+struct index_reader;
+struct payload;
+struct sub_reader;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class column_values_reader
+/// @brief reads values of a column for lists of documents at once, e.g. to
+///        materialize top-k results
+/// @note a column iterator is created once per segment and reused across
+///       calls, values are read via its 'column_batch' attribute if available,
+///       i.e. in a single pass over the column
+/// @note the reader must not outlive the segments it was used with
+////////////////////////////////////////////////////////////////////////////////
+class column_values_reader : private util::noncopyable {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a document of an index
+  //////////////////////////////////////////////////////////////////////////////
+  struct doc_ref {
+    size_t segment; // ordinal of a segment in a reader
+    doc_id_t doc; // document id within a segment
+  }; // doc_ref
+
+  explicit column_values_reader(string_ref field)
+    : field_(field) {
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief reads values of documents 'docs' of the specified 'segment'
+  /// @param docs documents sorted in ascending order
+  /// @param values values of 'docs', 'bytes_ref::NIL' denotes a missing value
+  /// @returns number of documents having a value
+  /// @note values are valid until the next call for the same segment
+  //////////////////////////////////////////////////////////////////////////////
+  size_t read(
+    const sub_reader& segment,
+    std::span<const doc_id_t> docs,
+    bytes_ref* values);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief reads values of documents of the specified 'index', e.g. entries
+  ///        of a top-k collector, in any order, every segment is visited once
+  /// @param entries documents denoted by 'segment' ordinals and 'doc' ids
+  /// @param values values of 'entries', 'bytes_ref::NIL' denotes a missing
+  ///        value
+  /// @returns number of documents having a value
+  /// @note values are valid until the next call
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename Entry>
+  requires requires(const Entry& entry) { entry.segment; entry.doc; }
+  size_t read(
+      const index_reader& index,
+      const std::vector<Entry>& entries,
+      bytes_ref* values) {
+    refs_.clear();
+    refs_.reserve(entries.size());
+    for (auto& entry : entries) {
+      refs_.emplace_back(doc_ref{entry.segment, entry.doc});
+    }
+
+    return read(index, values);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief releases cached column iterators
+  //////////////////////////////////////////////////////////////////////////////
+  void clear() noexcept;
+
+  const std::string& field() const noexcept { return field_; }
+
+ private:
+  struct column_state {
+    doc_iterator::ptr it;
+    const column_batch* batch{};
+    const payload* value{};
+    value_batch<false> values; // read via 'payload' if 'batch' isn't available
+  }; // column_state
+
+  size_t read(const index_reader& index, bytes_ref* values);
+
+  static size_t read(
+    column_state& state,
+    const column_reader& column,
+    std::span<const doc_id_t> docs,
+    bytes_ref* values);
+
+  std::string field_;
+  absl::flat_hash_map<const column_reader*, column_state> columns_;
+  std::vector<doc_ref> refs_;
+  std::vector<size_t> order_;
+  std::vector<doc_id_t> docs_;
+  std::vector<bytes_ref> values_;
+}; // column_values_reader
+
+} // ROOT
+
+#endif // IRESEARCH_COLUMN_VALUES_READER_H
@@ -31,6 +31,7 @@
 #include "formats/formats.hpp"
 #include "store/directory.hpp"
 #include "store/directory_attributes.hpp"
+#include "utils/bitset.hpp"
 #include "utils/iterator.hpp"
 #include "utils/memory.hpp"
 #include "utils/string.hpp"
@@ -138,6 +139,12 @@ struct sub_reader : index_reader {
     return std::move(it);
   }
 
+  // Returns bitmap of live documents in current segment indexed by
+  // document id, nullptr if all documents are live.
+  virtual const bitset* live_docs() const noexcept {
+    return nullptr;
+  }
+
   // Inverted index
 
   virtual field_iterator::ptr fields() const = 0;
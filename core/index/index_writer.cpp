@@ -103,7 +103,8 @@ std::vector<index_file_refs::ref_t> extract_refs(
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief apply any document removals based on filters in the segment
 /// @param modifications where to get document update_contexts from
-/// @param docs_mask where to apply document removals to
+/// @param docs_mask where to apply document removals to, documents already
+///        masked in 'meta' are not added
 /// @param readers readers by segment name
 /// @param meta key used to get reader for the segment to evaluate
 /// @param min_modification_generation smallest consider modification generation
@@ -128,6 +129,7 @@ bool add_document_mask_modified_records(
     ));
   }
 
+  const auto* live_docs = reader->live_docs(); // documents masked in 'meta'
   bool modified = false;
 
   for (auto& modification : modifications) {
@@ -153,6 +155,7 @@ bool add_document_mask_modified_records(
       // if the indexed doc_id was insert()ed after the request for modification
       // or the indexed doc_id was already masked then it should be skipped
       if (modification.generation < min_modification_generation
+          || (live_docs && !live_docs->test(doc_id))
           || !docs_mask.insert(doc_id).second) {
         continue; // the current modification query does not match any records
       }
@@ -300,6 +303,19 @@ void append_segments_refs(
   directory_utils::reference(dir, meta, visitor, true);
 }
 
+void increment_version(segment_meta& meta) noexcept {
+  ++meta.version; // segment modified due to new document_mask
+
+  // a second time +1 to avoid overlap with version increment due to commit of
+  // uncommited segment tail which must mask committed segment head
+  // NOTE0: +1 extra is enough since a segment can reside in at most 2
+  //        flush_contexts, there fore no more than 1 tail
+  // NOTE1: flush_all() Stage3 increments version by _only_ 1 to avoid overlap
+  //        with here, i.e. segment tail version will always be odd due to the
+  //        aforementioned and because there is at most 1 tail
+  ++meta.version;
+}
+
 std::string_view write_document_mask(
     directory& dir,
     segment_meta& meta,
@@ -311,16 +327,7 @@ std::string_view write_document_mask(
 
   if (increment_version) {
     meta.files.erase(mask_writer->filename(meta)); // current filename
-    ++meta.version; // segment modified due to new document_mask
-
-    // a second time +1 to avoid overlap with version increment due to commit of
-    // uncommited segment tail which must mask committed segment head
-    // NOTE0: +1 extra is enough since a segment can reside in at most 2
-    //        flush_contexts, there fore no more than 1 tail
-    // NOTE1: flush_all() Stage3 increments version by _only_ 1 to avoid overlap
-    //        with here, i.e. segment tail version will always be odd due to the
-    //        aforementioned and because there is at most 1 tail
-    ++meta.version;
+    ::increment_version(meta);
   }
 
   const auto [file, _] = meta.files.emplace(mask_writer->filename(meta)); // new/expected filename
@@ -331,6 +338,33 @@ std::string_view write_document_mask(
   return *file;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes documents 'docs_mask' removed from a committed segment on top
+///        of its current mask, i.e. without reading and rewriting the latter
+///        (as long as the segment format supports it)
+/// @return name of the written file
+////////////////////////////////////////////////////////////////////////////////
+std::string_view update_document_mask(
+    directory& dir,
+    segment_meta& meta,
+    const document_mask& docs_mask) {
+  assert(docs_mask.size() <= std::numeric_limits<uint32_t>::max());
+
+  auto mask_writer = meta.codec->get_document_mask_writer();
+
+  const auto prev_version = meta.version;
+  ::increment_version(meta);
+
+  for (auto& unused : mask_writer->update(dir, meta, prev_version, docs_mask)) {
+    meta.files.erase(unused);
+  }
+
+  const auto [file, _] = meta.files.emplace(mask_writer->filename(meta)); // new filename
+  meta.size = 0; // reset no longer valid size, to be recomputed on index_utils::write_index_segment(...)
+
+  return *file;
+}
+
 // mapping: name -> { new segment, old segment }
 using candidates_mapping_t = absl::flat_hash_map<
   string_ref,
@@ -2019,8 +2053,7 @@ index_writer::pending_context_t index_writer::flush_all() {
     auto mask_modified = false;
     auto& segment = segments.back();
 
-    docs_mask.clear();
-    index_utils::read_document_mask(docs_mask, dir, segment.meta);
+    docs_mask.clear(); // documents removed since the last commit
 
     // mask documents matching filters from segment_contexts (i.e. from new operations)
     for (auto& modifications : ctx->pending_segment_contexts_) {
@@ -2053,8 +2086,8 @@ index_writer::pending_context_t index_writer::flush_all() {
         continue;
       }
 
-      segment_mask.emplace(existing_segment.meta); // mask segment since write_document_mask(...) will increment version
-      to_sync.register_partial_sync(segment_id, write_document_mask(dir, segment.meta, docs_mask));
+      segment_mask.emplace(existing_segment.meta); // mask segment since update_document_mask(...) will increment version
+      to_sync.register_partial_sync(segment_id, update_document_mask(dir, segment.meta, docs_mask));
       segment.meta.size = 0; // reset for new write
       index_utils::flush_index_segment(dir, segment); // write with new mask
     }
@@ -2132,10 +2165,8 @@ index_writer::pending_context_t index_writer::flush_all() {
       // pending consolidation request
       pending_candidates_count += candidates.size();
     } else {
-      // during consolidation doc_mask could be already populated even for just merged segment
-      if (pending_segment.segment.meta.docs_count != pending_segment.segment.meta.live_docs_count) {
-        index_utils::read_document_mask(docs_mask, dir, pending_segment.segment.meta);
-      }
+      // during consolidation doc_mask could be already populated even for
+      // just merged segment, only documents removed on top of it are tracked
       bool docs_mask_modified = false;
       // pending already imported/consolidated segment, apply deletes
       // mask documents matching filters from segment_contexts (i.e. from new operations)
@@ -2180,8 +2211,10 @@ index_writer::pending_context_t index_writer::flush_all() {
         // this segment is already in the mask (see assert below)
         // new version will be created. Remove old version from cache!
         ctx->segment_mask_.emplace(pending_segment.segment.meta);
+        update_document_mask(dir, pending_segment.segment.meta, docs_mask);
+      } else {
+        write_document_mask(dir, pending_segment.segment.meta, docs_mask, false);
       }
-      write_document_mask(dir, pending_segment.segment.meta, docs_mask, !pending_consolidation);
       pending_consolidation = true; // force write new segment meta
     }
 
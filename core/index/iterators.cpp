@@ -209,6 +209,25 @@ doc_iterator::ptr doc_iterator::empty() {
   return memory::to_managed<doc_iterator, false>(&EMPTY_DOC_ITERATOR);
 }
 
+size_t doc_iterator::next_batch(
+    doc_id_t* docs,
+    uint32_t* freqs,
+    size_t count) {
+  assert(docs);
+  const auto* freq = freqs ? irs::get<frequency>(*this) : nullptr;
+  size_t read = 0;
+
+  for (; read < count && next(); ++read) {
+    docs[read] = value();
+
+    if (freqs) {
+      freqs[read] = freq ? freq->value : 0;
+    }
+  }
+
+  return read;
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                   field_iterator 
 // ----------------------------------------------------------------------------
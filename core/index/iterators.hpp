@@ -65,6 +65,18 @@ struct doc_iterator
   /// (for more information see class description)
   //////////////////////////////////////////////////////////////////////////////
   virtual doc_id_t seek(doc_id_t target) = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief reads at most 'count' next documents into 'docs' and, unless
+  ///        'freqs' is nullptr, their in-document frequencies into 'freqs'
+  ///        (0 if an iterator doesn't track frequencies)
+  /// @returns number of read documents, which is less than 'count' only if
+  ///          the iterator got exhausted
+  /// @note the iterator is positioned at the last read document, i.e. its
+  ///       attributes (e.g. score) reflect the state of that document
+  /// @note default implementation falls back to 'next()'
+  //////////////////////////////////////////////////////////////////////////////
+  virtual size_t next_batch(doc_id_t* docs, uint32_t* freqs, size_t count);
 }; // doc_iterator
 
 //////////////////////////////////////////////////////////////////////////////
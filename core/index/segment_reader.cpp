@@ -31,6 +31,8 @@
 #include "index/index_meta.hpp"
 
 #include "formats/format_utils.hpp"
+#include "search/bitset_doc_iterator.hpp"
+#include "utils/bitset.hpp"
 #include "utils/hash_set_utils.hpp"
 #include "utils/index_utils.hpp"
 #include "utils/singleton.hpp"
@@ -81,13 +83,13 @@ class mask_doc_iterator final : public doc_iterator {
  public:
   explicit mask_doc_iterator(
       doc_iterator::ptr&& it,
-      const document_mask& mask) noexcept
-    : mask_(mask), it_(std::move(it))  {
+      const bitset& live_docs) noexcept
+    : live_docs_(live_docs), it_(std::move(it))  {
   }
 
   virtual bool next() override {
     while (it_->next()) {
-      if (!mask_.contains(value())) {
+      if (live(value())) {
         return true;
       }
     }
@@ -98,7 +100,7 @@ class mask_doc_iterator final : public doc_iterator {
   virtual doc_id_t seek(doc_id_t target) override {
     const auto doc = it_->seek(target);
 
-    if (!mask_.contains(doc)) {
+    if (live(doc)) {
       return doc;
     }
 
@@ -115,59 +117,65 @@ class mask_doc_iterator final : public doc_iterator {
     return it_->get_mutable(type);
   }
 
- private:
-  const document_mask& mask_; // excluded document ids
-  doc_iterator::ptr it_;
-}; // mask_doc_iterator
+  virtual size_t next_batch(doc_id_t* docs, uint32_t* freqs,
+                            size_t count) override {
+    size_t size = 0;
 
-class masked_docs_iterator 
-    : public doc_iterator,
-      private util::noncopyable {
- public:
-  masked_docs_iterator(
-    doc_id_t begin,
-    doc_id_t end,
-    const document_mask& docs_mask)
-  : docs_mask_(docs_mask),
-    end_(end),
-    next_(begin) {
-  }
+    while (size < count) {
+      const size_t requested = count - size;
+      const size_t read = it_->next_batch(
+        docs + size, freqs ? freqs + size : nullptr, requested);
 
-  virtual bool next() override {
-    while (next_ < end_) {
-      current_.value = next_++;
+      size += filter(docs + size, freqs ? freqs + size : nullptr, read);
 
-      if (!docs_mask_.contains(current_.value)) {
-        return true;
+      if (read < requested) {
+        break;
       }
     }
 
-    current_.value = doc_limits::eof();
-
-    return false;
+    return size;
   }
 
-  virtual doc_id_t seek(doc_id_t target) override {
-    next_ = target;
-    next();
+ private:
+  // compacts 'count' documents (and frequencies, if any) to the live ones,
+  // a word of 'live_docs_' is loaded once for all documents it covers
+  size_t filter(doc_id_t* docs, uint32_t* freqs, size_t count) const noexcept {
+    constexpr size_t kBits = bits_required<bitset::word_t>();
+    const auto* words = live_docs_.begin();
+    const size_t num_words = live_docs_.words();
+    size_t size = 0;
+
+    for (size_t i = 0; i < count;) {
+      const size_t word_idx = docs[i] / kBits;
+      const bitset::word_t word = word_idx < num_words
+        ? words[word_idx]
+        : ~bitset::word_t(0); // beyond the mask, i.e. live
+
+      // documents are ascending, process all of them within the word
+      for (; i < count && docs[i] / kBits == word_idx; ++i) {
+        if (check_bit(word, docs[i] % kBits)) {
+          docs[size] = docs[i];
+          if (freqs) {
+            freqs[size] = freqs[i];
+          }
+          ++size;
+        }
+      }
+    }
 
-    return value();
+    return size;
   }
 
-  virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
-    return irs::type<document>::id() == type ? &current_ : nullptr;
+  bool live(doc_id_t doc) const noexcept {
+    // 'doc_limits::invalid()' and 'doc_limits::eof()' aren't masked
+    return doc >= live_docs_.size()
+      || !doc_limits::valid(doc)
+      || live_docs_.test(doc);
   }
 
-  virtual doc_id_t value() const override {
-    return current_.value;
-  }
-
- private:
-  document current_;
-  const document_mask& docs_mask_;
-  const doc_id_t end_; // past last valid doc_id
-  doc_id_t next_;
-};
+  const bitset& live_docs_;
+  doc_iterator::ptr it_;
+}; // mask_doc_iterator
 
 } // namespace {
 
@@ -202,11 +210,15 @@ class segment_reader_impl : public sub_reader {
       return nullptr;
     }
 
-    if (docs_mask_.empty()) {
+    if (!live_docs_.words()) {
       return std::move(it);
     }
 
-    return memory::make_managed<mask_doc_iterator>(std::move(it), docs_mask_);
+    return memory::make_managed<mask_doc_iterator>(std::move(it), live_docs_);
+  }
+
+  virtual const bitset* live_docs() const noexcept override {
+    return live_docs_.words() ? &live_docs_ : nullptr;
   }
 
   virtual const term_reader* field(string_ref name) const override {
@@ -218,7 +230,7 @@ class segment_reader_impl : public sub_reader {
   }
 
   virtual uint64_t live_docs_count() const noexcept override {
-    return docs_count_ - docs_mask_.size();
+    return live_docs_count_;
   }
 
   uint64_t meta_version() const noexcept {
@@ -252,7 +264,8 @@ class segment_reader_impl : public sub_reader {
   const irs::column_reader* sort_{};
   const directory& dir_;
   uint64_t docs_count_;
-  document_mask docs_mask_;
+  uint64_t live_docs_count_;
+  bitset live_docs_; // empty if all documents are live
   field_reader::ptr field_reader_;
   uint64_t meta_version_;
   named_columns named_columns_;
@@ -262,6 +275,8 @@ class segment_reader_impl : public sub_reader {
     const directory& dir,
     uint64_t meta_version,
     uint64_t docs_count);
+
+  void init_live_docs(const document_mask& docs_mask);
 };
 
 segment_reader::segment_reader(impl_ptr&& impl) noexcept
@@ -316,9 +331,31 @@ segment_reader_impl::segment_reader_impl(
     uint64_t docs_count)
   : dir_(dir),
     docs_count_(docs_count),
+    live_docs_count_(docs_count),
     meta_version_(meta_version) {
 }
 
+void segment_reader_impl::init_live_docs(const document_mask& docs_mask) {
+  if (docs_mask.empty()) {
+    return;
+  }
+
+  // keep a bitmap rather than the mask itself, i.e. masking a document
+  // costs a bit test instead of a hash lookup
+  live_docs_.reset(doc_limits::min() + docs_count_);
+  live_docs_.set();
+  live_docs_.unset(doc_limits::invalid());
+
+  for (const auto doc : docs_mask) {
+    // ids outside of the segment never match anything, skip them
+    if (IRS_LIKELY(doc < live_docs_.size())) {
+      live_docs_.unset(doc);
+    }
+  }
+
+  live_docs_count_ = live_docs_.count();
+}
+
 const irs::column_reader* segment_reader_impl::column(string_ref name) const {
   auto it = named_columns_.find(make_hashed_ref(name));
   return it == named_columns_.end() ? nullptr : it->second;
@@ -340,15 +377,13 @@ column_iterator::ptr segment_reader_impl::columns() const {
 }
 
 doc_iterator::ptr segment_reader_impl::docs_iterator() const {
-  if (docs_mask_.empty()) {
+  if (!live_docs_.words()) {
     return memory::make_managed<::all_iterator>(docs_count_);
   }
 
   // the implementation generates doc_ids sequentially
-  return memory::make_managed<masked_docs_iterator>(
-    doc_limits::min(),
-    doc_id_t(doc_limits::min() + docs_count_),
-    docs_mask_);
+  return memory::make_managed<bitset_doc_iterator>(
+    live_docs_.begin(), live_docs_.end());
 }
 
 /*static*/ sub_reader::ptr segment_reader_impl::open(
@@ -358,12 +393,14 @@ doc_iterator::ptr segment_reader_impl::docs_iterator() const {
   PTR_NAMED(segment_reader_impl, reader, dir, meta.version, meta.docs_count);
 
   // read document mask
-  index_utils::read_document_mask(reader->docs_mask_, dir, meta);
+  document_mask docs_mask;
+  index_utils::read_document_mask(docs_mask, dir, meta);
+  reader->init_live_docs(docs_mask);
 
   // initialize mandatory field reader
   auto& field_reader = reader->field_reader_;
   field_reader = codec.get_field_reader();
-  field_reader->prepare(dir, meta, reader->docs_mask_);
+  field_reader->prepare(dir, meta, docs_mask);
 
   // initialize optional columnstore
   if (irs::has_columnstore(meta)) {
@@ -83,6 +83,10 @@ class segment_reader final : public sub_reader {
     return impl_->mask(std::move(it));
   }
 
+  virtual const bitset* live_docs() const noexcept override {
+    return impl_->live_docs();
+  }
+
   virtual const term_reader* field(string_ref name) const override {
     return impl_->field(name);
   }
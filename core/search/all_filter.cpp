@@ -49,6 +49,12 @@ class all_query final : public filter::prepared {
       rdr.docs_count(), boost());
   }
 
+  using filter::prepared::count;
+
+  virtual doc_count count(const sub_reader& rdr, uint64_t) const override {
+    return { rdr.live_docs_count(), true };
+  }
+
  private:
   bstring stats_;
 };
@@ -21,6 +21,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "all_iterator.hpp"
+
+#include <numeric>
+
 #include "formats/empty_term_reader.hpp"
 
 namespace iresearch {
@@ -48,4 +51,30 @@ all_iterator::all_iterator(
   }
 }
 
+size_t all_iterator::next_batch(
+    doc_id_t* docs,
+    uint32_t* freqs,
+    size_t count) noexcept {
+  auto& doc = std::get<document>(attrs_);
+
+  if (doc.value >= max_doc_) {
+    doc.value = doc_limits::eof();
+    return 0;
+  }
+
+  const size_t read = std::min(count, size_t(max_doc_ - doc.value));
+  std::iota(docs, docs + read, doc.value + 1);
+  doc.value += doc_id_t(read);
+
+  if (read < count) {
+    doc.value = doc_limits::eof();
+  }
+
+  if (freqs) {
+    std::fill_n(freqs, read, 0);
+  }
+
+  return read;
+}
+
 } // ROOT
@@ -72,6 +72,11 @@ class all_iterator final : public doc_iterator {
     return std::get<document>(attrs_).value;
   }
 
+  virtual size_t next_batch(
+    doc_id_t* docs,
+    uint32_t* freqs,
+    size_t count) noexcept override;
+
  private:
   using attributes = std::tuple<document, cost, score>;
 
@@ -76,6 +76,46 @@ bool bitset_doc_iterator::next() noexcept {
   return true;
 }
 
+size_t bitset_doc_iterator::next_batch(
+    doc_id_t* docs,
+    uint32_t* freqs,
+    size_t count) noexcept {
+  size_t read = 0;
+
+  while (read < count) {
+    if (!word_) {
+      // fetch the next non-empty word, possibly refilling the buffer
+      if (!next()) {
+        break;
+      }
+
+      docs[read++] = doc_.value;
+      continue;
+    }
+
+    // drain the current word
+    word_t word = word_;
+    doc_id_t value = doc_.value;
+
+    for (; word && read < count; ++read) {
+      const doc_id_t delta = doc_id_t(std::countr_zero(word));
+      assert(delta < bits_required<word_t>());
+
+      word = (word >> delta) >> 1;
+      docs[read] = (value += 1 + delta);
+    }
+
+    word_ = word;
+    doc_.value = value;
+  }
+
+  if (freqs) {
+    std::fill_n(freqs, read, 0);
+  }
+
+  return read;
+}
+
 doc_id_t bitset_doc_iterator::seek(doc_id_t target) noexcept {
   const doc_id_t word_idx = target / bits_required<word_t>();
 
@@ -23,9 +23,12 @@
 #ifndef IRESEARCH_BITSET_DOC_ITERATOR_H
 #define IRESEARCH_BITSET_DOC_ITERATOR_H
 
+#include <memory>
+
 #include "analysis/token_attributes.hpp"
 #include "search/cost.hpp"
 #include "search/score.hpp"
+#include "utils/bitset.hpp"
 #include "utils/frozen_attributes.hpp"
 #include "utils/type_limits.hpp"
 
@@ -41,6 +44,7 @@ class bitset_doc_iterator
 
   virtual bool next() noexcept override final;
   virtual doc_id_t seek(doc_id_t target) noexcept override final;
+  virtual size_t next_batch(doc_id_t* docs, uint32_t* freqs, size_t count) noexcept override final;
   virtual doc_id_t value() const noexcept override final { return doc_.value; }
   virtual attribute* get_mutable(irs::type_info::type_id id) noexcept override;
 
@@ -76,6 +80,37 @@ class bitset_doc_iterator
   doc_id_t base_;
 }; // bitset_doc_iterator
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class shared_bitset_doc_iterator
+/// @brief iterator over documents of a bitset kept alive by the iterator,
+///        the bitset may be shared, e.g. with a cache
+////////////////////////////////////////////////////////////////////////////////
+class shared_bitset_doc_iterator final : public bitset_doc_iterator {
+ public:
+  shared_bitset_doc_iterator(
+      std::shared_ptr<const bitset> set,
+      cost::cost_t count) noexcept
+    : bitset_doc_iterator(count),
+      set_(std::move(set)) {
+    assert(set_);
+  }
+
+ protected:
+  virtual bool refill(const word_t** begin, const word_t** end) noexcept override {
+    if (*begin) {
+      // the whole set has been already provided
+      return false;
+    }
+
+    *begin = set_->begin();
+    *end = set_->end();
+    return true;
+  }
+
+ private:
+  std::shared_ptr<const bitset> set_;
+}; // shared_bitset_doc_iterator
+
 } // ROOT
 
 #endif // IRESEARCH_BITSET_DOC_ITERATOR_H
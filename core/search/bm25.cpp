@@ -33,6 +33,7 @@
 #include "index/norm.hpp"
 #include "index/field_meta.hpp"
 #include "utils/math_utils.hpp"
+#include "utils/simd_dispatch.hpp"
 
 namespace {
 
@@ -487,6 +488,94 @@ score_function MakeScoreFunction(const filter_boost* filter_boost,
       std::forward<Args>(args)...);
 }
 
+struct BulkContext : public irs::score_ctx {
+  BulkContext(float_t k, irs::boost_t boost, const bm25::stats& stats) noexcept
+    : num{boost * (k + 1) * stats.idf},
+      norm_const{k} {
+  }
+
+  float_t num; // partially precomputed numerator : boost * (k + 1) * idf
+  float_t norm_const; // 'k' factor
+};
+
+template<typename Norm>
+struct BulkNormContext final : public BulkContext {
+  BulkNormContext(
+      float_t k,
+      irs::boost_t boost,
+      const bm25::stats& stats,
+      std::unique_ptr<document>&& doc,
+      Norm&& norm) noexcept
+    : BulkContext{k, boost, stats},
+      doc{std::move(doc)},
+      norm{std::move(norm)},
+      norm_length{stats.norm_length},
+      norm_cache{stats.norm_cache} {
+    assert(stats.norm_const);
+    assert(this->doc);
+    norm_const = stats.norm_const;
+  }
+
+  std::unique_ptr<document> doc; // document 'norm' reads values for
+  Norm norm;
+  float_t norm_length; // precomputed 'k*b/avgD'
+  const float_t* norm_cache;
+  // gathered norm values of a block, or '1/c1' in case of 'kNorm2Tiny'
+  float_t norms[bulk_score_function::kBlockSize]{};
+};
+
+static_assert(bulk_score_function::kBlockSize <= simd::dispatch::kScoreBlockSize);
+
+inline bulk_score_function MakeBulkScoreFunction(
+    float_t k, irs::boost_t boost, const bm25::stats& stats) {
+  return {
+    memory::make_unique<BulkContext>(k, boost, stats),
+    [](irs::score_ctx* ctx, const doc_id_t* /*docs*/,
+       const uint32_t* freqs, size_t count, float_t* scores) noexcept {
+      auto& state = *static_cast<BulkContext*>(ctx);
+
+      simd::dispatch::score_bm25(
+        freqs, count, scores, state.num, state.norm_const);
+    }
+  };
+}
+
+template<typename Norm>
+bulk_score_function MakeBulkScoreFunction(
+    float_t k, irs::boost_t boost, const bm25::stats& stats,
+    std::unique_ptr<document>&& doc, Norm&& norm) {
+  using Ctx = BulkNormContext<Norm>;
+
+  return {
+    memory::make_unique<Ctx>(k, boost, stats, std::move(doc), std::move(norm)),
+    [](irs::score_ctx* ctx, const doc_id_t* docs,
+       const uint32_t* freqs, size_t count, float_t* scores) {
+      auto& state = *static_cast<Ctx*>(ctx);
+
+      // gather norms
+      for (size_t i = 0; i < count; ++i) {
+        state.doc->value = docs[i];
+
+        if constexpr (NormType::kNorm2Tiny == Norm::kType) {
+          state.norms[i] = state.norm_cache[state.norm() & uint32_t{0xFF}];
+        } else {
+          state.norms[i] = static_cast<float_t>(state.norm());
+        }
+      }
+
+      if constexpr (NormType::kNorm2Tiny == Norm::kType) {
+        simd::dispatch::score_bm25_inv(
+          freqs, state.norms, count, scores, state.num);
+      } else {
+        simd::dispatch::score_bm25_norm(
+          freqs, state.norms, count, scores, state.num,
+          state.norm_const, state.norm_length,
+          NormType::kNorm == Norm::kType);
+      }
+    }
+  };
+}
+
 class sort final : public irs::prepared_sort_basic<bm25::score_t, bm25::stats> {
  public:
   sort(float_t k, float_t b, bool boost_as_score) noexcept
@@ -620,6 +709,72 @@ class sort final : public irs::prepared_sort_basic<bm25::score_t, bm25::stats> {
         filter_boost, score_buf, k_, boost, stats, freq);
   }
 
+  virtual max_score_f prepare_max_score(
+      const sub_reader& /*segment*/,
+      const term_reader& /*field*/,
+      const byte_type* query_stats,
+      boost_t boost) const override {
+    auto& stats = stats_cast(query_stats);
+
+    const float_t c0 = boost * (k_ + 1) * stats.idf;
+    // document length norm is unknown upfront, assume the shortest
+    // possible document, i.e. the smallest possible 'c1'
+    const float_t c1 = (b_ == 0.f ? k_ : stats.norm_const);
+    // score value of the documents without frequency
+    const float_t min = boost_as_score_ ? boost : 0.f;
+
+    return [c0, c1, min](uint32_t max_freq) noexcept -> float_t {
+      const float_t tf = static_cast<float_t>(max_freq);
+      return std::max(min, c0 - c0 * c1 / (c1 + tf));
+    };
+  }
+
+  virtual bulk_score_function prepare_bulk_scorer(
+      const sub_reader& segment,
+      const term_reader& field,
+      const byte_type* query_stats,
+      boost_t boost) const override {
+    if (IndexFeatures::NONE == (field.meta().index_features & IndexFeatures::FREQ)) {
+      return {};
+    }
+
+    auto& stats = stats_cast(query_stats);
+
+    if (b_ == 0.f) {
+      // BM15
+      return MakeBulkScoreFunction(k_, boost, stats);
+    }
+
+    auto doc = memory::make_unique<document>();
+
+    auto prepare_norm_scorer = [&]<typename Norm>(Norm&& norm) -> bulk_score_function {
+      return MakeBulkScoreFunction(k_, boost, stats, std::move(doc), std::move(norm));
+    };
+
+    const auto& features = field.meta().features;
+
+    if (auto it = features.find(irs::type<Norm2>::id()); it != features.end()) {
+      if (Norm2ReaderContext ctx; ctx.Reset(segment, it->second, *doc)) {
+        if (ctx.max_num_bytes == sizeof(byte_type)) {
+          return Norm2::MakeReader(std::move(ctx), [&](auto&& reader) {
+              return prepare_norm_scorer(MakeNormAdapter<NormType::kNorm2Tiny>(std::move(reader))); });
+        }
+
+        return Norm2::MakeReader(std::move(ctx), [&](auto&& reader) {
+            return prepare_norm_scorer(MakeNormAdapter<NormType::kNorm2>(std::move(reader))); });
+      }
+    }
+
+    if (auto it = features.find(irs::type<Norm>::id()); it != features.end()) {
+      if (NormReaderContext ctx; ctx.Reset(segment, it->second, *doc)) {
+        return prepare_norm_scorer(MakeNormAdapter<NormType::kNorm>(Norm::MakeReader(std::move(ctx))));
+      }
+    }
+
+    // No norms, pretend all fields have the same length 1.
+    return prepare_norm_scorer(MakeNormAdapter<NormType::kNorm2Tiny>([](){ return 1U; }));
+  }
+
   virtual irs::sort::term_collector::ptr prepare_term_collector() const override {
     return irs::memory::make_unique<term_collector>();
   }
@@ -24,10 +24,12 @@
 
 #include <boost/functional/hash.hpp>
 
+#include "bitset_doc_iterator.hpp"
 #include "conjunction.hpp"
 #include "disjunction.hpp"
 #include "min_match_disjunction.hpp"
 #include "exclusion.hpp"
+#include "utils/bitset.hpp"
 
 namespace {
 
@@ -45,6 +47,23 @@ std::pair<const irs::filter*, bool> optimize_not(const irs::Not& node) {
 }
 
 const irs::all all_docs_zero_boost = []() {irs::all a; a.boost(0); return a;}();
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns true if dynamic pruning is applicable to a disjunction over the
+///          specified sub-iterators, i.e. scores are aggregated by a single
+///          bucket and upper bounds of the scores are known
+//////////////////////////////////////////////////////////////////////////////
+template<typename Iterators>
+bool use_max_score(const irs::order::prepared& ord, const Iterators& itrs) {
+  return itrs.size() > 1 &&
+         1 == ord.size() &&
+         !ord.begin()->score_offset &&
+         std::any_of(itrs.begin(), itrs.end(), [](const auto& it) {
+           return !it.score->is_default() &&
+                  it.score->bounds.tail < std::numeric_limits<float_t>::max();
+         });
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @returns disjunction iterator created from the specified queries
 //////////////////////////////////////////////////////////////////////////////
@@ -68,8 +87,8 @@ irs::doc_iterator::ptr make_disjunction(
     return irs::doc_iterator::empty();
   }
 
-  scored_disjunction_t::doc_iterators_t itrs;
-  itrs.reserve(size);
+  auto itrs = irs::memory::vector_pool<
+    scored_disjunction_t::doc_iterators_t::value_type>::make(size);
 
   for (;begin != end; ++begin) {
     // execute query - get doc iterator
@@ -86,6 +105,16 @@ irs::doc_iterator::ptr make_disjunction(
       std::move(itrs), ord, std::forward<Args>(args)...);
   }
 
+  if constexpr (0 == sizeof...(Args)) {
+    if (use_max_score(ord, itrs)) {
+      using max_score_disjunction_t =
+        irs::max_score_disjunction<irs::doc_iterator::ptr>;
+
+      return irs::memory::make_managed<max_score_disjunction_t>(
+        std::move(itrs), ord);
+    }
+  }
+
   return irs::make_disjunction<scored_disjunction_t>(
     std::move(itrs), ord, std::forward<Args>(args)...);
 }
@@ -114,8 +143,8 @@ irs::doc_iterator::ptr make_conjunction(
       return begin->execute(rdr, ord, ctx);
   }
 
-  conjunction_t::doc_iterators_t itrs;
-  itrs.reserve(size);
+  auto itrs = irs::memory::vector_pool<
+    conjunction_t::doc_iterators_t::value_type>::make(size);
 
   for (;begin != end; ++begin) {
     auto docs = begin->execute(rdr, ord, ctx);
@@ -133,6 +162,178 @@ irs::doc_iterator::ptr make_conjunction(
   );
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @returns 'incl' without documents matched by the specified queries
+//////////////////////////////////////////////////////////////////////////////
+template<typename QueryIterator>
+irs::doc_iterator::ptr make_exclusion(
+    const irs::sub_reader& rdr,
+    const irs::attribute_provider* ctx,
+    irs::doc_iterator::ptr&& incl,
+    QueryIterator begin,
+    QueryIterator end) {
+  if (begin == end || irs::doc_limits::eof(incl->value())) {
+    // nothing to exclude from, don't execute excluded queries at all
+    return std::move(incl);
+  }
+
+  // exclusion part does not affect scoring at all
+  auto excl = ::make_disjunction(rdr, irs::order::prepared::unordered(), ctx,
+                                 begin, end);
+
+  // got empty iterator for excluded
+  if (irs::doc_limits::eof(excl->value())) {
+    // pure conjunction/disjunction
+    return std::move(incl);
+  }
+
+  return irs::memory::make_managed<irs::exclusion>(
+    std::move(incl), std::move(excl));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief invokes 'visitor(docs, count)' for all documents of 'it'
+//////////////////////////////////////////////////////////////////////////////
+template<typename Visitor>
+void visit_batches(irs::doc_iterator& it, Visitor&& visitor) {
+  constexpr size_t kBatchSize = 512;
+  irs::doc_id_t docs[kBatchSize];
+
+  for (size_t read = kBatchSize; read == kBatchSize; ) {
+    read = it.next_batch(docs, nullptr, kBatchSize);
+    visitor(docs, read);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns conjunction of the specified iterators evaluated eagerly via
+///          bitsets, documents matched by the excluded queries are removed
+//////////////////////////////////////////////////////////////////////////////
+template<typename QueryIterator>
+irs::doc_iterator::ptr make_bitset_conjunction(
+    const irs::sub_reader& rdr,
+    const irs::attribute_provider* ctx,
+    std::vector<irs::doc_iterator::ptr>&& itrs,
+    QueryIterator excl_begin,
+    QueryIterator excl_end) {
+  assert(!itrs.empty());
+
+  const size_t bits = rdr.docs_count() + irs::doc_limits::min();
+  irs::bitset docs(bits);
+
+  visit_batches(*itrs.front(), [&docs](const irs::doc_id_t* begin, size_t size) {
+    for (auto* end = begin + size; begin != end; ++begin) {
+      docs.set(*begin);
+    }
+  });
+
+  irs::bitset matched(bits);
+  for (auto it = itrs.begin() + 1, end = itrs.end(); it != end; ++it) {
+    matched.clear();
+
+    visit_batches(**it, [&docs, &matched](const irs::doc_id_t* begin, size_t size) {
+      for (auto* end = begin + size; begin != end; ++begin) {
+        matched.reset(*begin, docs.test(*begin));
+      }
+    });
+
+    std::swap(docs, matched);
+
+    if (docs.none()) {
+      return irs::doc_iterator::empty();
+    }
+  }
+
+  // exclusion part does not affect scoring at all
+  for (; excl_begin != excl_end; ++excl_begin) {
+    auto excl = excl_begin->execute(rdr, irs::order::prepared::unordered(), ctx);
+
+    visit_batches(*excl, [&docs](const irs::doc_id_t* begin, size_t size) {
+      for (auto* end = begin + size; begin != end; ++begin) {
+        docs.unset(*begin);
+      }
+    });
+  }
+
+  const auto count = docs.count();
+
+  if (!count) {
+    return irs::doc_iterator::empty();
+  }
+
+  return irs::memory::make_managed<irs::shared_bitset_doc_iterator>(
+    std::make_shared<const irs::bitset>(std::move(docs)), count);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns unscored conjunction of the specified included queries excluding
+///          documents matched by the excluded queries, execution strategy is
+///          chosen according to the cost estimates of the sub-iterators:
+///          - bitset intersection if all sub-iterators are dense
+///          - block intersection otherwise
+//////////////////////////////////////////////////////////////////////////////
+template<typename QueryIterator>
+irs::doc_iterator::ptr make_unscored_conjunction(
+    const irs::sub_reader& rdr,
+    const irs::attribute_provider* ctx,
+    QueryIterator begin,
+    QueryIterator end,
+    QueryIterator excl_begin,
+    QueryIterator excl_end) {
+  // sub-iterator is considered dense if its cost exceeds
+  // the specified fraction of documents in a segment
+  constexpr irs::cost::cost_t kDenseRatio = 16;
+  // bitsets aren't worth it for small segments
+  constexpr uint64_t kBitsetMinDocs = 4096;
+
+  assert(std::distance(begin, end) >= 0);
+  const size_t size = std::distance(begin, end);
+
+  if (0 == size) {
+    return irs::doc_iterator::empty();
+  }
+
+  std::vector<irs::doc_iterator::ptr> itrs;
+  itrs.reserve(size);
+
+  for (;begin != end; ++begin) {
+    auto docs = begin->execute(rdr, irs::order::prepared::unordered(), ctx);
+
+    // filter out empty iterators
+    if (irs::doc_limits::eof(docs->value())) {
+      return irs::doc_iterator::empty();
+    }
+
+    itrs.emplace_back(std::move(docs));
+  }
+
+  if (1 == size) {
+    return make_exclusion(rdr, ctx, std::move(itrs.front()), excl_begin, excl_end);
+  }
+
+  const auto lead = std::min_element(
+    itrs.begin(), itrs.end(),
+    [](const irs::doc_iterator::ptr& lhs, const irs::doc_iterator::ptr& rhs) {
+      return irs::cost::extract(*lhs, irs::cost::MAX) <
+             irs::cost::extract(*rhs, irs::cost::MAX);
+  });
+  std::iter_swap(itrs.begin(), lead);
+
+  const auto lead_cost = irs::cost::extract(*itrs.front(), irs::cost::MAX);
+
+  if (const auto docs_count = rdr.docs_count();
+      docs_count >= kBitsetMinDocs &&
+      lead_cost != irs::cost::MAX &&
+      lead_cost >= docs_count / kDenseRatio) {
+    return make_bitset_conjunction(rdr, ctx, std::move(itrs), excl_begin, excl_end);
+  }
+
+  return make_exclusion(
+    rdr, ctx,
+    irs::memory::make_managed<irs::block_conjunction>(std::move(itrs)),
+    excl_begin, excl_end);
+}
+
 } // LOCAL
 
 namespace iresearch {
@@ -159,17 +360,7 @@ class boolean_query : public filter::prepared {
     assert(excl_);
     auto incl = execute(rdr, ord, ctx, begin(), begin() + excl_);
 
-    // exclusion part does not affect scoring at all
-    auto excl = ::make_disjunction(rdr, order::prepared::unordered(), ctx,
-                                   begin() + excl_, end());
-
-    // got empty iterator for excluded
-    if (doc_limits::eof(excl->value())) {
-      // pure conjunction/disjunction
-      return incl;
-    }
-
-    return memory::make_managed<exclusion>(std::move(incl), std::move(excl));
+    return ::make_exclusion(rdr, ctx, std::move(incl), excl_begin(), end());
   }
 
   virtual void prepare(
@@ -231,6 +422,20 @@ class boolean_query : public filter::prepared {
 //////////////////////////////////////////////////////////////////////////////
 class and_query final : public boolean_query {
  public:
+  virtual doc_iterator::ptr execute(
+      const sub_reader& rdr,
+      const order::prepared& ord,
+      const attribute_provider* ctx) const override {
+    if (empty() || !ord.empty()) {
+      return boolean_query::execute(rdr, ord, ctx);
+    }
+
+    // per-segment execution plan for unscored conjunction
+    return ::make_unscored_conjunction(
+      rdr, ctx, begin(), excl_begin(), excl_begin(), end());
+  }
+
+ protected:
   virtual doc_iterator::ptr execute(
       const sub_reader& rdr,
       const order::prepared& ord,
@@ -291,14 +496,18 @@ class min_match_query final : public boolean_query {
       return doc_iterator::empty();
     } else if (min_match_count == size) {
       // pure conjunction
+      if (ord.empty()) {
+        return ::make_unscored_conjunction(rdr, ctx, begin, end, end, end);
+      }
+
       return ::make_conjunction(rdr, ord, ctx, begin, end);
     }
 
     // min_match_count <= size
     min_match_count = std::min(size, min_match_count);
 
-    disjunction_t::doc_iterators_t itrs;
-    itrs.reserve(size);
+    auto itrs = irs::memory::vector_pool<
+      disjunction_t::doc_iterators_t::value_type>::make(size);
 
     for (;begin != end; ++begin) {
       // execute query - get doc iterator
@@ -334,6 +543,13 @@ class min_match_query final : public boolean_query {
       typedef conjunction<doc_iterator::ptr> conjunction_t;
 
       // pure conjunction
+      if (ord.empty()) {
+        return memory::make_managed<block_conjunction>(
+          block_conjunction::doc_iterators_t(
+            std::make_move_iterator(itrs.begin()),
+            std::make_move_iterator(itrs.end())));
+      }
+
       return memory::make_managed<conjunction_t>(
         conjunction_t::doc_iterators_t(
           std::make_move_iterator(itrs.begin()),
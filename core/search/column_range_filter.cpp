@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "column_range_filter.hpp"
+
+#include <absl/container/flat_hash_set.h>
+
+#include "analysis/token_attributes.hpp"
+#include "formats/formats.hpp"
+#include "index/index_reader.hpp"
+#include "search/cost.hpp"
+#include "search/filter_visitor.hpp"
+#include "utils/frozen_attributes.hpp"
+
+namespace {
+
+using namespace irs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class column_range_iterator
+/// @brief iterator over documents of a column with values within a range
+////////////////////////////////////////////////////////////////////////////////
+class column_range_iterator final : public doc_iterator {
+ public:
+  column_range_iterator(
+      doc_iterator::ptr&& values,
+      const payload& value,
+      const by_column_range_options::range_type& range,
+      cost::cost_t estimation) noexcept
+    : values_(std::move(values)),
+      value_(&value),
+      range_(&range) {
+    assert(values_);
+    std::get<cost>(attrs_).reset(estimation);
+  }
+
+  virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    return irs::get_mutable(attrs_, type);
+  }
+
+  virtual doc_id_t value() const noexcept override {
+    return std::get<document>(attrs_).value;
+  }
+
+  virtual bool next() override {
+    auto& doc = std::get<document>(attrs_);
+
+    while (values_->next()) {
+      if (matches()) {
+        doc.value = values_->value();
+        return true;
+      }
+    }
+
+    doc.value = doc_limits::eof();
+    return false;
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    auto& doc = std::get<document>(attrs_);
+
+    if (target <= doc.value) {
+      return doc.value;
+    }
+
+    // verify the target document first
+    if (const auto value = values_->seek(target); doc_limits::eof(value)) {
+      doc.value = value;
+    } else if (matches()) {
+      doc.value = value;
+    } else {
+      next();
+    }
+
+    return doc.value;
+  }
+
+ private:
+  using attributes = std::tuple<document, cost>;
+
+  bool matches() const noexcept {
+    const bytes_ref value = value_->value;
+
+    if (const auto& min = range_->min; BoundType::UNBOUNDED != range_->min_type) {
+      const auto cmp = compare(value, bytes_ref(min.front()));
+
+      if (cmp < 0 || (!cmp && BoundType::EXCLUSIVE == range_->min_type)) {
+        return false;
+      }
+    }
+
+    if (const auto& max = range_->max; BoundType::UNBOUNDED != range_->max_type) {
+      const auto cmp = compare(value, bytes_ref(max.front()));
+
+      if (cmp > 0 || (!cmp && BoundType::EXCLUSIVE == range_->max_type)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  attributes attrs_;
+  doc_iterator::ptr values_;
+  const payload* value_;
+  const by_column_range_options::range_type* range_;
+}; // column_range_iterator
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class docs_count_visitor
+/// @brief accumulates document frequencies of the visited terms, postings
+///        are neither read nor collected
+////////////////////////////////////////////////////////////////////////////////
+class docs_count_visitor final : public filter_visitor {
+ public:
+  virtual void prepare(
+      const sub_reader& /*segment*/,
+      const term_reader& /*field*/,
+      const seek_term_iterator& terms) override {
+    meta_ = irs::get<term_meta>(terms);
+  }
+
+  virtual void visit(boost_t /*boost*/) override {
+    if (meta_) {
+      docs_count_ += meta_->docs_count;
+    }
+  }
+
+  uint64_t docs_count() const noexcept { return docs_count_; }
+
+ private:
+  const term_meta* meta_{};
+  uint64_t docs_count_{};
+}; // docs_count_visitor
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class segments_view
+/// @brief index reader over a subset of segments of another reader
+////////////////////////////////////////////////////////////////////////////////
+class segments_view final : public index_reader {
+ public:
+  void push_back(const sub_reader& segment) {
+    segments_.emplace_back(&segment);
+    docs_count_ += segment.docs_count();
+    live_docs_count_ += segment.live_docs_count();
+  }
+
+  virtual uint64_t live_docs_count() const noexcept override {
+    return live_docs_count_;
+  }
+
+  virtual uint64_t docs_count() const noexcept override {
+    return docs_count_;
+  }
+
+  virtual const sub_reader& operator[](size_t i) const noexcept override {
+    assert(i < segments_.size());
+    return *segments_[i];
+  }
+
+  virtual size_t size() const noexcept override {
+    return segments_.size();
+  }
+
+ private:
+  std::vector<const sub_reader*> segments_;
+  uint64_t docs_count_{};
+  uint64_t live_docs_count_{};
+}; // segments_view
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class column_range_query
+////////////////////////////////////////////////////////////////////////////////
+class column_range_query final : public filter::prepared {
+ public:
+  using segments_t = absl::flat_hash_set<const sub_reader*>;
+
+  column_range_query(
+      std::string_view field,
+      const by_column_range_options& options,
+      segments_t&& expanded,
+      filter::prepared::ptr&& terms)
+    : field_(field),
+      options_(options),
+      expanded_(std::move(expanded)),
+      terms_(std::move(terms)) {
+  }
+
+  virtual doc_iterator::ptr execute(
+      const sub_reader& segment,
+      const order::prepared& /*ord*/,
+      const attribute_provider* ctx) const override {
+    if (expanded_.contains(&segment)) {
+      // selective range, expanded at prepare time
+      return terms_
+        ? terms_->execute(segment, order::prepared::unordered(), ctx)
+        : doc_iterator::empty();
+    }
+
+    const auto* column = segment.column(field_);
+
+    if (!column) {
+      return doc_iterator::empty();
+    }
+
+    auto values = column->iterator(false);
+
+    if (IRS_UNLIKELY(!values)) {
+      return doc_iterator::empty();
+    }
+
+    const auto* value = irs::get<payload>(*values);
+
+    if (IRS_UNLIKELY(!value)) {
+      return doc_iterator::empty();
+    }
+
+    return memory::make_managed<column_range_iterator>(
+      std::move(values), *value, options_.range, column->size());
+  }
+
+ private:
+  std::string field_;
+  by_column_range_options options_;
+  segments_t expanded_; // segments evaluated via term expansion
+  filter::prepared::ptr terms_; // nullptr if no terms matched
+}; // column_range_query
+
+}
+
+namespace iresearch {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                    by_column_range implementation
+// -----------------------------------------------------------------------------
+
+DEFINE_FACTORY_DEFAULT(by_column_range) // cppcheck-suppress unknownMacro
+
+filter::prepared::ptr by_column_range::prepare(
+    const index_reader& index,
+    const order::prepared& /*ord*/,
+    boost_t /*boost*/,
+    const attribute_provider* /*ctx*/) const {
+  const auto& rng = options().range;
+
+  if ((BoundType::UNBOUNDED != rng.min_type && rng.min.empty()) ||
+      (BoundType::UNBOUNDED != rng.max_type && rng.max.empty())) {
+    // boundary terms are required
+    return prepared::empty();
+  }
+
+  if (BoundType::UNBOUNDED != rng.min_type &&
+      BoundType::UNBOUNDED != rng.max_type) {
+    const auto cmp = compare(bytes_ref(rng.min.front()),
+                             bytes_ref(rng.max.front()));
+
+    if (cmp > 0 || (!cmp && (BoundType::EXCLUSIVE == rng.min_type ||
+                             BoundType::EXCLUSIVE == rng.max_type))) {
+      // can't satisfy condition
+      return prepared::empty();
+    }
+  }
+
+  column_range_query::segments_t expanded;
+  filter::prepared::ptr terms;
+
+  if (const size_t selectivity = options().selectivity; selectivity) {
+    // choose a strategy for every segment from the document frequencies
+    // of the range terms, postings are read only for the expanded segments
+    segments_view selective;
+
+    for (auto& segment : index) {
+      const auto* reader = segment.field(field());
+
+      if (!reader) {
+        // nothing to estimate, evaluate against the column
+        continue;
+      }
+
+      docs_count_visitor visitor;
+      by_granular_range::visit(segment, *reader, rng, visitor);
+
+      const auto docs_count = visitor.docs_count();
+      const auto* column = segment.column(field());
+
+      if (!column || docs_count * selectivity <= column->size()) {
+        expanded.emplace(&segment);
+
+        if (docs_count) {
+          selective.push_back(segment);
+        }
+      }
+    }
+
+    if (selective.size()) {
+      // matched documents aren't scored
+      terms = by_granular_range::prepare(
+        selective, order::prepared::unordered(), no_boost(),
+        field(), rng, 0);
+    }
+  }
+
+  return memory::make_managed<column_range_query>(
+    field(), options(), std::move(expanded), std::move(terms));
+}
+
+} // ROOT
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IRESEARCH_COLUMN_RANGE_FILTER_H
+#define IRESEARCH_COLUMN_RANGE_FILTER_H
+
+#include "search/granular_range_filter.hpp"
+
+namespace iresearch {
+
+class by_column_range;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @struct by_column_range_options
+/// @brief options for column range filter
+////////////////////////////////////////////////////////////////////////////////
+struct by_column_range_options {
+  using filter_type = by_column_range;
+  using range_type = by_granular_range_options::range_type;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief search range, the same as for 'by_granular_range'
+  /// @note values of the column are compared lexicographically against the
+  ///       most precise terms of the boundaries, i.e. the column is expected
+  ///       to store values encoded the same way, e.g. via
+  ///       'numeric_utils::numeric_traits<T>::encode(...)'
+  /// @note consider using "set_granular_term" function for convenience
+  //////////////////////////////////////////////////////////////////////////////
+  range_type range;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief expand the range into terms of the field of the same name if the
+  ///        expanded terms match less than 1/'selectivity' of the documents
+  ///        in the column, 0 - always evaluate against the column
+  //////////////////////////////////////////////////////////////////////////////
+  size_t selectivity{16};
+
+  bool operator==(const by_column_range_options& rhs) const noexcept {
+    return range == rhs.range && selectivity == rhs.selectivity;
+  }
+
+  size_t hash() const noexcept {
+    return hash_combine(selectivity, range);
+  }
+}; // by_column_range_options
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class by_column_range
+/// @brief user-side range filter evaluated against values of a column
+///        rather than by expanding and unioning the terms of the range.
+///        An execution strategy is chosen for every segment:
+///          - term expansion if the range is selective
+///          - column lookup otherwise, the resulting iterator is as
+///            expensive as the whole column, so it's rather verified
+///            via 'seek(...)' if used inside a selective conjunction
+/// @note the filter doesn't contribute to the score of matched documents
+//////////////////////////////////////////////////////////////////////////////
+class by_column_range
+    : public filter_base<by_column_range_options> {
+ public:
+  static ptr make();
+
+  using filter::prepare;
+
+  virtual filter::prepared::ptr prepare(
+    const index_reader& index,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_provider* ctx) const override;
+}; // by_column_range
+
+} // ROOT
+
+#endif // IRESEARCH_COLUMN_RANGE_FILTER_H
@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "conjunction.hpp"
+
+namespace iresearch {
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                block_conjunction
+// ----------------------------------------------------------------------------
+
+block_conjunction::block_conjunction(doc_iterators_t&& itrs)
+  : count_less_(simd::dispatch::count_less_kernel()) {
+  assert(itrs.size() > 1);
+
+  // sort subnodes in ascending order by their cost
+  std::sort(itrs.begin(), itrs.end(),
+    [](const doc_iterator::ptr& lhs, const doc_iterator::ptr& rhs) {
+      return cost::extract(*lhs, cost::MAX) < cost::extract(*rhs, cost::MAX);
+  });
+
+  const auto lead_cost = cost::extract(*itrs.front(), cost::MAX);
+  const auto max_cost = lead_cost > cost::MAX / kSeekRatio
+    ? cost::MAX
+    : lead_cost * kSeekRatio;
+
+  itrs_.reserve(itrs.size());
+  size_t buffered = 0;
+  for (auto& it : itrs) {
+    assert(it);
+    auto& sub = itrs_.emplace_back();
+    buffered += size_t(cost::extract(*it, cost::MAX) <= max_cost);
+    sub.it = std::move(it);
+  }
+
+  // the lead iterator is read directly into 'docs_'
+  --buffered;
+
+  if (buffered) {
+    buf_ = std::make_unique<doc_id_t[]>(buffered*kBlockSize);
+
+    auto* buf = buf_.get();
+    for (auto it = itrs_.begin() + 1, end = itrs_.end(); it != end; ++it) {
+      if (cost::extract(*it->it, cost::MAX) <= max_cost) {
+        it->docs = buf;
+        buf += kBlockSize;
+      }
+    }
+  }
+
+  std::get<document>(attrs_).value = doc_limits::invalid();
+  std::get<attribute_ptr<cost>>(attrs_) =
+    irs::get_mutable<cost>(itrs_.front().it.get());
+}
+
+bool block_conjunction::next() {
+  auto& doc = std::get<document>(attrs_);
+
+  if (begin_ == end_ && !refill(doc_limits::invalid())) {
+    doc.value = doc_limits::eof();
+    return false;
+  }
+
+  doc.value = docs_[begin_++];
+  return true;
+}
+
+doc_id_t block_conjunction::seek(doc_id_t target) {
+  auto& doc = std::get<document>(attrs_);
+
+  if (target <= doc.value) {
+    return doc.value;
+  }
+
+  begin_ += count_less_(docs_ + begin_, end_ - begin_, target);
+
+  if (begin_ == end_ && !refill(target)) {
+    doc.value = doc_limits::eof();
+    return doc.value;
+  }
+
+  doc.value = docs_[begin_++];
+  return doc.value;
+}
+
+size_t block_conjunction::next_batch(
+    doc_id_t* docs,
+    uint32_t* freqs,
+    size_t count) {
+  auto& doc = std::get<document>(attrs_);
+  size_t read = 0;
+
+  while (read < count) {
+    if (begin_ == end_ && !refill(doc_limits::invalid())) {
+      doc.value = doc_limits::eof();
+      break;
+    }
+
+    const size_t size = std::min(count - read, end_ - begin_);
+    std::memcpy(docs + read, docs_ + begin_, size*sizeof(doc_id_t));
+    begin_ += size;
+    read += size;
+    doc.value = docs[read - 1];
+  }
+
+  if (freqs) {
+    std::memset(freqs, 0, read*sizeof(uint32_t));
+  }
+
+  return read;
+}
+
+bool block_conjunction::fetch(sub_iterator& it, doc_id_t target) {
+  assert(it.docs);
+  assert(it.pos == it.size);
+
+  it.pos = 0;
+  it.size = 0;
+
+  if (it.eof) {
+    return false;
+  }
+
+  // skip blocks which can't contain the target
+  if (const auto doc = it.it->value(); target > doc + 1) {
+    if (doc_limits::eof(it.it->seek(target))) {
+      it.eof = true;
+      return false;
+    }
+
+    it.docs[it.size++] = it.it->value();
+  }
+
+  const size_t count = kBlockSize - it.size;
+  const size_t read = it.it->next_batch(it.docs + it.size, nullptr, count);
+  it.size += read;
+  it.eof = read < count;
+
+  return it.size != 0;
+}
+
+bool block_conjunction::contains(sub_iterator& it, doc_id_t target) {
+  if (!it.docs) {
+    // probe expensive iterator via seek
+    auto doc = it.it->value();
+
+    if (doc < target) {
+      doc = it.it->seek(target);
+      it.eof = doc_limits::eof(doc);
+    }
+
+    return doc == target;
+  }
+
+  for (;;) {
+    if (it.pos == it.size && !fetch(it, target)) {
+      return false;
+    }
+
+    if (it.docs[it.size - 1] >= target) {
+      break;
+    }
+
+    it.pos = it.size;
+  }
+
+  it.pos += count_less_(it.docs + it.pos, it.size - it.pos, target);
+  assert(it.pos < it.size);
+
+  return it.docs[it.pos] == target;
+}
+
+bool block_conjunction::refill(doc_id_t target) {
+  auto& lead = *itrs_.front().it;
+
+  begin_ = end_ = 0;
+
+  while (!eof_) {
+    // fetch the next block of candidates from the lead iterator
+    size_t size = 0;
+    if (target > lead.value() + 1) {
+      if (doc_limits::eof(lead.seek(target))) {
+        eof_ = true;
+        break;
+      }
+      docs_[size++] = lead.value();
+    }
+
+    const size_t count = kBlockSize - size;
+    const size_t read = lead.next_batch(docs_ + size, nullptr, count);
+    size += read;
+    eof_ = read < count;
+
+    if (!size) {
+      break;
+    }
+
+    // intersect candidates with other iterators in place
+    for (auto it = itrs_.begin() + 1, end = itrs_.end(); it != end && size; ++it) {
+      size_t matched = 0;
+
+      for (size_t i = 0; i < size; ++i) {
+        const doc_id_t doc = docs_[i];
+
+        if (contains(*it, doc)) {
+          docs_[matched++] = doc;
+        } else if (it->eof && (!it->docs || it->pos == it->size)) {
+          // sub-iterator is exhausted, remaining candidates can't match
+          eof_ = true;
+          break;
+        }
+      }
+
+      size = matched;
+    }
+
+    if (size) {
+      end_ = size;
+      return true;
+    }
+
+    target = doc_limits::invalid();
+  }
+
+  return false;
+}
+
+}
@@ -27,6 +27,9 @@
 #include "search/cost.hpp"
 #include "search/score.hpp"
 #include "utils/frozen_attributes.hpp"
+#include "utils/memory_pool.hpp"
+#include "utils/misc.hpp"
+#include "utils/simd_dispatch.hpp"
 #include "utils/type_limits.hpp"
 
 namespace iresearch {
@@ -87,7 +90,10 @@ struct score_iterator_adapter {
 ///-----------------------------------------------------------------------------
 ////////////////////////////////////////////////////////////////////////////////
 template<typename DocIterator>
-class conjunction : public doc_iterator, private score_ctx {
+class conjunction
+    : public doc_iterator,
+      public memory::pooled_object<conjunction<DocIterator>>,
+      private score_ctx {
  public:
   using doc_iterator_t = score_iterator_adapter<DocIterator>;
   using doc_iterators_t = std::vector<doc_iterator_t>;
@@ -142,6 +148,11 @@ class conjunction : public doc_iterator, private score_ctx {
   // size of conjunction
   size_t size() const noexcept { return itrs_.size(); }
 
+  ~conjunction() {
+    // keep the buffer of sub-iterators for the next query
+    memory::vector_pool<typename doc_iterators_t::value_type>::release(itrs_);
+  }
+
   virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override final {
     return irs::get_mutable(attrs_, type);
   }
@@ -280,6 +291,70 @@ class conjunction : public doc_iterator, private score_ctx {
   order::prepared::merger merger_;
 }; // conjunction
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class block_conjunction
+/// @brief unscored conjunction intersecting blocks of documents retrieved via
+///        'doc_iterator::next_batch(...)' rather than converging sub-iterators
+///        document by document. Candidates are taken from the lead (the least
+///        cost) iterator, sub-iterators significantly more expensive than the
+///        lead one are probed via 'seek(...)' instead.
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API block_conjunction final : public doc_iterator {
+ public:
+  using doc_iterators_t = std::vector<doc_iterator::ptr>;
+
+  // number of documents in a block
+  static constexpr size_t kBlockSize = 128;
+
+  // sub-iterator is probed via 'seek(...)' if its cost exceeds the
+  // cost of the lead iterator by the specified factor
+  static constexpr cost::cost_t kSeekRatio = 32;
+
+  explicit block_conjunction(doc_iterators_t&& itrs);
+
+  virtual attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    return irs::get_mutable(attrs_, type);
+  }
+
+  virtual doc_id_t value() const noexcept override {
+    return std::get<document>(attrs_).value;
+  }
+
+  virtual bool next() override;
+  virtual doc_id_t seek(doc_id_t target) override;
+  virtual size_t next_batch(doc_id_t* docs, uint32_t* freqs, size_t count) override;
+
+  // size of conjunction
+  size_t size() const noexcept { return itrs_.size(); }
+
+ private:
+  using attributes = std::tuple<
+    document,
+    attribute_ptr<cost>,
+    score>;
+
+  struct sub_iterator {
+    doc_iterator::ptr it;
+    doc_id_t* docs{}; // buffered documents, nullptr if probed via 'seek(...)'
+    size_t pos{};
+    size_t size{};
+    bool eof{}; // no more documents apart from the buffered ones
+  };
+
+  bool refill(doc_id_t target);
+  bool contains(sub_iterator& it, doc_id_t target);
+  bool fetch(sub_iterator& it, doc_id_t target);
+
+  attributes attrs_;
+  simd::dispatch::count_less_f count_less_; // resolved once per iterator
+  std::vector<sub_iterator> itrs_; // lead iterator goes first
+  std::unique_ptr<doc_id_t[]> buf_; // documents of the buffered sub-iterators
+  doc_id_t docs_[kBlockSize]; // intersection of the current block
+  size_t begin_{};
+  size_t end_{};
+  bool eof_{}; // no more blocks apart from the current one
+}; // block_conjunction
+
 //////////////////////////////////////////////////////////////////////////////
 /// @returns conjunction iterator created from the specified sub iterators 
 //////////////////////////////////////////////////////////////////////////////
@@ -287,6 +362,13 @@ template<typename Conjunction, typename... Args>
 doc_iterator::ptr make_conjunction(
     typename Conjunction::doc_iterators_t&& itrs,
     Args&&... args) {
+  using doc_iterators_t = typename Conjunction::doc_iterators_t;
+
+  // recycle the buffer unless it's taken over by a conjunction
+  auto release = make_finally([&itrs]() noexcept {
+    memory::vector_pool<typename doc_iterators_t::value_type>::release(itrs);
+  });
+
   switch (itrs.size()) {
     case 0:
       // empty or unreachable search criteria
@@ -26,6 +26,7 @@
 #include <queue>
 
 #include "conjunction.hpp"
+#include "analysis/token_attributes.hpp"
 #include "index/iterators.hpp"
 #include "utils/std.hpp"
 #include "utils/type_limits.hpp"
@@ -164,6 +165,27 @@ struct empty_score_buffer {
   }
 }; // empty_score_buffer
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads at most 'count' next documents of the specified iterator,
+///        calls to 'Iterator::next()' are resolved statically
+////////////////////////////////////////////////////////////////////////////////
+template<typename Iterator>
+size_t next_batch(Iterator& it, doc_id_t* docs, uint32_t* freqs, size_t count) {
+  static_assert(std::is_final_v<Iterator>);
+
+  size_t read = 0;
+  for (; read < count && it.Iterator::next(); ++read) {
+    docs[read] = it.Iterator::value();
+  }
+
+  if (freqs) {
+    // disjunction doesn't track frequencies
+    std::fill_n(freqs, read, 0);
+  }
+
+  return read;
+}
+
 } // detail
 
 template<typename Adapter>
@@ -195,6 +217,10 @@ class unary_disjunction final : public compound_doc_iterator<Adapter> {
     return it_->next();
   }
 
+  virtual size_t next_batch(doc_id_t* docs, uint32_t* freqs, size_t count) override {
+    return it_->next_batch(docs, freqs, count);
+  }
+
   virtual doc_id_t seek(doc_id_t target) override {
     return it_->seek(target);
   }
@@ -217,6 +243,7 @@ template<typename DocIterator,
          typename Adapter = score_iterator_adapter<DocIterator>>
 class basic_disjunction final
     : public compound_doc_iterator<Adapter>,
+      public memory::pooled_object<basic_disjunction<DocIterator, Adapter>>,
       private score_ctx {
  public:
   using adapter = Adapter;
@@ -409,6 +436,7 @@ class basic_disjunction final
 template<typename DocIterator, typename Adapter = score_iterator_adapter<DocIterator>>
 class small_disjunction final
     : public compound_doc_iterator<Adapter>,
+      public memory::pooled_object<small_disjunction<DocIterator, Adapter>>,
       private score_ctx {
  public:
   using adapter = Adapter;
@@ -438,6 +466,11 @@ class small_disjunction final
         resolve_overload_tag()) {
   }
 
+  ~small_disjunction() {
+    // keep the buffer of sub-iterators for the next query
+    memory::vector_pool<typename doc_iterators_t::value_type>::release(itrs_);
+  }
+
   virtual attribute* get_mutable(type_info::type_id type) noexcept override final {
     return irs::get_mutable(attrs_, type);
   }
@@ -489,6 +522,10 @@ class small_disjunction final
     return true;
   }
 
+  virtual size_t next_batch(doc_id_t* docs, uint32_t* freqs, size_t count) override {
+    return detail::next_batch(*this, docs, freqs, count);
+  }
+
   virtual doc_id_t seek(doc_id_t target) override {
     auto& doc = std::get<document>(attrs_);
 
@@ -672,6 +709,7 @@ class small_disjunction final
 template<typename DocIterator, typename Adapter = score_iterator_adapter<DocIterator>, bool EnableUnary = false>
 class disjunction final
     : public compound_doc_iterator<Adapter>,
+      public memory::pooled_object<disjunction<DocIterator, Adapter, EnableUnary>>,
       private score_ctx {
  public:
   using unary_disjunction_t = unary_disjunction<DocIterator, Adapter>;
@@ -710,6 +748,10 @@ class disjunction final
         resolve_overload_tag()) {
   }
 
+  ~disjunction() {
+    memory::vector_pool<typename doc_iterators_t::value_type>::release(itrs_);
+  }
+
   virtual attribute* get_mutable(type_info::type_id type) noexcept override final {
     return irs::get_mutable(attrs_, type);
   }
@@ -743,6 +785,10 @@ class disjunction final
     return true;
   }
 
+  virtual size_t next_batch(doc_id_t* docs, uint32_t* freqs, size_t count) override {
+    return detail::next_batch(*this, docs, freqs, count);
+  }
+
   virtual doc_id_t seek(doc_id_t target) override {
     auto& doc = std::get<document>(attrs_);
 
@@ -1055,6 +1101,10 @@ class block_disjunction final : public doc_iterator, private score_ctx {
     return match_count_;
   }
 
+  ~block_disjunction() {
+    memory::vector_pool<typename doc_iterators_t::value_type>::release(itrs_);
+  }
+
   virtual attribute* get_mutable(type_info::type_id type) noexcept override final {
     return irs::get_mutable(attrs_, type);
   }
@@ -1112,6 +1162,44 @@ class block_disjunction final : public doc_iterator, private score_ctx {
     return true;
   }
 
+  virtual size_t next_batch(doc_id_t* docs, uint32_t* freqs, size_t count) override {
+    if constexpr (traits_type::min_match() || traits_type::score()) {
+      // every document has to be checked against the match buffer
+      // or requires score to be set
+      return detail::next_batch(*this, docs, freqs, count);
+    } else {
+      auto& doc = std::get<document>(attrs_);
+      size_t read = 0;
+
+      while (read < count) {
+        if (!cur_) {
+          // fetch the next non-empty word, possibly refilling the buffer
+          if (!next()) {
+            break;
+          }
+
+          docs[read++] = doc.value;
+          continue;
+        }
+
+        // drain the current word
+        for (; cur_ && read < count; ++read) {
+          const size_t offset = std::countr_zero(cur_);
+          irs::unset_bit(cur_, offset);
+          docs[read] = doc_base_ + doc_id_t(offset);
+        }
+
+        doc.value = docs[read - 1];
+      }
+
+      if (freqs) {
+        std::fill_n(freqs, read, 0);
+      }
+
+      return read;
+    }
+  }
+
   virtual doc_id_t seek(doc_id_t target) override {
     auto& doc = std::get<document>(attrs_);
 
@@ -1444,6 +1532,253 @@ class block_disjunction final : public doc_iterator, private score_ctx {
   order::prepared::merger merger_;
 }; // block_disjunction
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class max_score_disjunction
+/// @brief disjunction implementing "MaxScore" dynamic pruning, sub-iterators
+///        are ordered by their score upper bounds and split into
+///        "non-essential" ones, which can't produce a competitive document on
+///        their own, and "essential" ones, which drive the iteration.
+///        Non-essential iterators are consulted only for the candidates
+///        produced by the essential ones and only while the candidate still
+///        may become competitive. Sub-iterators exposing 'impact' along with
+///        'score::upper_bounds::block' ("Block-Max MaxScore") allow to reject
+///        a candidate using the bounds of the blocks it falls into, i.e.
+///        without moving non-essential iterators.
+/// @note applicable for the orders consisting of a single bucket which
+///       aggregates 'float_t' scores, no pruning happens until the minimal
+///       competitive score is set via 'score::min(...)'
+/// ----------------------------------------------------------------------------
+///   [0]   <-- begin (the lowest upper bound)
+///   ...      | non-essential
+///   [e-1]    |
+///   [e]   <-- essential
+///   ...      | essential
+///   [n-1] <-- end (the highest upper bound)
+/// ----------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+template<typename DocIterator, typename Adapter = score_iterator_adapter<DocIterator>>
+class max_score_disjunction final : public doc_iterator, private score_ctx {
+ public:
+  using adapter = Adapter;
+  using doc_iterators_t = std::vector<adapter>;
+
+  max_score_disjunction(
+      doc_iterators_t&& itrs,
+      const order::prepared& ord)
+    : itrs_(std::move(itrs)) {
+    assert(itrs_.size() > 1);
+    assert(1 == ord.size() && !ord.begin()->score_offset);
+
+    // sort sub-iterators in ascending order by their score upper bounds
+    std::sort(itrs_.begin(), itrs_.end(),
+      [](const adapter& lhs, const adapter& rhs) noexcept {
+        return upper_bound(lhs) < upper_bound(rhs);
+    });
+
+    // bounds_[i] is an upper bound of the accumulated score of itrs_[0..i]
+    bounds_.reserve(itrs_.size());
+    double_t sum = 0.;
+    for (auto& it : itrs_) {
+      bounds_.emplace_back(sum += upper_bound(it));
+    }
+
+    // block-level bounds of the sub-iterators, if any
+    blocks_.reserve(itrs_.size());
+    for (auto& it : itrs_) {
+      auto* impact = it.score->bounds.block
+        ? irs::get_mutable<irs::impact>(it.it.get())
+        : nullptr;
+
+      has_blocks_ |= nullptr != impact;
+      blocks_.push_back({ impact, doc_limits::invalid(), upper_bound(it) });
+    }
+
+    std::get<cost>(attrs_).reset([this]() noexcept {
+      return std::accumulate(
+        itrs_.begin(), itrs_.end(), cost::cost_t(0),
+        [](cost::cost_t lhs, const adapter& rhs) {
+          return lhs + cost::extract(rhs, 0);
+      });
+    });
+
+    auto& score = std::get<irs::score>(attrs_);
+    score.realloc(ord);
+    score.bounds.tail = static_cast<float_t>(std::min(
+      bounds_.back(), double_t(std::numeric_limits<float_t>::max())));
+
+    // score is evaluated eagerly while converging
+    score.reset(this, [](score_ctx* ctx) -> const byte_type* {
+      auto& self = *static_cast<max_score_disjunction*>(ctx);
+      return std::get<irs::score>(self.attrs_).data();
+    });
+
+    score.reset_min(this, [](score_ctx* ctx, float_t threshold) noexcept {
+      static_cast<max_score_disjunction*>(ctx)->update_threshold(threshold);
+    });
+  }
+
+  ~max_score_disjunction() {
+    memory::vector_pool<typename doc_iterators_t::value_type>::release(itrs_);
+  }
+
+  virtual attribute* get_mutable(type_info::type_id type) noexcept override {
+    return irs::get_mutable(attrs_, type);
+  }
+
+  virtual doc_id_t value() const noexcept override {
+    return std::get<document>(attrs_).value;
+  }
+
+  virtual bool next() override {
+    auto& doc = std::get<document>(attrs_);
+
+    if (doc_limits::eof(doc.value)) {
+      return false;
+    }
+
+    return !doc_limits::eof(converge(doc.value + 1));
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    auto& doc = std::get<document>(attrs_);
+
+    if (target <= doc.value) {
+      return doc.value;
+    }
+
+    return converge(target);
+  }
+
+ private:
+  static float_t upper_bound(const adapter& it) noexcept {
+    assert(it.score); // must be ensured by the adapter
+    return it.score->is_default() ? 0.f : it.score->bounds.tail;
+  }
+
+  static float_t score_value(const adapter& it) {
+    assert(it.score); // must be ensured by the adapter
+    return it.score->is_default()
+      ? 0.f
+      : *reinterpret_cast<const float_t*>(it.score->evaluate());
+  }
+
+  // upper bound of the score of 'itrs_[i]' for the block containing 'target'
+  float_t block_bound(size_t i, doc_id_t target) {
+    auto& block = blocks_[i];
+
+    if (block.impact && target > block.max_doc) {
+      auto& it = itrs_[i];
+      block.max_doc = block.impact->shallow_seek(target);
+      block.bound = std::min(upper_bound(it),
+                             it.score->bounds.block(it.score->bounds.block_ctx,
+                                                    block.impact->max_freq));
+    }
+
+    return block.bound;
+  }
+
+  void update_threshold(float_t threshold) noexcept {
+    if (threshold <= threshold_) {
+      return;
+    }
+
+    threshold_ = threshold;
+
+    // find the first iterator capable of producing competitive documents
+    // together with all the iterators having lower upper bounds
+    essential_ = size_t(std::distance(
+      bounds_.begin(),
+      std::lower_bound(bounds_.begin() + essential_, bounds_.end(),
+                       double_t(threshold_))));
+  }
+
+  doc_id_t converge(doc_id_t target) {
+    auto& doc = std::get<document>(attrs_);
+    const auto essential_begin = itrs_.begin() + essential_;
+
+    for (;;) {
+      doc_id_t min = doc_limits::eof();
+
+      for (auto it = essential_begin, end = itrs_.end(); it != end; ++it) {
+        auto value = it->value();
+
+        if (value < target) {
+          value = (*it)->seek(target);
+        }
+
+        min = std::min(min, value);
+      }
+
+      if (doc_limits::eof(min)) {
+        // remaining iterators can't produce competitive documents
+        return doc.value = doc_limits::eof();
+      }
+
+      float_t score = 0.f;
+      for (auto it = essential_begin, end = itrs_.end(); it != end; ++it) {
+        if (it->value() == min) {
+          score += score_value(*it);
+        }
+      }
+
+      if (has_blocks_ && essential_ &&
+          double_t(score) + bounds_[essential_ - 1] >= threshold_) {
+        // check the candidate against the bounds of the blocks it falls into
+        // before moving non-essential iterators
+        double_t bound = score;
+        for (size_t i = 0; i < essential_; ++i) {
+          bound += block_bound(i, min);
+        }
+
+        if (bound < threshold_) {
+          target = min + 1;
+          continue;
+        }
+      }
+
+      // evaluate non-essential iterators starting from the highest bound
+      // while the candidate still may become competitive
+      size_t i = essential_;
+      for (; i && double_t(score) + bounds_[i - 1] >= threshold_; --i) {
+        auto& it = itrs_[i - 1];
+        auto value = it.value();
+
+        if (value < min) {
+          value = it->seek(min);
+        }
+
+        if (value == min) {
+          score += score_value(it);
+        }
+      }
+
+      if (!i && score >= threshold_) {
+        auto& score_attr = std::get<irs::score>(attrs_);
+        *reinterpret_cast<float_t*>(score_attr.data()) = score;
+        return doc.value = min;
+      }
+
+      target = min + 1;
+    }
+  }
+
+  struct block_state {
+    irs::impact* impact; // nullptr if block-level bounds aren't available
+    doc_id_t max_doc; // last document of the current block
+    float_t bound; // score upper bound of the current block
+  };
+
+  using attributes = std::tuple<document, cost, score>;
+
+  doc_iterators_t itrs_; // ascending order by score upper bound
+  std::vector<double_t> bounds_; // accumulated score upper bounds
+  std::vector<block_state> blocks_; // same order as 'itrs_'
+  bool has_blocks_{false}; // at least one iterator exposes 'impact'
+  size_t essential_{}; // index of the first essential iterator
+  float_t threshold_{std::numeric_limits<float_t>::lowest()};
+  attributes attrs_;
+}; // max_score_disjunction
+
 template<
   typename DocIterator,
   typename Adapter = score_iterator_adapter<DocIterator>>
@@ -1483,7 +1818,13 @@ template<typename Disjunction, typename... Args>
 doc_iterator::ptr make_disjunction(
     typename Disjunction::doc_iterators_t&& itrs,
     Args&&... args) {
+  using doc_iterators_t = typename Disjunction::doc_iterators_t;
+
   const auto size = itrs.size();
+  // recycle the buffer unless it's taken over by a disjunction
+  auto release = make_finally([&itrs]() noexcept {
+    memory::vector_pool<typename doc_iterators_t::value_type>::release(itrs);
+  });
 
   switch (size) {
     case 0:
@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "facet_collector.hpp"
+
+#include <algorithm>
+#include <span>
+
+#include "analysis/token_attributes.hpp"
+#include "formats/formats.hpp"
+#include "index/index_reader.hpp"
+
+namespace iresearch {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                   count_aggregator implementation
+// -----------------------------------------------------------------------------
+
+void count_aggregator::collect(const bytes_ref* values, size_t count) {
+  for (auto* end = values + count; values != end; ++values) {
+    count_ += !values->null();
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                    term_aggregator implementation
+// -----------------------------------------------------------------------------
+
+term_aggregator::entry& term_aggregator::find(bytes_ref value) {
+  const auto it = index_.find(make_hashed_ref(value));
+
+  if (it != index_.end()) {
+    return *it->second;
+  }
+
+  auto& entry = entries_.emplace_back();
+  entry.value.assign(value.c_str(), value.size());
+  index_.emplace(make_hashed_ref(bytes_ref(entry.value)), &entry);
+
+  return entry;
+}
+
+void term_aggregator::collect(const bytes_ref* values, size_t count) {
+  for (auto* end = values + count; values != end; ++values) {
+    const bytes_ref value = *values;
+
+    if (value.null()) {
+      continue;
+    }
+
+    if (!last_ || bytes_ref(last_->value) != value) {
+      last_ = &find(value);
+    }
+
+    ++last_->count;
+  }
+}
+
+uint64_t term_aggregator::count(bytes_ref value) const {
+  const auto it = index_.find(make_hashed_ref(value));
+  return it == index_.end() ? 0 : it->second->count;
+}
+
+std::vector<const term_aggregator::entry*> term_aggregator::top(
+    size_t limit) const {
+  std::vector<const entry*> top;
+  top.reserve(entries_.size());
+
+  for (auto& entry : entries_) {
+    top.emplace_back(&entry);
+  }
+
+  limit = std::min(limit, top.size());
+
+  std::partial_sort(
+    top.begin(), top.begin() + limit, top.end(),
+    [](const entry* lhs, const entry* rhs) noexcept {
+      if (lhs->count != rhs->count) {
+        return lhs->count > rhs->count;
+      }
+
+      return lhs->value < rhs->value;
+  });
+
+  top.resize(limit);
+
+  return top;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                    facet_collector implementation
+// -----------------------------------------------------------------------------
+
+void facet_collector::add(string_ref field, aggregator& aggr) {
+  facets_.emplace_back(facet{
+    static_cast<std::string>(field), &aggr, nullptr, nullptr, nullptr });
+}
+
+void facet_collector::collect(facet& facet, size_t count) {
+  if (facet.batch) {
+    (*facet.batch)(docs_, values_, count);
+    facet.aggr->collect(values_, count);
+    return;
+  }
+
+  // the iterator doesn't support batch reads, values are read one by one
+  auto& values = *facet.values;
+
+  for (const doc_id_t doc : std::span{docs_, count}) {
+    if (values.value() > doc || values.seek(doc) != doc) {
+      continue;
+    }
+
+    bytes_ref value = facet.value ? facet.value->value : bytes_ref::NIL;
+
+    if (value.null()) {
+      value = bytes_ref::EMPTY;
+    }
+
+    // a value is valid until the next 'seek(...)', aggregate it right away
+    facet.aggr->collect(&value, 1);
+  }
+}
+
+size_t facet_collector::collect(
+    const sub_reader& segment,
+    const filter::prepared& filter,
+    const attribute_provider* ctx) {
+  auto docs = segment.mask(
+    filter.execute(segment, order::prepared::unordered(), ctx));
+
+  if (!docs) {
+    return 0;
+  }
+
+  for (auto& facet : facets_) {
+    const auto* column = segment.column(facet.field);
+
+    facet.values = column ? column->iterator(false) : nullptr;
+    facet.batch = nullptr;
+    facet.value = nullptr;
+
+    if (facet.values) {
+      facet.batch = irs::get<column_batch>(*facet.values);
+      facet.value = irs::get<payload>(*facet.values);
+    }
+  }
+
+  size_t matched = 0;
+
+  for (;;) {
+    const size_t count = docs->next_batch(docs_, nullptr, kBlockSize);
+    matched += count;
+
+    for (auto& facet : facets_) {
+      if (facet.values && count) {
+        collect(facet, count);
+      }
+    }
+
+    if (count < kBlockSize) {
+      break;
+    }
+  }
+
+  for (auto& facet : facets_) {
+    facet.values.reset();
+  }
+
+  return matched;
+}
+
+size_t facet_collector::collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    const attribute_provider* ctx) {
+  size_t matched = 0;
+
+  for (auto& segment : index) {
+    matched += collect(segment, filter, ctx);
+  }
+
+  return matched;
+}
+
+} // ROOT
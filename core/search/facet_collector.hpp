@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_FACET_COLLECTOR_H
+#define IRESEARCH_FACET_COLLECTOR_H
+
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "filter.hpp"
+#include "utils/hash_utils.hpp"
+#include "utils/noncopyable.hpp"
+#include "utils/numeric_utils.hpp"
+#include "utils/string.hpp"
+
+namespace iresearch {
+
+struct column_batch;
+struct index_reader;
+struct payload;
+struct sub_reader;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class aggregator
+/// @brief accumulates values of a column for blocks of matched documents
+////////////////////////////////////////////////////////////////////////////////
+class aggregator {
+ public:
+  virtual ~aggregator() = default;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief accumulates values of 'count' matched documents
+  /// @note 'bytes_ref::NIL' denotes a document without a value, documents of
+  ///       a column without data (e.g. a mask) have empty values
+  //////////////////////////////////////////////////////////////////////////////
+  virtual void collect(const bytes_ref* values, size_t count) = 0;
+}; // aggregator
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class count_aggregator
+/// @brief counts matched documents having a value
+////////////////////////////////////////////////////////////////////////////////
+class count_aggregator final : public aggregator {
+ public:
+  virtual void collect(const bytes_ref* values, size_t count) override;
+
+  uint64_t count() const noexcept { return count_; }
+
+ private:
+  uint64_t count_{};
+}; // count_aggregator
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class term_aggregator
+/// @brief counts matched documents per distinct value
+/// @note subsequent equal values are counted without a hash lookup, which
+///       makes low cardinality columns cheap to aggregate
+////////////////////////////////////////////////////////////////////////////////
+class term_aggregator final : public aggregator {
+ public:
+  struct entry {
+    bstring value;
+    uint64_t count{};
+  }; // entry
+
+  virtual void collect(const bytes_ref* values, size_t count) override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns aggregated values in order of their first appearance
+  //////////////////////////////////////////////////////////////////////////////
+  const std::deque<entry>& values() const noexcept { return entries_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns number of matched documents with the specified value
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t count(bytes_ref value) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns at most 'limit' most frequent values, ties are resolved by
+  ///          the order of values
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<const entry*> top(size_t limit) const;
+
+ private:
+  entry& find(bytes_ref value);
+
+  // keys point to values of 'entries_'
+  absl::flat_hash_map<hashed_bytes_ref, entry*> index_;
+  std::deque<entry> entries_; // deque keeps values in place
+  entry* last_{}; // entry of the most recently collected value
+}; // term_aggregator
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class numeric_aggregator
+/// @brief computes min/max/sum of numeric values encoded via
+///        'numeric_utils::numeric_traits<T>::encode(...)'
+/// @note values of a different size are not taken into account
+////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class numeric_aggregator final : public aggregator {
+ public:
+  using traits_t = numeric_utils::numeric_traits<T>;
+  using value_t = decltype(traits_t::decode(nullptr));
+  using sum_t = std::conditional_t<
+    std::is_floating_point_v<value_t>, double_t, int64_t>;
+
+  virtual void collect(const bytes_ref* values, size_t count) override {
+    for (auto* end = values + count; values != end; ++values) {
+      if (values->size() != traits_t::size()) {
+        continue;
+      }
+
+      const value_t value = traits_t::decode(values->c_str());
+      min_ = std::min(min_, value);
+      max_ = std::max(max_, value);
+      sum_ += value;
+      ++count_;
+    }
+  }
+
+  // min/max are meaningless unless 'count()' > 0
+  value_t min() const noexcept { return min_; }
+  value_t max() const noexcept { return max_; }
+  sum_t sum() const noexcept { return sum_; }
+  uint64_t count() const noexcept { return count_; }
+
+ private:
+  value_t min_{std::numeric_limits<value_t>::max()};
+  value_t max_{std::numeric_limits<value_t>::lowest()};
+  sum_t sum_{};
+  uint64_t count_{};
+}; // numeric_aggregator
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class histogram_aggregator
+/// @brief counts numeric values encoded via
+///        'numeric_utils::numeric_traits<T>::encode(...)' per bucket, a bucket
+///        'i' covers [origin + i*interval, origin + (i+1)*interval)
+/// @note values of a different size are not taken into account
+////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class histogram_aggregator final : public aggregator {
+ public:
+  using traits_t = numeric_utils::numeric_traits<T>;
+  using value_t = decltype(traits_t::decode(nullptr));
+
+  histogram_aggregator(value_t origin, value_t interval, size_t buckets)
+    : buckets_(buckets, 0),
+      origin_{origin},
+      interval_{interval} {
+    assert(interval > 0);
+  }
+
+  virtual void collect(const bytes_ref* values, size_t count) override {
+    for (auto* end = values + count; values != end; ++values) {
+      if (values->size() != traits_t::size()) {
+        continue;
+      }
+
+      const value_t value = traits_t::decode(values->c_str());
+
+      if (value < origin_) {
+        ++outside_;
+        continue;
+      }
+
+      const auto bucket = static_cast<size_t>((value - origin_) / interval_);
+
+      if (bucket < buckets_.size()) {
+        ++buckets_[bucket];
+      } else {
+        ++outside_;
+      }
+    }
+  }
+
+  const std::vector<uint64_t>& buckets() const noexcept { return buckets_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns number of values not covered by the buckets
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t outside() const noexcept { return outside_; }
+
+ private:
+  std::vector<uint64_t> buckets_;
+  value_t origin_;
+  value_t interval_;
+  uint64_t outside_{};
+}; // histogram_aggregator
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class facet_collector
+/// @brief feeds values of columns for the documents matched by a prepared
+///        filter to the registered aggregators, documents are fetched via
+///        'doc_iterator::next_batch(...)', values are read via the
+///        'column_batch' attribute of column iterators if available, i.e.
+///        without per document 'seek(...)' calls
+////////////////////////////////////////////////////////////////////////////////
+class facet_collector : private util::noncopyable {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief registers 'aggr' over the values of the column 'field'
+  /// @note 'aggr' must outlive the collector
+  //////////////////////////////////////////////////////////////////////////////
+  void add(string_ref field, aggregator& aggr);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief executes 'filter' against every segment of the specified 'index'
+  /// @returns number of matched documents
+  //////////////////////////////////////////////////////////////////////////////
+  size_t collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    const attribute_provider* ctx = nullptr);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief executes 'filter' against the specified 'segment'
+  /// @returns number of matched documents
+  //////////////////////////////////////////////////////////////////////////////
+  size_t collect(
+    const sub_reader& segment,
+    const filter::prepared& filter,
+    const attribute_provider* ctx = nullptr);
+
+  size_t size() const noexcept { return facets_.size(); }
+  bool empty() const noexcept { return facets_.empty(); }
+
+ private:
+  static constexpr size_t kBlockSize = 128;
+
+  struct facet {
+    std::string field;
+    aggregator* aggr;
+    doc_iterator::ptr values; // column iterator of the current segment
+    const column_batch* batch;
+    const payload* value;
+  }; // facet
+
+  void collect(facet& facet, size_t count);
+
+  std::vector<facet> facets_;
+  doc_id_t docs_[kBlockSize];
+  bytes_ref values_[kBlockSize];
+}; // facet_collector
+
+} // ROOT
+
+#endif // IRESEARCH_FACET_COLLECTOR_H
@@ -21,6 +21,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "filter.hpp"
+
+#include "index/index_reader.hpp"
+#include "search/cost.hpp"
 #include "utils/singleton.hpp"
 
 namespace {
@@ -39,6 +42,10 @@ struct empty_query final
       const irs::attribute_provider*) const override {
     return irs::doc_iterator::empty();
   }
+
+  virtual doc_count count(const irs::sub_reader&, uint64_t) const override {
+    return { 0, true };
+  }
 }; // empty_query
 
 } // LOCAL
@@ -57,6 +64,54 @@ filter::prepared::ptr filter::prepared::empty() {
   return memory::to_managed<filter::prepared, false>(&empty_query::instance());
 }
 
+filter::prepared::doc_count filter::prepared::count(
+    const sub_reader& segment,
+    uint64_t limit) const {
+  auto it = segment.mask(execute(segment));
+  assert(it);
+
+  uint64_t count = 0;
+  for (; count < limit; ++count) {
+    if (!it->next()) {
+      return { count, true };
+    }
+  }
+
+  if (!it->next()) {
+    return { count, true };
+  }
+
+  // extrapolate number of documents matched within the evaluated
+  // part of a segment, the last evaluated document is excluded
+  const uint64_t evaluated = it->value() - doc_limits::min();
+  assert(evaluated >= count);
+  // nothing to extrapolate from if the very first document of a segment
+  // matches and isn't evaluated (e.g. 'limit == 0')
+  auto estimate = evaluated
+    ? static_cast<uint64_t>(
+        static_cast<double_t>(count) * segment.docs_count() / evaluated)
+    : segment.docs_count();
+
+  // cost is an upper bound for most of the iterators
+  if (const auto* cost = irs::get<irs::cost>(*it); cost) {
+    estimate = std::min(estimate, std::max(cost->estimate(), count + 1));
+  }
+
+  return { std::max(estimate, count + 1), false };
+}
+
+filter::prepared::doc_count filter::prepared::count(
+    const index_reader& index,
+    uint64_t limit) const {
+  doc_count count;
+
+  for (auto& segment : index) {
+    count += this->count(segment, limit);
+  }
+
+  return count;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                             empty
 // -----------------------------------------------------------------------------
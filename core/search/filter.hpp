@@ -50,6 +50,25 @@ class filter {
    public:
     using ptr = memory::managed_ptr<const prepared>;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @struct doc_count
+    /// @brief number of live documents matched by a query
+    ////////////////////////////////////////////////////////////////////////////
+    struct doc_count {
+      uint64_t value{};
+      bool exact{true}; // 'value' is an estimate otherwise
+
+      doc_count& operator+=(const doc_count& rhs) noexcept {
+        value += rhs.value;
+        exact &= rhs.exact;
+        return *this;
+      }
+    };
+
+    // default number of matched documents to evaluate per segment
+    // while counting before falling back to an estimate
+    static constexpr uint64_t kDefaultCountLimit = 1 << 14;
+
     static prepared::ptr empty();
 
     explicit prepared(boost_t boost = no_boost()) noexcept
@@ -73,6 +92,22 @@ class filter {
       const order::prepared& ord,
       const attribute_provider* ctx) const = 0;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @returns number of live documents matched in a specified segment,
+    ///          the default implementation evaluates at most 'limit' matched
+    ///          documents and extrapolates the result over the whole segment,
+    ///          queries override it where an exact count is cheaply derivable
+    ////////////////////////////////////////////////////////////////////////////
+    virtual doc_count count(const sub_reader& segment, uint64_t limit) const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @returns number of live documents matched in a specified index,
+    ///          see 'count(const sub_reader&, uint64_t)'
+    ////////////////////////////////////////////////////////////////////////////
+    doc_count count(
+      const index_reader& index,
+      uint64_t limit = kDefaultCountLimit) const;
+
     boost_t boost() const noexcept { return boost_; }
 
    protected:
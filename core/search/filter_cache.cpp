@@ -0,0 +1,452 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "filter_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "cost.hpp"
+#include "bitset_doc_iterator.hpp"
+#include "index/segment_reader.hpp"
+#include "utils/bitset.hpp"
+#include "utils/hash_utils.hpp"
+
+namespace iresearch {
+
+/// Immutable set of documents matched by a filter in a segment.
+/// Stored either as a bitset or as a sorted list of ids, whichever is smaller.
+class cached_doc_set : private util::noncopyable {
+ public:
+  using ptr = std::shared_ptr<const cached_doc_set>;
+
+  static ptr make(doc_iterator& docs, uint64_t docs_count) {
+    constexpr size_t kBatchSize = 512;
+
+    std::vector<doc_id_t> ids;
+    for (size_t read = kBatchSize; read == kBatchSize;) {
+      const size_t size = ids.size();
+      ids.resize(size + kBatchSize);
+      read = docs.next_batch(ids.data() + size, nullptr, kBatchSize);
+      ids.resize(size + read);
+    }
+
+    const size_t bits = docs_count + doc_limits::min();
+
+    if (bitset::bits_to_words(bits) * sizeof(bitset::word_t) <
+        ids.size() * sizeof(doc_id_t)) {
+      bitset set(bits);
+      for (const auto id : ids) {
+        set.set(id);
+      }
+
+      return std::make_shared<cached_doc_set>(std::move(set), ids.size());
+    }
+
+    ids.shrink_to_fit();
+    return std::make_shared<cached_doc_set>(std::move(ids));
+  }
+
+  explicit cached_doc_set(std::vector<doc_id_t>&& ids) noexcept
+      : ids_(std::move(ids)), size_(ids_.size()) {}
+
+  cached_doc_set(bitset&& set, size_t size) noexcept
+      : set_(std::move(set)), size_(size) {}
+
+  bool dense() const noexcept { return 0 != set_.words(); }
+  const bitset& set() const noexcept { return set_; }
+  const std::vector<doc_id_t>& ids() const noexcept { return ids_; }
+
+  size_t size() const noexcept { return size_; }
+
+  size_t bytes() const noexcept {
+    return sizeof(*this) + set_.words() * sizeof(bitset::word_t) +
+           ids_.capacity() * sizeof(doc_id_t);
+  }
+
+ private:
+  bitset set_;
+  std::vector<doc_id_t> ids_;
+  size_t size_;
+}; // cached_doc_set
+
+} // ROOT
+
+namespace {
+
+using namespace irs;
+
+/// Iterator over a sparse cached document set.
+class sparse_doc_iterator final : public doc_iterator,
+                                  private util::noncopyable {
+ public:
+  explicit sparse_doc_iterator(cached_doc_set::ptr&& docs) noexcept
+      : docs_(std::move(docs)),
+        next_(docs_->ids().data()),
+        end_(next_ + docs_->ids().size()),
+        cost_(docs_->size()) {
+    assert(!docs_->dense());
+  }
+
+  virtual bool next() noexcept override {
+    if (next_ == end_) {
+      doc_.value = doc_limits::eof();
+      return false;
+    }
+
+    doc_.value = *next_++;
+    return true;
+  }
+
+  virtual doc_id_t seek(doc_id_t target) noexcept override {
+    if (target <= doc_.value) {
+      return doc_.value;
+    }
+
+    next_ = std::lower_bound(next_, end_, target);
+    next();
+    return doc_.value;
+  }
+
+  virtual size_t next_batch(
+      doc_id_t* docs,
+      uint32_t* freqs,
+      size_t count) noexcept override {
+    const size_t read = std::min(count, size_t(end_ - next_));
+    std::memcpy(docs, next_, read * sizeof(doc_id_t));
+    next_ += read;
+
+    if (read < count) {
+      doc_.value = doc_limits::eof();
+    } else if (read) {
+      doc_.value = next_[-1];
+    }
+
+    if (freqs) {
+      std::fill_n(freqs, read, 0);
+    }
+
+    return read;
+  }
+
+  virtual doc_id_t value() const noexcept override { return doc_.value; }
+
+  virtual attribute* get_mutable(type_info::type_id id) noexcept override {
+    if (type<document>::id() == id) {
+      return &doc_;
+    }
+    return type<cost>::id() == id ? &cost_ : nullptr;
+  }
+
+ private:
+  cached_doc_set::ptr docs_;
+  const doc_id_t* next_;
+  const doc_id_t* end_;
+  cost cost_;
+  document doc_;
+}; // sparse_doc_iterator
+
+doc_iterator::ptr make_iterator(cached_doc_set::ptr&& docs) {
+  if (docs->dense()) {
+    // the set is kept alive along with its owner
+    const auto& set = docs->set();
+    const auto count = docs->size();
+    return memory::make_managed<shared_bitset_doc_iterator>(
+      std::shared_ptr<const bitset>(std::move(docs), &set), count);
+  }
+
+  return memory::make_managed<sparse_doc_iterator>(std::move(docs));
+}
+
+/// @returns shared instance of the segment data, nullptr if a segment isn't
+///          opened via 'segment_reader' and therefore can't be cached
+sub_reader::ptr segment_owner(const sub_reader& segment) {
+  const auto* reader = dynamic_cast<const segment_reader*>(&segment);
+
+  return reader ? sub_reader::ptr(*reader) : nullptr;
+}
+
+/// @returns true if 'entry' and 'owner' refer to the same segment instance
+bool same_segment(const std::weak_ptr<const sub_reader>& entry,
+                  const sub_reader::ptr& owner) noexcept {
+  return !entry.owner_before(owner) && !owner.owner_before(entry);
+}
+
+class cached_query final : public filter::prepared {
+ public:
+  cached_query(std::shared_ptr<const filter> filter, filter_cache& cache,
+               const index_reader& reader, const attribute_provider* ctx)
+      : filter_(std::move(filter)), cache_(&cache),
+        reader_(&reader), ctx_(ctx) {
+    assert(filter_);
+  }
+
+  virtual doc_iterator::ptr execute(
+      const sub_reader& segment,
+      const order::prepared&,
+      const attribute_provider* ctx) const override {
+    if (auto docs = cache_->get(*filter_, segment); docs) {
+      return docs;
+    }
+
+    // like results of any other query cached ones aren't masked,
+    // deleted documents are skipped by the caller
+    return cache_->put(filter_, segment, real_query().execute(
+      segment, order::prepared::unordered(), ctx));
+  }
+
+ private:
+  // real filter is prepared only if there is a segment without cached result
+  const filter::prepared& real_query() const {
+    std::call_once(prepared_once_, [this]() {
+      prepared_ = filter_->prepare(*reader_, order::prepared::unordered(),
+                                   irs::no_boost(), ctx_);
+    });
+
+    assert(prepared_);
+    return *prepared_;
+  }
+
+  std::shared_ptr<const filter> filter_;
+  filter_cache* cache_;
+  const index_reader* reader_;
+  const attribute_provider* ctx_;
+  mutable std::once_flag prepared_once_;
+  mutable filter::prepared::ptr prepared_;
+}; // cached_query
+
+} // LOCAL
+
+namespace iresearch {
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                     filter_cache
+// ----------------------------------------------------------------------------
+
+/*static*/ filter_cache& filter_cache::instance() {
+  static filter_cache cache;
+  return cache;
+}
+
+filter_cache::filter_cache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+filter_cache::~filter_cache() = default;
+
+doc_iterator::ptr filter_cache::get(const filter& filter,
+                                    const sub_reader& segment) {
+  const auto owner = segment_owner(segment);
+
+  if (!owner) {
+    return nullptr;
+  }
+
+  cached_doc_set::ptr docs;
+
+  {
+    const key id{&filter, owner.get(),
+                 hash_combine(filter.hash(), owner.get())};
+
+    std::lock_guard lock{mutex_};
+
+    const auto it = map_.find(id);
+
+    if (it == map_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+
+    const auto entry = it->second;
+
+    if (!same_segment(entry->segment, owner)) {
+      // stale entry of a released segment which had the same address
+      erase(entry);
+      ++misses_;
+      return nullptr;
+    }
+
+    // mark entry as the most recently used one
+    entries_.splice(entries_.begin(), entries_, entry);
+    ++hits_;
+    docs = entry->docs;
+  }
+
+  return make_iterator(std::move(docs));
+}
+
+doc_iterator::ptr filter_cache::put(std::shared_ptr<const filter> filter,
+                                    const sub_reader& segment,
+                                    doc_iterator::ptr&& docs) {
+  assert(filter);
+  assert(docs);
+
+  const auto owner = segment_owner(segment);
+
+  if (!owner) {
+    return std::move(docs);
+  }
+
+  auto set = cached_doc_set::make(*docs, segment.docs_count());
+  const size_t bytes = sizeof(entry) + set->bytes();
+
+  {
+    const key id{filter.get(), owner.get(),
+                 hash_combine(filter->hash(), owner.get())};
+
+    std::lock_guard lock{mutex_};
+
+    if (bytes <= max_bytes_) {
+      if (const auto it = map_.find(id); it != map_.end()) {
+        // concurrently evaluated or stale entry
+        erase(it->second);
+      }
+
+      evict(max_bytes_ - bytes);
+
+      entries_.emplace_front(
+          entry{id, std::move(filter), owner, set, bytes});
+      map_.emplace(id, entries_.begin());
+      bytes_ += bytes;
+    }
+  }
+
+  return make_iterator(std::move(set));
+}
+
+void filter_cache::erase(entries::iterator it) {
+  map_.erase(it->id);
+  assert(bytes_ >= it->bytes);
+  bytes_ -= it->bytes;
+  entries_.erase(it);
+}
+
+void filter_cache::evict(size_t max_bytes) {
+  if (bytes_ <= max_bytes) {
+    return;
+  }
+
+  // entries of released segments go first
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->segment.expired()) {
+      erase(it++);
+    } else {
+      ++it;
+    }
+  }
+
+  // then least recently used ones
+  while (bytes_ > max_bytes) {
+    assert(!entries_.empty());
+    erase(std::prev(entries_.end()));
+  }
+}
+
+void filter_cache::purge() {
+  std::lock_guard lock{mutex_};
+
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->segment.expired()) {
+      erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void filter_cache::clear() {
+  std::lock_guard lock{mutex_};
+  map_.clear();
+  entries_.clear();
+  bytes_ = 0;
+}
+
+void filter_cache::max_bytes(size_t max_bytes) {
+  std::lock_guard lock{mutex_};
+  max_bytes_ = max_bytes;
+  evict(max_bytes_);
+}
+
+size_t filter_cache::max_bytes() const noexcept {
+  std::lock_guard lock{mutex_};
+  return max_bytes_;
+}
+
+size_t filter_cache::bytes() const noexcept {
+  std::lock_guard lock{mutex_};
+  return bytes_;
+}
+
+size_t filter_cache::size() const noexcept {
+  std::lock_guard lock{mutex_};
+  return entries_.size();
+}
+
+uint64_t filter_cache::hits() const noexcept {
+  std::lock_guard lock{mutex_};
+  return hits_;
+}
+
+uint64_t filter_cache::misses() const noexcept {
+  std::lock_guard lock{mutex_};
+  return misses_;
+}
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                    cached_filter
+// ----------------------------------------------------------------------------
+
+DEFINE_FACTORY_DEFAULT(cached_filter);
+
+cached_filter::cached_filter() noexcept
+    : filter(irs::type<cached_filter>::get()),
+      cache_(&filter_cache::instance()) {}
+
+filter::prepared::ptr cached_filter::prepare(
+    const index_reader& rdr, const order::prepared& ord, boost_t boost,
+    const attribute_provider* ctx) const {
+  if (!filter_) {
+    return filter::prepared::empty();
+  }
+
+  if (!ord.empty()) {
+    // scores aren't cached
+    return filter_->prepare(rdr, ord, boost * this->boost(), ctx);
+  }
+
+  return memory::make_managed<cached_query>(filter_, *cache_, rdr, ctx);
+}
+
+size_t cached_filter::hash() const noexcept {
+  return filter_ ? hash_combine(filter::hash(), filter_->hash())
+                 : filter::hash();
+}
+
+bool cached_filter::equals(const filter& rhs) const noexcept {
+  if (!filter::equals(rhs)) {
+    return false;
+  }
+
+  const auto& other = static_cast<const cached_filter&>(rhs).filter_;
+
+  return filter_ && other ? *filter_ == *other : filter_ == other;
+}
+
+} // ROOT
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "filter.hpp"
+#include "utils/noncopyable.hpp"
+
+namespace iresearch {
+
+class cached_doc_set;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief memory-bounded cache of unscored filter results per segment.
+/// Entries are keyed by a filter (compared via 'hash()' and 'operator==')
+/// and a segment, documents are stored either as a bitset or as a sorted
+/// list of ids depending on the density of a result. Least recently used
+/// entries are evicted once the byte budget is exceeded.
+/// Only segments opened via 'segment_reader' (e.g. the ones provided by
+/// 'directory_reader') are cached. An entry is invalidated as soon as the
+/// corresponding segment is released, e.g. dropped by a reopened reader.
+/// @note the implementation is thread-safe
+//////////////////////////////////////////////////////////////////////////////
+class filter_cache : private util::noncopyable {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 64 * (size_t(1) << 20);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns process-wide cache instance
+  //////////////////////////////////////////////////////////////////////////////
+  static filter_cache& instance();
+
+  explicit filter_cache(size_t max_bytes = kDefaultMaxBytes);
+  ~filter_cache();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns iterator over cached documents of 'filter' in 'segment' or
+  ///          nullptr if there is no valid entry
+  //////////////////////////////////////////////////////////////////////////////
+  doc_iterator::ptr get(const filter& filter, const sub_reader& segment);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief exhausts 'docs' and caches the result for 'filter' in 'segment'
+  /// @returns iterator over the cached documents, 'docs' itself if the
+  ///          segment can't be cached
+  //////////////////////////////////////////////////////////////////////////////
+  doc_iterator::ptr put(std::shared_ptr<const filter> filter,
+                        const sub_reader& segment,
+                        doc_iterator::ptr&& docs);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes entries of already released segments
+  //////////////////////////////////////////////////////////////////////////////
+  void purge();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes all entries
+  //////////////////////////////////////////////////////////////////////////////
+  void clear();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sets the byte budget, evicts entries if necessary
+  //////////////////////////////////////////////////////////////////////////////
+  void max_bytes(size_t max_bytes);
+  size_t max_bytes() const noexcept;
+
+  size_t bytes() const noexcept;
+  size_t size() const noexcept;
+  uint64_t hits() const noexcept;
+  uint64_t misses() const noexcept;
+
+ private:
+  struct key {
+    const filter* query;
+    const sub_reader* segment;
+    size_t hash;
+  };
+
+  struct key_hash {
+    size_t operator()(const key& value) const noexcept { return value.hash; }
+  };
+
+  struct key_equal {
+    bool operator()(const key& lhs, const key& rhs) const noexcept {
+      return lhs.segment == rhs.segment && *lhs.query == *rhs.query;
+    }
+  };
+
+  struct entry {
+    key id;
+    std::shared_ptr<const filter> query; // owns the filter referenced by 'id'
+    std::weak_ptr<const sub_reader> segment; // expires with the segment
+    std::shared_ptr<const cached_doc_set> docs;
+    size_t bytes;
+  };
+
+  using entries = std::list<entry>;
+  using entries_map = absl::flat_hash_map<
+    key, entries::iterator, key_hash, key_equal>;
+
+  void erase(entries::iterator it);
+  void evict(size_t max_bytes);
+
+  mutable std::mutex mutex_;
+  entries entries_; // most recently used entry goes first
+  entries_map map_;
+  size_t max_bytes_;
+  size_t bytes_{};
+  uint64_t hits_{};
+  uint64_t misses_{};
+}; // filter_cache
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief filter caching unscored results of underlying real filter in
+/// a 'filter_cache', i.e. results are shared by all equal filters executed
+/// against the same segment.
+/// Underlying filter must not be changed once the filter has been prepared
+/// and must not depend on the execution context.
+/// Scoring cache is not supported, scored queries bypass the cache.
+//////////////////////////////////////////////////////////////////////////////
+class cached_filter final : public filter {
+ public:
+  static ptr make();
+
+  cached_filter() noexcept;
+
+  using filter::prepare;
+
+  virtual filter::prepared::ptr prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_provider* ctx) const override;
+
+  template<typename T>
+  T& set_filter() {
+    using type = typename std::enable_if_t<std::is_base_of_v<filter, T>, T>;
+    auto ptr = type::make();
+    auto& ref = static_cast<type&>(*ptr);
+    filter_ = std::move(ptr);
+    return ref;
+  }
+
+  const filter* get_filter() const noexcept { return filter_.get(); }
+
+  cached_filter& set_cache(filter_cache& cache) noexcept {
+    cache_ = &cache;
+    return *this;
+  }
+
+  virtual size_t hash() const noexcept override;
+
+ protected:
+  virtual bool equals(const filter& rhs) const noexcept override;
+
+ private:
+  std::shared_ptr<const filter> filter_;
+  filter_cache* cache_;
+}; // cached_filter
+
+} // ROOT
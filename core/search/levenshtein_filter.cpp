@@ -30,6 +30,7 @@
 #include "search/filter_visitor.hpp"
 #include "search/multiterm_query.hpp"
 #include "index/index_reader.hpp"
+#include "utils/automaton_cache.hpp"
 #include "utils/automaton_utils.hpp"
 #include "utils/levenshtein_utils.hpp"
 #include "utils/levenshtein_default_pdp.hpp"
@@ -183,14 +184,16 @@ bool collect_terms(
     bytes_ref prefix,
     bytes_ref term,
     const parametric_description& d,
+    bool with_transpositions,
     Collector& collector) {
-  const auto acceptor = make_levenshtein_automaton(d, prefix, term);
+  const auto acceptor = automaton_cache::instance().levenshtein(
+    d, with_transpositions, prefix, term);
 
-  if (!validate(acceptor)) {
+  if (!validate(*acceptor, false)) {
     return false;
   }
 
-  auto matcher = make_automaton_matcher(acceptor);
+  auto matcher = make_automaton_matcher(*acceptor, false);
   const uint32_t utf8_term_size = std::max(1U, uint32_t(utf8_utils::utf8_length(prefix)) +
                                                uint32_t(utf8_utils::utf8_length(term)));
   const byte_type max_distance = d.max_distance() + 1;
@@ -216,7 +219,8 @@ filter::prepared::ptr prepare_levenshtein_filter(
     bytes_ref prefix,
     bytes_ref term,
     size_t terms_limit,
-    const parametric_description& d) {
+    const parametric_description& d,
+    bool with_transpositions) {
   field_collectors field_stats(order);
   term_collectors term_stats(order, 1);
   multiterm_query::states_t states(index);
@@ -225,13 +229,15 @@ filter::prepared::ptr prepare_levenshtein_filter(
     all_terms_collector<decltype(states)> term_collector(states, field_stats, term_stats);
     term_collector.stat_index(0); // aggregate stats from different terms
 
-    if (!collect_terms(index, field, prefix, term, d, term_collector)) {
+    if (!collect_terms(index, field, prefix, term, d,
+                       with_transpositions, term_collector)) {
       return filter::prepared::empty();
     }
   } else {
     top_terms_collector term_collector(terms_limit, field_stats);
 
-    if (!collect_terms(index, field, prefix, term, d, term_collector)) {
+    if (!collect_terms(index, field, prefix, term, d,
+                       with_transpositions, term_collector)) {
       return filter::prepared::empty();
     }
 
@@ -277,24 +283,28 @@ DEFINE_FACTORY_DEFAULT(by_edit_distance) // cppcheck-suppress unknownMacro
         return by_term::visit(segment, field, target, visitor);
       };
     },
-    [](const parametric_description& d,
-            const bytes_ref prefix,
-            const bytes_ref term) -> field_visitor {
+    [with_transpositions = opts.with_transpositions](
+        const parametric_description& d,
+        const bytes_ref prefix,
+        const bytes_ref term) -> field_visitor {
       struct automaton_context : util::noncopyable {
         automaton_context(const parametric_description& d,
+                          bool with_transpositions,
                           bytes_ref prefix,
                           bytes_ref term)
-          : acceptor(make_levenshtein_automaton(d, prefix, term)),
-            matcher(make_automaton_matcher(acceptor)) {
+          : acceptor(automaton_cache::instance().levenshtein(
+              d, with_transpositions, prefix, term)),
+            matcher(make_automaton_matcher(*acceptor, false)) {
         }
 
-        automaton acceptor;
+        automaton_cache::automaton_ptr acceptor;
         automaton_table_matcher matcher;
       };
 
-      auto ctx = memory::make_shared<automaton_context>(d, prefix, term);
+      auto ctx = memory::make_shared<automaton_context>(
+        d, with_transpositions, prefix, term);
 
-      if (!validate(ctx->acceptor)) {
+      if (!validate(*ctx->acceptor, false)) {
         return [](const sub_reader&, const term_reader&, filter_visitor&){};
       }
 
@@ -341,11 +351,12 @@ DEFINE_FACTORY_DEFAULT(by_edit_distance) // cppcheck-suppress unknownMacro
 
       return by_term::prepare(index, order, boost, field, prefix.empty() ? term : prefix);
     },
-    [&field, scored_terms_limit, &index, &order, boost](
+    [&field, scored_terms_limit, &index, &order, boost, with_transpositions](
         const parametric_description& d,
         const bytes_ref prefix,
         const bytes_ref term) -> filter::prepared::ptr {
-      return prepare_levenshtein_filter(index, order, boost, field, prefix, term, scored_terms_limit, d);
+      return prepare_levenshtein_filter(index, order, boost, field, prefix, term,
+                                        scored_terms_limit, d, with_transpositions);
     }
   );
 }
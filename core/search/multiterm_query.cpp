@@ -31,6 +31,17 @@ namespace {
 
 using namespace irs;
 
+// excludes deleted documents from a bitset of 'words' words
+void mask(const sub_reader& segment, bitset::word_t* set, size_t words) noexcept {
+  if (const auto* live_docs = segment.live_docs(); live_docs) {
+    assert(live_docs->words() == words);
+    const auto* live = live_docs->begin();
+    for (auto* end = set + std::min(words, live_docs->words()); set != end;) {
+      *set++ &= *live++;
+    }
+  }
+}
+
 class lazy_bitset_iterator final : public bitset_doc_iterator {
  public:
   lazy_bitset_iterator(
@@ -131,8 +142,10 @@ doc_iterator::ptr multiterm_query::execute(
 
   const bool has_unscored_terms = !state->unscored_terms.empty();
 
-  disjunction_t::doc_iterators_t itrs(
-    state->scored_states.size() + size_t(has_unscored_terms));
+  const size_t size = state->scored_states.size() + size_t(has_unscored_terms);
+  auto itrs = memory::vector_pool<
+    disjunction_t::doc_iterators_t::value_type>::make(size);
+  itrs.resize(size);
   auto it = itrs.begin();
 
   // add an iterator for each of the scored states
@@ -189,4 +202,38 @@ doc_iterator::ptr multiterm_query::execute(
     state->estimation());
 }
 
+filter::prepared::doc_count multiterm_query::count(
+    const sub_reader& segment,
+    uint64_t /*limit*/) const {
+  auto state = states_.find(segment);
+
+  if (!state || state->empty()) {
+    return { 0, true };
+  }
+
+  // number of matches is a number of distinct live documents
+  // of all matched terms
+  const size_t bits = segment.docs_count() + irs::doc_limits::min();
+  const size_t words = bitset::bits_to_words(bits);
+  auto set = memory::make_unique<bitset::word_t[]>(words);
+  std::memset(set.get(), 0, sizeof(bitset::word_t)*words);
+
+  auto scored = state->scored_states.begin();
+  auto unscored = state->unscored_terms.begin();
+  auto provider = [&]() noexcept -> const seek_cookie* {
+    if (scored != state->scored_states.end()) {
+      return (scored++)->cookie.get();
+    }
+    if (unscored != state->unscored_terms.end()) {
+      return (unscored++)->get();
+    }
+    return nullptr;
+  };
+
+  state->reader->bit_union(provider, set.get());
+  ::mask(segment, set.get(), words);
+
+  return { math::popcount(set.get(), set.get() + words), true };
+}
+
 } // ROOT
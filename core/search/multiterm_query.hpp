@@ -130,6 +130,12 @@ class multiterm_query : public filter::prepared {
       const order::prepared& ord,
       const attribute_provider* /*ctx*/) const override;
 
+  using filter::prepared::count;
+
+  virtual doc_count count(
+      const sub_reader& rdr,
+      uint64_t limit) const override;
+
  private:
   const stats_t& stats() const noexcept {
     assert(stats_ptr_);
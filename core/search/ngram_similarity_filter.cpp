@@ -72,7 +72,10 @@ class ngram_similarity_doc_iterator final
       approx_(std::move(itrs), min_match_count), // we are not interested in disjunction`s scoring
       min_match_count_(min_match_count),
       total_terms_count_(static_cast<boost_t>(total_terms_count)), // avoid runtime conversion
-      empty_order_(ord.empty()) {
+      empty_order_(ord.empty()),
+      // without scoring we're only interested in a length of the longest
+      // sequence which is cheap to evaluate for up to 64 terms
+      bit_parallel_(empty_order_ && pos_.size() <= bits_required<uint64_t>()) {
     std::get<attribute_ptr<document>>(attrs_) = irs::get_mutable<document>(&approx_);
 
     // FIXME find a better estimation
@@ -98,7 +101,7 @@ class ngram_similarity_doc_iterator final
 
   virtual bool next() override {
     bool next = false;
-    while ((next = approx_.next()) && !check_serial_positions()) {}
+    while ((next = approx_.next()) && !check()) {}
     return next;
   }
 
@@ -114,7 +117,7 @@ class ngram_similarity_doc_iterator final
     }
     const auto doc = approx_.seek(target);
 
-    if (doc_limits::eof(doc) || check_serial_positions()) {
+    if (doc_limits::eof(doc) || check()) {
       return doc;
     }
 
@@ -164,7 +167,14 @@ class ngram_similarity_doc_iterator final
     score,
     filter_boost>;
 
+  bool check() {
+    return bit_parallel_
+      ? check_serial_positions_bit_parallel()
+      : check_serial_positions();
+  }
+
   bool check_serial_positions();
+  bool check_serial_positions_bit_parallel();
 
   std::vector<position_t> pos_;
   approximation approx_;
@@ -174,10 +184,60 @@ class ngram_similarity_doc_iterator final
   std::vector<size_t> pos_sequence_;
   size_t min_match_count_;
   search_states_t search_buf_;
+  std::vector<std::pair<uint32_t, uint64_t>> matches_; // position + term bit
   boost_t total_terms_count_;
   bool empty_order_;
+  bool bit_parallel_;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluates the length of the longest common subsequence of query
+///        terms and terms of the current document ordered by positions,
+///        terms sharing the same position can't follow each other,
+///        see "Bit-Parallel LCS-length Computation Revisited", Hyyro H.
+/// @note every query term is represented by a bit of a 64-bit word
+////////////////////////////////////////////////////////////////////////////////
+bool ngram_similarity_doc_iterator::check_serial_positions_bit_parallel() {
+  assert(pos_.size() <= bits_required<uint64_t>());
+  const auto* doc = std::get<attribute_ptr<document>>(attrs_).ptr;
+
+  matches_.clear();
+  uint64_t term = 1;
+  for (const auto& pos_iterator : pos_) {
+    if (pos_iterator.doc->value == doc->value) {
+      for (auto& pos = *pos_iterator.pos; pos.next(); ) {
+        matches_.emplace_back(pos.value(), term);
+      }
+    }
+    term <<= 1;
+  }
+
+  std::sort(matches_.begin(), matches_.end());
+
+  // bits of query terms, garbage in the upper bits doesn't
+  // affect the lower ones since carries only go upwards
+  const uint64_t mask = term - 1;
+  uint64_t v = ~uint64_t{0};
+
+  for (auto begin = matches_.begin(), end = matches_.end(); begin != end; ) {
+    // terms at the current position
+    const auto pos = begin->first;
+    uint64_t terms = 0;
+    for (; begin != end && begin->first == pos; ++begin) {
+      terms |= begin->second;
+    }
+
+    const uint64_t u = v & terms;
+    v = (v + u) | (v - u);
+
+    if (size_t(std::popcount(~v & mask)) >= min_match_count_) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 bool ngram_similarity_doc_iterator::check_serial_positions() {
   size_t potential = approx_.match_count(); // how long max sequence could be in the best case
   search_buf_.clear();
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "parallel_search.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+#include "index/index_reader.hpp"
+#include "utils/async_utils.hpp"
+
+namespace {
+
+using namespace irs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief state shared between the caller and the tasks of a thread pool
+/// @note tasks may be scheduled after the caller has already returned, hence
+///       the state is ref-counted and such tasks must not access anything
+///       apart from the state
+////////////////////////////////////////////////////////////////////////////////
+struct parallel_state {
+  explicit parallel_state(size_t count) noexcept
+    : count(count) {
+  }
+
+  const size_t count; // total number of segments
+  std::atomic<size_t> next{0}; // next segment to visit
+  std::atomic<bool> stop{false};
+  std::mutex mutex;
+  std::condition_variable finished;
+  size_t done{0}; // number of processed segments, guarded by 'mutex'
+  std::exception_ptr error; // guarded by 'mutex'
+  bool cancelled{false}; // guarded by 'mutex'
+};
+
+}
+
+namespace iresearch {
+
+bool parallel_for_each(
+    async_utils::thread_pool& pool,
+    const index_reader& index,
+    const segment_visitor_f& visitor,
+    const search_progress_f& progress /*= {}*/) {
+  const size_t count = index.size();
+
+  if (!count) {
+    return true;
+  }
+
+  auto state = std::make_shared<parallel_state>(count);
+
+  auto task = [state, &index, &visitor, &progress]() noexcept {
+    for (size_t i; (i = state->next.fetch_add(1)) < state->count; ) {
+      // segment 'i' is claimed, hence the caller waits for its completion
+      // and the captured references remain valid
+      std::exception_ptr error;
+      bool cancelled = false;
+
+      if (!state->stop.load(std::memory_order_relaxed)) {
+        try {
+          if (progress && !progress()) {
+            cancelled = true;
+          } else {
+            visitor(index[i], i);
+          }
+        } catch (...) {
+          error = std::current_exception();
+        }
+
+        if (cancelled || error) {
+          state->stop.store(true, std::memory_order_relaxed);
+        }
+      }
+
+      std::lock_guard lock{state->mutex};
+
+      if (error && !state->error) {
+        state->error = std::move(error);
+      }
+
+      state->cancelled |= cancelled;
+
+      if (++state->done == state->count) {
+        state->finished.notify_all();
+      }
+    }
+  };
+
+  // the calling thread processes segments as well
+  for (size_t i = 0, size = std::min(count - 1, pool.max_threads()); i < size; ++i) {
+    if (!pool.run(std::function<void()>{task})) {
+      break; // pool is stopped
+    }
+  }
+
+  task();
+
+  std::unique_lock lock{state->mutex};
+  state->finished.wait(lock, [&state]() { return state->done == state->count; });
+
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+
+  return !state->cancelled;
+}
+
+} // ROOT
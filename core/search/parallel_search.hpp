@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_PARALLEL_SEARCH_H
+#define IRESEARCH_PARALLEL_SEARCH_H
+
+#include <functional>
+
+#include "shared.hpp"
+
+namespace iresearch {
+
+struct index_reader;
+struct sub_reader;
+
+namespace async_utils {
+class thread_pool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief callback reporting execution progress, execution is cancelled
+///        as soon as it returns false
+/// @note may be invoked concurrently from multiple threads
+////////////////////////////////////////////////////////////////////////////////
+using search_progress_f = std::function<bool()>;
+
+using segment_visitor_f = std::function<void(const sub_reader&, size_t)>;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invokes 'visitor(segment, ordinal)' for every segment of 'index'
+///        in parallel on the threads of the specified 'pool', the calling
+///        thread takes part in execution as well, so the function makes
+///        progress even if all threads of the pool are busy
+/// @param progress checked before visiting a segment, remaining segments are
+///        skipped once it returns false
+/// @returns false if execution has been cancelled, true otherwise
+/// @note blocks until all visitors are finished, the first exception thrown
+///       by a visitor is rethrown after that, remaining segments are skipped
+/// @note 'visitor' is invoked concurrently and must be thread-safe
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API bool parallel_for_each(
+  async_utils::thread_pool& pool,
+  const index_reader& index,
+  const segment_visitor_f& visitor,
+  const search_progress_f& progress = {});
+
+} // ROOT
+
+#endif // IRESEARCH_PARALLEL_SEARCH_H
@@ -52,6 +52,9 @@ struct fixed_phrase_state : util::noncopyable {
 
   phrase_state<term_state> terms;
   const term_reader* reader{};
+  // pairs of adjacent terms from a companion field
+  std::vector<seek_term_iterator::cookie_ptr> shingles;
+  const term_reader* shingles_reader{};
 }; // fixed_phrase_state
 
 static_assert(std::is_nothrow_move_constructible_v<fixed_phrase_state>);
@@ -319,7 +322,7 @@ class fixed_phrase_query : public phrase_query<fixed_phrase_state> {
     const IndexFeatures features = ord.features() | by_phrase::required();
 
     conjunction_t::doc_iterators_t itrs;
-    itrs.reserve(phrase_state->terms.size());
+    itrs.reserve(phrase_state->terms.size() + phrase_state->shingles.size());
 
     std::vector<fixed_phrase_frequency::term_position_t> positions;
     positions.reserve(phrase_state->terms.size());
@@ -351,6 +354,15 @@ class fixed_phrase_query : public phrase_query<fixed_phrase_state> {
       ++position;
     }
 
+    // postings of term pairs are usually much shorter than the ones of the
+    // terms, the conjunction is led by them and positions are verified for
+    // the remaining candidates only
+    for (const auto& cookie : phrase_state->shingles) {
+      assert(cookie && phrase_state->shingles_reader);
+      itrs.emplace_back(
+        phrase_state->shingles_reader->postings(*cookie, IndexFeatures::NONE));
+    }
+
     return memory::make_managed<phrase_iterator_t>(
         std::move(itrs),
         std::move(positions),
@@ -531,6 +543,10 @@ filter::prepared::ptr by_phrase::fixed_prepare_collect(
 
   phrase_term_visitor<decltype(phrase_terms)> ptv(phrase_terms);
 
+  // pairs of adjacent terms narrowing down phrase candidates
+  const std::vector<bstring> shingles = make_shingles();
+  std::vector<seek_term_iterator::cookie_ptr> shingle_states;
+
   for (const auto& segment : index) {
     // get term dictionary for field
     const auto* reader = segment.field(field);
@@ -565,11 +581,38 @@ filter::prepared::ptr by_phrase::fixed_prepare_collect(
       continue;
     }
 
+    const auto* shingles_reader = shingles.empty()
+      ? nullptr
+      : segment.field(options().shingles_field());
+
+    if (shingles_reader) {
+      auto terms = shingles_reader->iterator(SeekMode::RANDOM_ONLY);
+
+      for (const auto& shingle : shingles) {
+        if (IRS_UNLIKELY(!terms) || !terms->seek(shingle)) {
+          break;
+        }
+
+        terms->read();
+        shingle_states.emplace_back(terms->cookie());
+      }
+
+      // phrase can't match if any pair of its terms is missing
+      if (shingle_states.size() != shingles.size()) {
+        shingle_states.clear();
+        phrase_terms.clear();
+        continue;
+      }
+    }
+
     auto& state = phrase_states.insert(segment);
     state.terms = std::move(phrase_terms);
     state.reader = reader;
+    state.shingles = std::move(shingle_states);
+    state.shingles_reader = shingles_reader;
 
     phrase_terms.reserve(phrase_size);
+    shingle_states.clear();
   }
 
   // offset of the first term in a phrase
@@ -598,6 +641,34 @@ filter::prepared::ptr by_phrase::fixed_prepare_collect(
     this->boost() * boost);
 }
 
+std::vector<bstring> by_phrase::make_shingles() const {
+  std::vector<bstring> shingles;
+
+  if (options().shingles_field().empty()) {
+    return shingles;
+  }
+
+  const auto delimiter = ref_cast<byte_type>(
+    string_ref(options().shingles_delimiter()));
+
+  for (auto prev = options().begin(), it = std::next(prev), end = options().end();
+       it != end; prev = it++) {
+    // pairs are indexed for adjacent terms only
+    if (it->first != prev->first + 1) {
+      continue;
+    }
+
+    assert(std::get_if<by_term_options>(&prev->second));
+    assert(std::get_if<by_term_options>(&it->second));
+    auto& shingle = shingles.emplace_back(
+      std::get<by_term_options>(prev->second).term);
+    shingle.append(delimiter.c_str(), delimiter.size());
+    shingle.append(std::get<by_term_options>(it->second).term);
+  }
+
+  return shingles;
+}
+
 filter::prepared::ptr by_phrase::variadic_prepare_collect(
     const index_reader& index,
     const order::prepared& ord,
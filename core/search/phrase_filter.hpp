@@ -116,11 +116,41 @@ class by_phrase_options {
     return std::get_if<PhrasePart>(&it->second);
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief narrow down candidates of a phrase composed of simple terms by
+  ///        postings of adjacent term pairs indexed into a companion 'field',
+  ///        e.g. via 'shingle' analyzer, positions are then verified for the
+  ///        candidates only
+  /// @param delimiter separates terms in a pair
+  /// @note every segment having 'field' is expected to contain pairs of all
+  ///       tokens at adjacent positions of the phrase field, including ones
+  ///       sharing a position, as 'shingle' analyzer emits them, an empty
+  ///       'field' disables the lookup
+  //////////////////////////////////////////////////////////////////////////////
+  void shingles(string_ref field, string_ref delimiter) {
+    shingles_field_ = field;
+    shingles_delimiter_ = delimiter;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns companion field containing pairs of adjacent terms
+  //////////////////////////////////////////////////////////////////////////////
+  const std::string& shingles_field() const noexcept { return shingles_field_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns delimiter separating terms in a pair
+  //////////////////////////////////////////////////////////////////////////////
+  const std::string& shingles_delimiter() const noexcept {
+    return shingles_delimiter_;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @returns true is options are equal, false - otherwise
   //////////////////////////////////////////////////////////////////////////////
   bool operator==(const by_phrase_options& rhs) const noexcept {
-    return phrase_ == rhs.phrase_;
+    return phrase_ == rhs.phrase_ &&
+      shingles_field_ == rhs.shingles_field_ &&
+      shingles_delimiter_ == rhs.shingles_delimiter_;
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -132,6 +162,10 @@ class by_phrase_options {
       hash = hash_combine(hash, part.first);
       hash = hash_combine(hash, part.second);
     }
+    if (!shingles_field_.empty()) {
+      hash = hash_combine(hash, shingles_field_);
+      hash = hash_combine(hash, shingles_delimiter_);
+    }
     return hash;
   }
 
@@ -174,6 +208,8 @@ class by_phrase_options {
   }
 
   phrase_type phrase_;
+  std::string shingles_field_;
+  std::string shingles_delimiter_;
   bool is_simple_term_only_{true};
 }; // by_phrase_options
 
@@ -206,6 +242,9 @@ class by_phrase : public filter_base<by_phrase_options> {
     const order::prepared& ord,
     boost_t boost) const;
 
+  // pairs of adjacent terms of a phrase composed of simple terms
+  std::vector<bstring> make_shingles() const;
+
   filter::prepared::ptr variadic_prepare_collect(
     const index_reader& index,
     const order::prepared& ord,
@@ -33,6 +33,23 @@ const byte_type* default_score(score_ctx* ctx) noexcept {
   return reinterpret_cast<byte_type*>(ctx);
 }
 
+void default_min(score_ctx*, float_t) noexcept {
+  // NOOP
+}
+
+struct max_score_ctx final : score_ctx {
+  explicit max_score_ctx(max_score_f&& func) noexcept
+    : func(std::move(func)) {
+  }
+
+  max_score_f func;
+};
+
+float_t max_score(score_ctx* ctx, uint32_t max_freq) {
+  assert(ctx);
+  return static_cast<max_score_ctx*>(ctx)->func(max_freq);
+}
+
 }
 
 namespace iresearch {
@@ -46,12 +63,14 @@ namespace iresearch {
 }
 
 score::score() noexcept
-  : func_(reinterpret_cast<score_ctx*>(data()), &::default_score) {
+  : func_(reinterpret_cast<score_ctx*>(data()), &::default_score),
+    min_func_(&::default_min) {
 }
 
 score::score(const order::prepared& ord)
   : buf_(ord.score_size(), 0),
-    func_(reinterpret_cast<score_ctx*>(data()), &::default_score) {
+    func_(reinterpret_cast<score_ctx*>(data()), &::default_score),
+    min_func_(&::default_min) {
 }
 
 bool score::is_default() const noexcept {
@@ -64,6 +83,13 @@ void score::reset() noexcept {
               &::default_score);
 }
 
+void score::reset_block(max_score_f&& func) {
+  assert(func);
+  block_ctx_ = std::make_unique<::max_score_ctx>(std::move(func));
+  bounds.block_ctx = block_ctx_.get();
+  bounds.block = &::max_score;
+}
+
 void reset(irs::score& score, order::prepared::scorers&& scorers) {
   switch (scorers.size()) {
     case 0: {
@@ -23,6 +23,9 @@
 #ifndef IRESEARCH_SCORE_H
 #define IRESEARCH_SCORE_H
 
+#include <limits>
+#include <memory>
+
 #include "sort.hpp"
 #include "utils/attributes.hpp"
 
@@ -34,6 +37,30 @@ namespace iresearch {
 ////////////////////////////////////////////////////////////////////////////////
 class score : public attribute {
  public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief upper bounds of the score values produced by an iterator
+  /// @note only meaningful for scorers producing a single 'float_t' score
+  //////////////////////////////////////////////////////////////////////////////
+  struct upper_bounds {
+    using block_f = float_t(*)(score_ctx* ctx, uint32_t max_freq);
+
+    // upper bound of the score of any document in the remaining part of
+    // the iterator
+    float_t tail{std::numeric_limits<float_t>::max()};
+    // optional, evaluates an upper bound of the score of any document within
+    // a block of postings given the block's maximum in-document frequency,
+    // e.g. as provided by the 'impact' attribute of an iterator, invoked
+    // as 'block(block_ctx, max_freq)', see 'score::reset_block(...)'
+    score_ctx* block_ctx{};
+    block_f block{};
+  }; // upper_bounds
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief notifies an iterator that documents scored below 'threshold'
+  ///        are not of interest anymore and may be skipped
+  //////////////////////////////////////////////////////////////////////////////
+  using min_f = void(*)(score_ctx* ctx, float_t threshold) noexcept;
+
   static constexpr string_ref type_name() noexcept {
     return "iresearch::score";
   }
@@ -66,6 +93,9 @@ class score : public attribute {
     assert(score.func_);
     func_.reset(const_cast<score_ctx*>(score.func_.ctx()),
                 score.func_.func());
+    bounds = score.bounds;
+    min_ctx_ = score.min_ctx_;
+    min_func_ = score.min_func_;
   }
 
   void reset(std::unique_ptr<score_ctx>&& ctx, const score_f func) noexcept {
@@ -101,9 +131,45 @@ class score : public attribute {
     std::memset(const_cast<byte_type*>(buf_.data()), 0, buf_.size());
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set minimal competitive score, the iterator is allowed to skip
+  ///        documents scored below the specified 'threshold'
+  //////////////////////////////////////////////////////////////////////////////
+  FORCE_INLINE void min(float_t threshold) noexcept {
+    assert(min_func_);
+    min_func_(min_ctx_, threshold);
+  }
+
+  void reset_min(score_ctx* ctx, const min_f func) noexcept {
+    assert(func);
+    min_ctx_ = ctx;
+    min_func_ = func;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set an evaluator of the score upper bounds of blocks of postings,
+  ///        'func' is owned by the score, i.e. 'bounds' forwarded by
+  ///        'reset(const score&)' are valid as long as this score is
+  //////////////////////////////////////////////////////////////////////////////
+  void reset_block(max_score_f&& func);
+
+  upper_bounds bounds;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief optional, evaluates scores of the documents read at once via
+  ///        'next_batch(...)' of an iterator exposing the score along with
+  ///        'frequency', equal to the ones evaluated document by document
+  /// @note isn't forwarded by 'reset(const score&)' since documents of
+  ///       another iterator don't correspond to the scorer
+  //////////////////////////////////////////////////////////////////////////////
+  bulk_score_function bulk;
+
  private:
   bstring buf_;
   score_function func_;
+  score_ctx* min_ctx_{};
+  min_f min_func_;
+  std::unique_ptr<score_ctx> block_ctx_; // owns 'bounds.block_ctx'
 //  memory::managed_ptr<score_ctx> ctx_; // arbitrary scoring context
 //  score_f func_; // scoring function
 }; // score
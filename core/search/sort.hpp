@@ -24,6 +24,7 @@
 #ifndef IRESEARCH_SORT_H
 #define IRESEARCH_SORT_H
 
+#include <functional>
 #include <vector>
 
 #include "index/index_features.hpp"
@@ -73,6 +74,24 @@ struct score_ctx {
 using score_less_f = bool(*)(const byte_type* lhs, const byte_type* rhs);
 using score_f = const byte_type*(*)(score_ctx* ctx);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluates an upper bound of the score of any document containing
+///        a term at most 'max_freq' times
+/// @note only meaningful for scorers producing a single 'float_t' score
+////////////////////////////////////////////////////////////////////////////////
+using max_score_f = std::function<float_t(uint32_t max_freq)>;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluates 'float_t' scores of 'count' documents denoted by 'docs'
+///        containing a term 'freqs' times at once
+/// @note only meaningful for scorers producing a single 'float_t' score
+////////////////////////////////////////////////////////////////////////////////
+using bulk_score_f = void(*)(score_ctx* ctx,
+                             const doc_id_t* docs,
+                             const uint32_t* freqs,
+                             size_t count,
+                             float_t* scores);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief combine range of scores denoted by 'src' and 'size' to 'dst',
 ///        i.e. using +=
@@ -148,6 +167,67 @@ class score_function : util::noncopyable {
   score_f func_;
 }; // score_function
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class bulk_score_function
+/// @brief a convenient wrapper around bulk_score_f and score_ctx
+////////////////////////////////////////////////////////////////////////////////
+class bulk_score_function : util::noncopyable {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief max number of documents scored by a single call of a scorer
+  ///        implementation, larger ranges are split internally
+  //////////////////////////////////////////////////////////////////////////////
+  static constexpr size_t kBlockSize = 128;
+
+  bulk_score_function() = default;
+  bulk_score_function(std::unique_ptr<score_ctx>&& ctx,
+                      const bulk_score_f func) noexcept
+    : ctx_(memory::to_managed<score_ctx>(std::move(ctx))), func_(func) {
+  }
+  bulk_score_function(bulk_score_function&& rhs) noexcept
+    : ctx_(std::move(rhs.ctx_)), func_(rhs.func_) {
+    rhs.func_ = nullptr;
+  }
+  bulk_score_function& operator=(bulk_score_function&& rhs) noexcept {
+    if (this != &rhs) {
+      ctx_ = std::move(rhs.ctx_);
+      func_ = rhs.func_;
+      rhs.func_ = nullptr;
+    }
+    return *this;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluates scores of 'count' documents denoted by 'docs'
+  ///        with corresponding in-document term frequencies 'freqs'
+  /// @param scores [out] evaluated scores, must hold at least 'count' values
+  //////////////////////////////////////////////////////////////////////////////
+  void operator()(const doc_id_t* docs, const uint32_t* freqs,
+                  size_t count, float_t* scores) const {
+    assert(func_);
+
+    for (; count > kBlockSize; count -= kBlockSize) {
+      func_(ctx_.get(), docs, freqs, kBlockSize, scores);
+      docs += kBlockSize;
+      freqs += kBlockSize;
+      scores += kBlockSize;
+    }
+
+    func_(ctx_.get(), docs, freqs, count, scores);
+  }
+
+  const score_ctx* ctx() const noexcept { return ctx_.get(); }
+  bulk_score_f func() const noexcept { return func_; }
+
+  explicit operator bool() const noexcept {
+    return nullptr != func_;
+  }
+
+ private:
+  memory::managed_ptr<score_ctx> ctx_;
+  bulk_score_f func_{};
+}; // bulk_score_function
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @class sort
 /// @brief base class for all user-side sort entries
@@ -386,6 +466,33 @@ class sort {
       const attribute_provider& doc_attrs,
       boost_t boost) const = 0;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief create a function evaluating an upper bound of the document
+    ///        scores produced by 'prepare_scorer' for the specified field
+    /// @return empty function == scorer doesn't support score upper bounds
+    ////////////////////////////////////////////////////////////////////////////
+    virtual max_score_f prepare_max_score(
+        const sub_reader& /*segment*/,
+        const term_reader& /*field*/,
+        const byte_type* /*stats*/,
+        boost_t /*boost*/) const {
+      return {};
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief create a function evaluating scores of the documents matching
+    ///        a term in the specified field a block at a time, produced
+    ///        scores must be equal to the ones of 'prepare_scorer'
+    /// @return empty function == scorer doesn't support bulk scoring
+    ////////////////////////////////////////////////////////////////////////////
+    virtual bulk_score_function prepare_bulk_scorer(
+        const sub_reader& /*segment*/,
+        const term_reader& /*field*/,
+        const byte_type* /*stats*/,
+        boost_t /*boost*/) const {
+      return {};
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     /// @brief create an object to be used for collecting index statistics, one
     ///        instance per matched term
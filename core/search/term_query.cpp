@@ -22,6 +22,8 @@
 
 #include "term_query.hpp"
 
+#include "analysis/token_attributes.hpp"
+#include "formats/formats.hpp"
 #include "index/index_reader.hpp"
 #include "search/score.hpp"
 
@@ -68,10 +70,57 @@ doc_iterator::ptr term_query::execute(
         *docs, boost());
 
       irs::reset(*score, std::move(scorers));
+
+      // provide score upper bound for dynamic pruning, the total number of
+      // occurrences of a term is the upper bound of its in-document frequency
+      if (1 == ord.size() && !ord.begin()->score_offset) {
+        auto& bucket = *ord.begin();
+
+        if (auto max_score = bucket.bucket->prepare_max_score(
+              rdr, *state->reader, stats_.c_str() + bucket.stats_offset,
+              boost());
+            max_score) {
+          const auto* meta = irs::get<term_meta>(*state->cookie);
+
+          score->bounds.tail = max_score(
+            meta && meta->freq ? meta->freq
+                               : std::numeric_limits<uint32_t>::max());
+
+          // tighter bounds of particular blocks of postings
+          if (irs::get<impact>(*docs)) {
+            score->reset_block(std::move(max_score));
+          }
+        }
+
+        // documents read via 'next_batch(...)' may be scored at once
+        score->bulk = bucket.bucket->prepare_bulk_scorer(
+          rdr, *state->reader, stats_.c_str() + bucket.stats_offset,
+          boost());
+      }
     }
   }
 
   return docs;
 }
 
+filter::prepared::doc_count term_query::count(
+    const sub_reader& rdr,
+    uint64_t limit) const {
+  auto state = states_.find(rdr);
+
+  if (!state) {
+    return { 0, true };
+  }
+
+  // without deletes a number of matches is a number of term documents
+  if (rdr.live_docs_count() == rdr.docs_count()) {
+    assert(state->cookie);
+    if (const auto* meta = irs::get<term_meta>(*state->cookie); meta) {
+      return { meta->docs_count, true };
+    }
+  }
+
+  return filter::prepared::count(rdr, limit);
+}
+
 } // ROOT
@@ -53,6 +53,12 @@ class term_query final : public filter::prepared {
     const attribute_provider* /*ctx*/
   ) const override;
 
+  using filter::prepared::count;
+
+  virtual doc_count count(
+    const sub_reader& rdr,
+    uint64_t limit) const override;
+
  private:
   states_cache<term_state> states_;
   bstring stats_;
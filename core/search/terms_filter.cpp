@@ -33,6 +33,10 @@ namespace {
 
 using namespace irs;
 
+// minimal number of terms for which unscored matches get merged into
+// a bitset rather than being evaluated via a disjunction of postings
+constexpr size_t kBitUnionMinTerms = 16;
+
 template<typename Visitor>
 void visit(
     const sub_reader& segment,
@@ -47,14 +51,32 @@ void visit(
 
   visitor.prepare(segment, field, *terms);
 
-  for (auto& term : search_terms) {
-    if (!terms->seek(term.term)) {
-      continue;
+  // search terms are sorted, walk the dictionary in a single pass:
+  // consequent seeks reuse already loaded blocks and a term the
+  // iterator stopped at allows to skip all preceding search terms
+  // without touching the dictionary
+  auto begin = search_terms.begin();
+  const auto end = search_terms.end();
+
+  while (begin != end) {
+    switch (terms->seek_ge(begin->term)) {
+      case SeekResult::END:
+        return;
+      case SeekResult::NOT_FOUND: {
+        const bytes_ref term = terms->value();
+
+        for (++begin; begin != end && begin->term < term; ++begin) { }
+
+        if (begin == end || begin->term != term) {
+          continue;
+        }
+      } [[fallthrough]];
+      case SeekResult::FOUND:
+        terms->read();
+        visitor.visit(begin->boost);
+        ++begin;
+        break;
     }
-
-    terms->read();
-
-    visitor.visit(term.boost);
   }
 }
 
@@ -83,14 +105,50 @@ class terms_visitor {
   Collector& collector_;
 }; // terms_visitor
 
-template<typename Collector>
+// collects matching terms as unscored ones, i.e. to be evaluated via
+// 'postings_reader::bit_union(...)'
+template<typename States>
+class unscored_terms_visitor {
+ public:
+  explicit unscored_terms_visitor(States& states) noexcept
+    : states_(states) {
+  }
+
+  void prepare(
+      const sub_reader& segment,
+      const term_reader& field,
+      const seek_term_iterator& terms) {
+    auto& state = states_.insert(segment);
+    state.reader = &field;
+
+    state_ = &state;
+    terms_ = &terms;
+
+    // get term metadata
+    auto* meta = irs::get<term_meta>(terms);
+    docs_count_ = meta ? &meta->docs_count : &no_docs_;
+  }
+
+  void visit(boost_t /*boost*/) {
+    assert(state_ && terms_);
+    state_->unscored_terms.emplace_back(terms_->cookie());
+    state_->unscored_states_estimation += *docs_count_;
+  }
+
+ private:
+  States& states_;
+  typename States::state_type* state_{};
+  const seek_term_iterator* terms_{};
+  const decltype(term_meta::docs_count)* docs_count_{};
+  const decltype(term_meta::docs_count) no_docs_{0};
+}; // unscored_terms_visitor
+
+template<typename Visitor>
 void collect_terms(
     const index_reader& index,
     string_ref field,
     const by_terms_options::search_terms& terms,
-    Collector& collector) {
-  terms_visitor<Collector> visitor(collector);
-
+    Visitor& visitor) {
   for (auto& segment : index) {
     auto* reader = segment.field(field);
 
@@ -134,12 +192,24 @@ filter::prepared::ptr by_terms::prepare(
     return by_term::prepare(index, order, boost*term->boost, field(), term->term);
   }
 
+  multiterm_query::states_t states(index);
+
+  if (order.empty() && size >= kBitUnionMinTerms) {
+    // nothing to score, union postings of all matching terms into a bitset
+    unscored_terms_visitor<decltype(states)> visitor(states);
+    collect_terms(index, field(), terms, visitor);
+
+    return memory::make_managed<multiterm_query>(
+      std::move(states), multiterm_query::stats_t{},
+      boost, sort::MergeType::AGGREGATE);
+  }
+
   field_collectors field_stats(order);
   term_collectors term_stats(order, size);
-  multiterm_query::states_t states(index);
 
   all_terms_collector<decltype(states)> collector(states, field_stats, term_stats);
-  collect_terms(index, field(), terms, collector);
+  terms_visitor<decltype(collector)> visitor(collector);
+  collect_terms(index, field(), terms, visitor);
 
   std::vector<bstring> stats(size);
   size_t term_idx = 0;
@@ -86,6 +86,9 @@ struct by_terms_options {
 ////////////////////////////////////////////////////////////////////////////////
 /// @class by_terms
 /// @brief user-side filter by a set of terms
+/// @note terms are looked up in a single sorted pass over a term dictionary,
+///       postings of a large number of terms are merged into a bitset unless
+///       scoring is requested
 ////////////////////////////////////////////////////////////////////////////////
 class by_terms final
     : public filter_base<by_terms_options> {
@@ -37,6 +37,7 @@
 #include "index/norm.hpp"
 #include "index/field_meta.hpp"
 #include "utils/math_utils.hpp"
+#include "utils/simd_dispatch.hpp"
 #include "utils/misc.hpp"
 
 namespace {
@@ -380,6 +381,71 @@ score_function MakeScoreFunction(const filter_boost* filter_boost,
       std::forward<Args>(args)...);
 }
 
+struct BulkContext : public irs::score_ctx {
+  BulkContext(irs::boost_t boost, const tfidf::idf& idf) noexcept
+    : idf{boost * idf.value} {
+  }
+
+  float_t idf; // precomputed : boost * idf
+};
+
+template<typename Norm>
+struct BulkNormContext final : public BulkContext {
+  BulkNormContext(
+      irs::boost_t boost,
+      const tfidf::idf& idf,
+      std::unique_ptr<document>&& doc,
+      Norm&& norm) noexcept
+    : BulkContext{boost, idf},
+      doc{std::move(doc)},
+      norm{std::move(norm)} {
+    assert(this->doc);
+  }
+
+  std::unique_ptr<document> doc; // document 'norm' reads values for
+  Norm norm;
+  float_t norms[bulk_score_function::kBlockSize]{}; // gathered norm values
+};
+
+static_assert(bulk_score_function::kBlockSize <= simd::dispatch::kScoreBlockSize);
+
+inline bulk_score_function MakeBulkScoreFunction(
+    irs::boost_t boost, const tfidf::idf& idf) {
+  return {
+    memory::make_unique<BulkContext>(boost, idf),
+    [](irs::score_ctx* ctx, const doc_id_t* /*docs*/,
+       const uint32_t* freqs, size_t count, float_t* scores) noexcept {
+      auto& state = *static_cast<BulkContext*>(ctx);
+
+      simd::dispatch::score_tfidf(freqs, nullptr, count, scores, state.idf);
+    }
+  };
+}
+
+template<typename Norm>
+bulk_score_function MakeBulkScoreFunction(
+    irs::boost_t boost, const tfidf::idf& idf,
+    std::unique_ptr<document>&& doc, Norm&& norm) {
+  using Ctx = BulkNormContext<Norm>;
+
+  return {
+    memory::make_unique<Ctx>(boost, idf, std::move(doc), std::move(norm)),
+    [](irs::score_ctx* ctx, const doc_id_t* docs,
+       const uint32_t* freqs, size_t count, float_t* scores) {
+      auto& state = *static_cast<Ctx*>(ctx);
+
+      // gather norms
+      for (size_t i = 0; i < count; ++i) {
+        state.doc->value = docs[i];
+        state.norms[i] = state.norm();
+      }
+
+      simd::dispatch::score_tfidf(
+        freqs, state.norms, count, scores, state.idf);
+    }
+  };
+}
+
 class sort final: public irs::prepared_sort_basic<tfidf::score_t, tfidf::idf> {
  public:
   explicit sort(bool normalize, bool boost_as_score) noexcept
@@ -488,6 +554,64 @@ class sort final: public irs::prepared_sort_basic<tfidf::score_t, tfidf::idf> {
         filter_boost, score_buf, boost, stats, freq);
   }
 
+  virtual max_score_f prepare_max_score(
+      const sub_reader& /*segment*/,
+      const term_reader& /*field*/,
+      const byte_type* stats_buf,
+      boost_t boost) const override {
+    // length norm never exceeds 1, see 'NormAdapter'
+    const float_t idf = boost * stats_cast(stats_buf).value;
+    // score value of the documents without frequency
+    const float_t min = boost_as_score_ ? boost : 0.f;
+
+    return [idf, min](uint32_t max_freq) noexcept -> float_t {
+      return std::max(min, ::tfidf(max_freq, idf));
+    };
+  }
+
+  virtual bulk_score_function prepare_bulk_scorer(
+      const sub_reader& segment,
+      const term_reader& field,
+      const byte_type* stats_buf,
+      boost_t boost) const override {
+    if (IndexFeatures::NONE == (field.meta().index_features & IndexFeatures::FREQ)) {
+      return {};
+    }
+
+    auto& stats = stats_cast(stats_buf);
+
+    if (normalize_) {
+      auto doc = memory::make_unique<document>();
+
+      auto prepare_norm_scorer = [&]<typename Norm>(Norm&& norm) -> bulk_score_function {
+        return MakeBulkScoreFunction(boost, stats, std::move(doc), std::move(norm));
+      };
+
+      const auto& features = field.meta().features;
+
+      if (auto it = features.find(irs::type<Norm2>::id()); it != features.end()) {
+         if (Norm2::Context ctx; ctx.Reset(segment, it->second, *doc)) {
+           if (ctx.max_num_bytes == sizeof(byte_type)) {
+             return Norm2::MakeReader(std::move(ctx), [&](auto&& reader) {
+                 return prepare_norm_scorer(MakeNormAdapter<NormType::kNorm2Tiny>(std::move(reader))); });
+           }
+
+           return Norm2::MakeReader(std::move(ctx), [&](auto&& reader) {
+               return prepare_norm_scorer(MakeNormAdapter<NormType::kNorm2>(std::move(reader))); });
+         }
+      }
+
+      if (auto it = features.find(irs::type<Norm>::id()); it != features.end()) {
+         if (Norm::Context ctx; ctx.Reset(segment, it->second, *doc)) {
+           return prepare_norm_scorer(MakeNormAdapter<NormType::kNorm>(
+               Norm::MakeReader(std::move(ctx))));
+         }
+      }
+    }
+
+    return MakeBulkScoreFunction(boost, stats);
+  }
+
   virtual irs::sort::term_collector::ptr prepare_term_collector() const override {
     return irs::memory::make_unique<term_collector>();
   }
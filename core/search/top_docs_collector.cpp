@@ -0,0 +1,456 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "top_docs_collector.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "analysis/token_attributes.hpp"
+#include "index/comparer.hpp"
+#include "index/index_reader.hpp"
+#include "search/score.hpp"
+
+namespace {
+
+using namespace irs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @returns true if order consists of a single descending 'float_t' scorer,
+///          i.e. an iterator may skip documents scored below a threshold
+////////////////////////////////////////////////////////////////////////////////
+bool can_prune(const order::prepared& order) noexcept {
+  if (1 != order.size()) {
+    return false;
+  }
+
+  const auto& bucket = *order.begin();
+  assert(bucket.bucket);
+
+  return !bucket.score_offset
+    && bucket.reverse
+    && bucket.bucket->score_size() ==
+         std::make_pair(sizeof(float_t), alignof(float_t));
+}
+
+}
+
+namespace iresearch {
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                               top_docs_collector
+// ----------------------------------------------------------------------------
+
+top_docs_collector::top_docs_collector(
+    const order::prepared& order,
+    size_t limit)
+  : order_(&order),
+    scores_(limit*order.score_size(), 0),
+    limit_(limit),
+    prune_(can_prune(order)) {
+  entries_.reserve(limit_);
+}
+
+float_t top_docs_collector::threshold() const noexcept {
+  assert(prune_ && !entries_.empty() && heap_);
+  return order_->get<float_t>(entries_.front().score, 0);
+}
+
+void top_docs_collector::clear() noexcept {
+  entries_.clear();
+  heap_ = true;
+}
+
+size_t top_docs_collector::collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    const attribute_provider* ctx /*= nullptr*/) {
+  size_t count = 0;
+  size_t ordinal = 0;
+
+  for (auto& segment : index) {
+    count += collect(segment, ordinal++, filter, ctx);
+  }
+
+  return count;
+}
+
+size_t top_docs_collector::collect(
+    async_utils::thread_pool& pool,
+    const index_reader& index,
+    const filter::prepared& filter,
+    const attribute_provider* ctx /*= nullptr*/,
+    const search_progress_f& progress /*= {}*/) {
+  if (!limit_) {
+    return 0;
+  }
+
+  std::vector<std::unique_ptr<top_docs_collector>> collectors(index.size());
+  std::vector<size_t> counts(index.size());
+
+  parallel_for_each(
+    pool, index,
+    [&](const sub_reader& segment, size_t ordinal) {
+      auto& collector = collectors[ordinal];
+      collector = std::make_unique<top_docs_collector>(*order_, limit_);
+      counts[ordinal] = collector->collect(segment, ordinal, filter, ctx, progress);
+    },
+    progress);
+
+  size_t count = 0;
+
+  for (size_t i = 0, size = collectors.size(); i < size; ++i) {
+    if (collectors[i]) {
+      merge(*collectors[i]);
+      count += counts[i];
+    }
+  }
+
+  return count;
+}
+
+size_t top_docs_collector::collect(
+    const sub_reader& segment,
+    size_t ordinal,
+    const filter::prepared& filter,
+    const attribute_provider* ctx /*= nullptr*/) {
+  return collect(segment, ordinal, filter, ctx, search_progress_f{});
+}
+
+size_t top_docs_collector::collect(
+    const sub_reader& segment,
+    size_t ordinal,
+    const filter::prepared& filter,
+    const attribute_provider* ctx,
+    const search_progress_f& progress) {
+  if (!limit_) {
+    return 0;
+  }
+
+  make_heap();
+
+  auto docs = filter.execute(segment, *order_, ctx);
+  assert(docs);
+
+  // score (along with its bounds and bulk scorer) and frequency are taken
+  // from the query iterator itself, deleted documents are skipped by 'mask'
+  auto* score = irs::get_mutable<irs::score>(docs.get());
+  const bool has_freq = nullptr != irs::get<frequency>(*docs);
+  const bool prune = prune_ && score;
+
+  docs = segment.mask(std::move(docs));
+  assert(docs);
+
+  const auto* doc = irs::get<document>(*docs);
+  assert(doc);
+
+  if (prune && full()) {
+    const float_t min = threshold();
+
+    if (score->bounds.tail < min) {
+      // no document of the segment is competitive
+      return 0;
+    }
+
+    score->min(min);
+  }
+
+  size_t count = 0;
+
+  if (score && score->bulk && has_freq) {
+    // score blocks of documents at once, the iterator doesn't skip
+    // anything itself, so there is no need to feed the threshold back
+    constexpr size_t kBlockSize = bulk_score_function::kBlockSize;
+    doc_id_t block_docs[kBlockSize];
+    uint32_t block_freqs[kBlockSize];
+    float_t block_scores[kBlockSize];
+
+    for (;;) {
+      const size_t read = docs->next_batch(block_docs, block_freqs, kBlockSize);
+
+      if (!read) {
+        break;
+      }
+
+      score->bulk(block_docs, block_freqs, read, block_scores);
+
+      for (size_t i = 0; i < read; ++i) {
+        push(reinterpret_cast<const byte_type*>(block_scores + i),
+             ordinal, block_docs[i]);
+      }
+
+      const bool check = (count % kProgressStep) + read >= kProgressStep;
+      count += read;
+
+      if (read < kBlockSize || (progress && check && !progress())) {
+        break;
+      }
+    }
+
+    return count;
+  }
+
+  while (docs->next()) {
+    ++count;
+
+    if (progress && !(count % kProgressStep) && !progress()) {
+      break;
+    }
+
+    const byte_type* value = score ? score->evaluate() : nullptr;
+
+    if (push(value, ordinal, doc->value) && prune) {
+      score->min(threshold());
+    }
+  }
+
+  return count;
+}
+
+void top_docs_collector::merge(const top_docs_collector& other) {
+  assert(order_->score_size() == other.order_->score_size());
+
+  if (!limit_) {
+    return;
+  }
+
+  make_heap();
+
+  for (auto& entry : other.entries_) {
+    push(entry.score, entry.segment, entry.doc);
+  }
+}
+
+bool top_docs_collector::push(
+    const byte_type* value,
+    size_t ordinal,
+    doc_id_t doc) {
+  assert(heap_);
+
+  const auto less = [order = order_](const entry& lhs, const entry& rhs) {
+    return order->less(lhs.score, rhs.score);
+  };
+
+  const size_t score_size = order_->score_size();
+
+  auto copy_score = [score_size](const entry& dst, const byte_type* value) {
+    auto* buf = const_cast<byte_type*>(dst.score);
+
+    if (value) {
+      std::memcpy(buf, value, score_size);
+    } else {
+      std::memset(buf, 0, score_size);
+    }
+  };
+
+  if (!full()) {
+    auto& top = entries_.emplace_back(entry{
+      scores_.c_str() + entries_.size()*score_size, ordinal, doc });
+    copy_score(top, value);
+    std::push_heap(entries_.begin(), entries_.end(), less);
+
+    return full();
+  }
+
+  if (value && order_->less(value, entries_.front().score)) {
+    std::pop_heap(entries_.begin(), entries_.end(), less);
+    auto& top = entries_.back();
+    top.segment = ordinal;
+    top.doc = doc;
+    copy_score(top, value);
+    std::push_heap(entries_.begin(), entries_.end(), less);
+
+    return true;
+  }
+
+  return false;
+}
+
+void top_docs_collector::make_heap() {
+  if (!heap_) {
+    // 'entries_' was sorted by the previous call to 'sorted()'
+    std::make_heap(
+      entries_.begin(), entries_.end(),
+      [order = order_](const entry& lhs, const entry& rhs) {
+        return order->less(lhs.score, rhs.score);
+    });
+    heap_ = true;
+  }
+}
+
+const std::vector<top_docs_collector::entry>& top_docs_collector::sorted() {
+  if (heap_) {
+    std::sort_heap(
+      entries_.begin(), entries_.end(),
+      [order = order_](const entry& lhs, const entry& rhs) {
+        return order->less(lhs.score, rhs.score);
+    });
+    heap_ = false;
+  }
+
+  return entries_;
+}
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                        top_sorted_docs_collector
+// ----------------------------------------------------------------------------
+
+top_sorted_docs_collector::top_sorted_docs_collector(
+    const comparer& less,
+    const comparer* index_less,
+    size_t limit)
+  : less_(&less),
+    limit_(limit),
+    // any other comparer may order documents differently, even if the
+    // values are read from the sort column
+    index_order_(&less == index_less) {
+  entries_.reserve(limit_);
+}
+
+void top_sorted_docs_collector::clear() noexcept {
+  entries_.clear();
+  heap_ = true;
+}
+
+size_t top_sorted_docs_collector::collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    const attribute_provider* ctx /*= nullptr*/) {
+  size_t count = 0;
+  size_t ordinal = 0;
+
+  for (auto& segment : index) {
+    count += collect(segment, ordinal++, filter, ctx);
+  }
+
+  return count;
+}
+
+size_t top_sorted_docs_collector::collect(
+    const sub_reader& segment,
+    size_t ordinal,
+    const filter::prepared& filter,
+    const attribute_provider* ctx /*= nullptr*/) {
+  if (!limit_) {
+    return 0;
+  }
+
+  make_heap();
+
+  auto docs = segment.mask(
+    filter.execute(segment, order::prepared::unordered(), ctx));
+  assert(docs);
+
+  const auto* doc = irs::get<document>(*docs);
+  assert(doc);
+
+  doc_iterator::ptr values;
+  const payload* value = nullptr;
+
+  if (const auto* sort = segment.sort(); sort) {
+    values = sort->iterator(false);
+    value = values ? irs::get<payload>(*values) : nullptr;
+  }
+
+  size_t count = 0;
+
+  while (docs->next()) {
+    ++count;
+
+    bytes_ref key = bytes_ref::NIL;
+
+    if (value && doc->value == values->seek(doc->value)) {
+      key = value->value;
+    }
+
+    if (!competitive(key)) {
+      if (value && index_order_) {
+        // documents of a sorted segment follow in the order of the
+        // sort column, none of the remaining ones is competitive
+        break;
+      }
+
+      continue;
+    }
+
+    push(key, ordinal, doc->value);
+  }
+
+  return count;
+}
+
+bool top_sorted_docs_collector::competitive(const bytes_ref& key) const {
+  assert(heap_);
+  return !full() || (*less_)(key, entries_.front().key);
+}
+
+void top_sorted_docs_collector::push(
+    const bytes_ref& key,
+    size_t ordinal,
+    doc_id_t doc) {
+  assert(heap_);
+
+  const auto less = [cmp = less_](const entry& lhs, const entry& rhs) {
+    return (*cmp)(lhs.key, rhs.key);
+  };
+
+  if (!full()) {
+    entries_.emplace_back(entry{ bstring(key.c_str(), key.size()), ordinal, doc });
+  } else {
+    // reuse the buffer of the worst entry
+    std::pop_heap(entries_.begin(), entries_.end(), less);
+    auto& top = entries_.back();
+    top.key.assign(key.c_str(), key.size());
+    top.segment = ordinal;
+    top.doc = doc;
+  }
+
+  std::push_heap(entries_.begin(), entries_.end(), less);
+}
+
+void top_sorted_docs_collector::make_heap() {
+  if (!heap_) {
+    // 'entries_' was sorted by the previous call to 'sorted()'
+    std::make_heap(
+      entries_.begin(), entries_.end(),
+      [cmp = less_](const entry& lhs, const entry& rhs) {
+        return (*cmp)(lhs.key, rhs.key);
+    });
+    heap_ = true;
+  }
+}
+
+const std::vector<top_sorted_docs_collector::entry>&
+top_sorted_docs_collector::sorted() {
+  if (heap_) {
+    std::sort_heap(
+      entries_.begin(), entries_.end(),
+      [cmp = less_](const entry& lhs, const entry& rhs) {
+        return (*cmp)(lhs.key, rhs.key);
+    });
+    heap_ = false;
+  }
+
+  return entries_;
+}
+
+} // ROOT
@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_TOP_DOCS_COLLECTOR_H
+#define IRESEARCH_TOP_DOCS_COLLECTOR_H
+
+#include <vector>
+
+#include "filter.hpp"
+#include "parallel_search.hpp"
+#include "sort.hpp"
+#include "utils/noncopyable.hpp"
+#include "utils/string.hpp"
+
+namespace iresearch {
+
+class comparer;
+struct index_reader;
+struct sub_reader;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class top_docs_collector
+/// @brief collects at most 'limit' best matching documents of a prepared filter
+///        according to a specified order across all segments of an index
+/// @note if order consists of a single descending 'float_t' scorer the
+///       score of the worst collected document is fed back to the iterators
+///       via 'score::min(...)', so that pruning-capable iterators are able
+///       to skip non-competitive documents
+////////////////////////////////////////////////////////////////////////////////
+class top_docs_collector : private util::noncopyable {
+ public:
+  struct entry {
+    const byte_type* score; // score buffer of a document, valid until 'clear()'
+    size_t segment; // ordinal of a segment in a reader
+    doc_id_t doc; // document id within a segment
+  }; // entry
+
+  top_docs_collector(const order::prepared& order, size_t limit);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief executes 'filter' against every segment of the specified 'index'
+  /// @returns number of visited documents
+  //////////////////////////////////////////////////////////////////////////////
+  size_t collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    const attribute_provider* ctx = nullptr);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief executes 'filter' against the specified 'segment'
+  /// @param ordinal ordinal of a segment reported by the collected entries
+  /// @returns number of visited documents
+  //////////////////////////////////////////////////////////////////////////////
+  size_t collect(
+    const sub_reader& segment,
+    size_t ordinal,
+    const filter::prepared& filter,
+    const attribute_provider* ctx = nullptr);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief executes 'filter' against segments of the specified 'index' in
+  ///        parallel on the threads of 'pool', every segment is collected
+  ///        into a separate collector, results are merged into this one
+  /// @param progress checked periodically during execution, collection is
+  ///        stopped as soon as it returns false, i.e. only a part of the
+  ///        matching documents may be collected
+  /// @returns number of visited documents
+  /// @note 'filter' and 'ctx' are accessed concurrently
+  //////////////////////////////////////////////////////////////////////////////
+  size_t collect(
+    async_utils::thread_pool& pool,
+    const index_reader& index,
+    const filter::prepared& filter,
+    const attribute_provider* ctx = nullptr,
+    const search_progress_f& progress = {});
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief merges entries collected by 'other' into this collector
+  /// @note both collectors must share the same order
+  //////////////////////////////////////////////////////////////////////////////
+  void merge(const top_docs_collector& other);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns collected entries ordered from the best to the worst one
+  /// @note collector remains valid for further collection
+  //////////////////////////////////////////////////////////////////////////////
+  const std::vector<entry>& sorted();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief resets collector to the initial state without releasing memory
+  //////////////////////////////////////////////////////////////////////////////
+  void clear() noexcept;
+
+  size_t limit() const noexcept { return limit_; }
+  size_t size() const noexcept { return entries_.size(); }
+  bool empty() const noexcept { return entries_.empty(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns true if the current threshold is fed back to the iterators
+  //////////////////////////////////////////////////////////////////////////////
+  bool prunes() const noexcept { return prune_; }
+
+ private:
+  // number of documents between two subsequent progress checks
+  static constexpr size_t kProgressStep = 1024;
+
+  size_t collect(
+    const sub_reader& segment,
+    size_t ordinal,
+    const filter::prepared& filter,
+    const attribute_provider* ctx,
+    const search_progress_f& progress);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief adds a document with a given score if it is competitive
+  /// @returns true if the threshold has been changed
+  //////////////////////////////////////////////////////////////////////////////
+  bool push(const byte_type* value, size_t ordinal, doc_id_t doc);
+
+  bool full() const noexcept { return entries_.size() == limit_; }
+  float_t threshold() const noexcept;
+  void make_heap();
+
+  const order::prepared* order_;
+  std::vector<entry> entries_; // heap, the worst entry is on top
+  bstring scores_; // preallocated score buffers of the entries
+  size_t limit_;
+  bool prune_;
+  bool heap_{true}; // 'entries_' is a heap
+}; // top_docs_collector
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class top_sorted_docs_collector
+/// @brief collects at most 'limit' matching documents of a prepared filter
+///        with the smallest values of the sort column according to a
+///        specified comparer across all segments of an index
+/// @note if the specified comparer is the one the index was created with
+///       via 'init_options::comparator', documents of a segment having a
+///       sort column are physically ordered by it, hence the segment is no
+///       longer visited once a matched document isn't competitive,
+///       otherwise all matched documents of the segment are visited
+/// @note missing values are treated as 'bytes_ref::NIL' the same way as
+///       while flushing a sorted segment
+////////////////////////////////////////////////////////////////////////////////
+class top_sorted_docs_collector : private util::noncopyable {
+ public:
+  struct entry {
+    bstring key; // value of the sort column
+    size_t segment; // ordinal of a segment in a reader
+    doc_id_t doc; // document id within a segment
+  }; // entry
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param less order of the collected documents
+  /// @param index_less comparer the index was created with via
+  ///        'init_options::comparator', nullptr if the index isn't sorted
+  /// @param limit max number of the collected documents
+  //////////////////////////////////////////////////////////////////////////////
+  top_sorted_docs_collector(
+    const comparer& less,
+    const comparer* index_less,
+    size_t limit);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief executes 'filter' against every segment of the specified 'index'
+  /// @returns number of visited documents
+  //////////////////////////////////////////////////////////////////////////////
+  size_t collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    const attribute_provider* ctx = nullptr);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief executes 'filter' against the specified 'segment'
+  /// @param ordinal ordinal of a segment reported by the collected entries
+  /// @returns number of visited documents
+  //////////////////////////////////////////////////////////////////////////////
+  size_t collect(
+    const sub_reader& segment,
+    size_t ordinal,
+    const filter::prepared& filter,
+    const attribute_provider* ctx = nullptr);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns collected entries ordered from the best to the worst one
+  /// @note collector remains valid for further collection
+  //////////////////////////////////////////////////////////////////////////////
+  const std::vector<entry>& sorted();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief resets collector to the initial state
+  //////////////////////////////////////////////////////////////////////////////
+  void clear() noexcept;
+
+  size_t limit() const noexcept { return limit_; }
+  size_t size() const noexcept { return entries_.size(); }
+  bool empty() const noexcept { return entries_.empty(); }
+
+ private:
+  bool full() const noexcept { return entries_.size() == limit_; }
+  bool competitive(const bytes_ref& key) const;
+  void push(const bytes_ref& key, size_t ordinal, doc_id_t doc);
+  void make_heap();
+
+  const comparer* less_;
+  std::vector<entry> entries_; // heap, the worst entry is on top
+  size_t limit_;
+  bool index_order_; // 'less_' is the order of sorted segments
+  bool heap_{true}; // 'entries_' is a heap
+}; // top_sorted_docs_collector
+
+} // ROOT
+
+#endif // IRESEARCH_TOP_DOCS_COLLECTOR_H
@@ -29,6 +29,7 @@
 #include "search/prefix_filter.hpp"
 #include "index/index_reader.hpp"
 #include "utils/wildcard_utils.hpp"
+#include "utils/automaton_cache.hpp"
 #include "utils/automaton_utils.hpp"
 #include "utils/hash_utils.hpp"
 
@@ -129,17 +130,17 @@ field_visitor by_wildcard::visitor(bytes_ref term) {
     [](bytes_ref term) -> field_visitor{
       struct automaton_context : util::noncopyable {
         automaton_context(bytes_ref term)
-          : acceptor(from_wildcard(term)),
-            matcher(make_automaton_matcher(acceptor)) {
+          : acceptor(automaton_cache::instance().wildcard(term)),
+            matcher(make_automaton_matcher(*acceptor, false)) {
         }
 
-        automaton acceptor;
+        automaton_cache::automaton_ptr acceptor;
         automaton_table_matcher matcher;
       };
 
       auto ctx = memory::make_shared<automaton_context>(term);
 
-      if (!validate(ctx->acceptor)) {
+      if (!validate(*ctx->acceptor, false)) {
         return [](const sub_reader&, const term_reader&, filter_visitor&) { };
       }
 
@@ -173,8 +174,10 @@ field_visitor by_wildcard::visitor(bytes_ref term) {
       return by_prefix::prepare(index, order, boost, field, term, scored_terms_limit);
     },
     [&index, &order, boost, &field, scored_terms_limit](bytes_ref term) -> filter::prepared::ptr {
-      return prepare_automaton_filter(field, from_wildcard(term), scored_terms_limit,
-                                      index, order, boost);
+      const auto acceptor = automaton_cache::instance().wildcard(term);
+
+      return prepare_automaton_filter(field, *acceptor, scored_terms_limit,
+                                      index, order, boost, false);
     }
   );
 }
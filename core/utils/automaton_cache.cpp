@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "automaton_cache.hpp"
+
+#include <cstring>
+
+#include "utils/automaton_utils.hpp"
+#include "utils/levenshtein_utils.hpp"
+#include "utils/wildcard_utils.hpp"
+
+namespace {
+
+using namespace irs;
+
+// tags distinguishing keys of different kinds of automata
+constexpr byte_type kWildcard = 0;
+constexpr byte_type kLevenshtein = 1;
+
+// approximate memory footprint of an automaton
+size_t bytes(const automaton& acceptor) noexcept {
+  using state_t = fst::fsa::AutomatonState<fst::fsa::BooleanWeight>;
+
+  size_t bytes = sizeof(automaton);
+
+  for (fst::StateIterator<automaton> it(acceptor); !it.Done(); it.Next()) {
+    bytes += sizeof(state_t*) + sizeof(state_t)
+      + acceptor.NumArcs(it.Value()) * sizeof(automaton::Arc);
+  }
+
+  return bytes;
+}
+
+template<typename T>
+void append(bstring& buf, const T& value) {
+  buf.append(reinterpret_cast<const byte_type*>(&value), sizeof value);
+}
+
+} // LOCAL
+
+namespace iresearch {
+
+/*static*/ automaton_cache& automaton_cache::instance() {
+  static automaton_cache cache;
+  return cache;
+}
+
+automaton_cache::automaton_cache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+automaton_cache::~automaton_cache() = default;
+
+template<typename Factory>
+automaton_cache::automaton_ptr automaton_cache::get(
+    bytes_ref key, Factory&& factory) {
+  const auto id = make_hashed_ref(key);
+
+  if (auto acceptor = find(id); acceptor) {
+    return acceptor;
+  }
+
+  // build outside of the lock, concurrent misses of the same key may
+  // build the same automaton more than once
+  auto acceptor = std::make_shared<automaton>(factory());
+
+  // evaluate properties before publishing, a shared automaton
+  // mustn't be mutated, including its cached properties
+  acceptor->Properties(automaton_table_matcher::FST_PROPERTIES, true);
+
+  put(id, acceptor);
+
+  return acceptor;
+}
+
+automaton_cache::automaton_ptr automaton_cache::wildcard(bytes_ref expr) {
+  bstring key;
+  key.reserve(1 + expr.size());
+  key += kWildcard;
+  key.append(expr.c_str(), expr.size());
+
+  return get(key, [expr]() { return from_wildcard(expr); });
+}
+
+automaton_cache::automaton_ptr automaton_cache::levenshtein(
+    const parametric_description& description,
+    bool with_transpositions,
+    bytes_ref prefix,
+    bytes_ref target) {
+  const auto prefix_size = prefix.size();
+
+  bstring key;
+  key.reserve(3 + sizeof prefix_size + prefix.size() + target.size());
+  key += kLevenshtein;
+  key += description.max_distance();
+  key += static_cast<byte_type>(with_transpositions);
+  ::append(key, prefix_size);
+  key.append(prefix.c_str(), prefix.size());
+  key.append(target.c_str(), target.size());
+
+  return get(key, [&description, prefix, target]() {
+    return make_levenshtein_automaton(description, prefix, target);
+  });
+}
+
+automaton_cache::automaton_ptr automaton_cache::find(
+    const hashed_bytes_ref& key) {
+  std::lock_guard lock{mutex_};
+
+  const auto it = map_.find(key);
+
+  if (it == map_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+
+  // mark entry as the most recently used one
+  entries_.splice(entries_.begin(), entries_, it->second);
+  ++hits_;
+
+  return it->second->acceptor;
+}
+
+void automaton_cache::put(
+    const hashed_bytes_ref& key,
+    automaton_ptr acceptor) {
+  assert(acceptor);
+  const size_t bytes = key.size() + ::bytes(*acceptor);
+
+  std::lock_guard lock{mutex_};
+
+  if (bytes > max_bytes_) {
+    return;
+  }
+
+  if (const auto it = map_.find(key); it != map_.end()) {
+    // concurrently built entry
+    erase(it->second);
+  }
+
+  evict(max_bytes_ - bytes);
+
+  auto& entry = entries_.emplace_front(
+    automaton_cache::entry{bstring(key), std::move(acceptor), bytes});
+  map_.emplace(hashed_bytes_ref(key.hash(), entry.key), entries_.begin());
+  bytes_ += bytes;
+}
+
+void automaton_cache::erase(entries::iterator it) {
+  map_.erase(make_hashed_ref(bytes_ref(it->key)));
+  assert(bytes_ >= it->bytes);
+  bytes_ -= it->bytes;
+  entries_.erase(it);
+}
+
+void automaton_cache::evict(size_t max_bytes) {
+  while (bytes_ > max_bytes) {
+    assert(!entries_.empty());
+    erase(std::prev(entries_.end()));
+  }
+}
+
+void automaton_cache::clear() {
+  std::lock_guard lock{mutex_};
+  map_.clear();
+  entries_.clear();
+  bytes_ = 0;
+}
+
+void automaton_cache::max_bytes(size_t max_bytes) {
+  std::lock_guard lock{mutex_};
+  max_bytes_ = max_bytes;
+  evict(max_bytes_);
+}
+
+size_t automaton_cache::max_bytes() const noexcept {
+  std::lock_guard lock{mutex_};
+  return max_bytes_;
+}
+
+size_t automaton_cache::bytes() const noexcept {
+  std::lock_guard lock{mutex_};
+  return bytes_;
+}
+
+size_t automaton_cache::size() const noexcept {
+  std::lock_guard lock{mutex_};
+  return entries_.size();
+}
+
+uint64_t automaton_cache::hits() const noexcept {
+  std::lock_guard lock{mutex_};
+  return hits_;
+}
+
+uint64_t automaton_cache::misses() const noexcept {
+  std::lock_guard lock{mutex_};
+  return misses_;
+}
+
+} // ROOT
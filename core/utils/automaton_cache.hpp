@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "utils/automaton_decl.hpp"
+#include "utils/hash_utils.hpp"
+#include "utils/noncopyable.hpp"
+#include "utils/string.hpp"
+
+namespace iresearch {
+
+class parametric_description;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief memory-bounded cache of compiled (determinized) automata shared
+/// across queries and readers, e.g. by wildcard and Levenshtein filters.
+/// Entries are keyed by a pattern along with the options it was compiled
+/// with, least recently used entries are evicted once the byte budget is
+/// exceeded.
+/// Properties of a cached automaton are evaluated before it's published,
+/// i.e. it must be accessed without testing properties afterwards.
+/// @note the implementation is thread-safe
+//////////////////////////////////////////////////////////////////////////////
+class automaton_cache : private util::noncopyable {
+ public:
+  using automaton_ptr = std::shared_ptr<const automaton>;
+
+  static constexpr size_t kDefaultMaxBytes = 16 * (size_t(1) << 20);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns process-wide cache instance
+  //////////////////////////////////////////////////////////////////////////////
+  static automaton_cache& instance();
+
+  explicit automaton_cache(size_t max_bytes = kDefaultMaxBytes);
+  ~automaton_cache();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns automaton accepting wildcard 'expr', see 'from_wildcard(...)'
+  //////////////////////////////////////////////////////////////////////////////
+  automaton_ptr wildcard(bytes_ref expr);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns automaton accepting words within the distance denoted by the
+  ///          parametric 'description' from 'prefix' + 'target', see
+  ///          'make_levenshtein_automaton(...)'
+  /// @note 'description' is identified by its max distance and
+  ///       'with_transpositions' it was built with, i.e. descriptions of
+  ///       the same parameters are expected to be equal
+  //////////////////////////////////////////////////////////////////////////////
+  automaton_ptr levenshtein(const parametric_description& description,
+                            bool with_transpositions,
+                            bytes_ref prefix, bytes_ref target);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes all entries
+  //////////////////////////////////////////////////////////////////////////////
+  void clear();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sets the byte budget, evicts entries if necessary,
+  ///        0 disables caching
+  //////////////////////////////////////////////////////////////////////////////
+  void max_bytes(size_t max_bytes);
+  size_t max_bytes() const noexcept;
+
+  size_t bytes() const noexcept;
+  size_t size() const noexcept;
+  uint64_t hits() const noexcept;
+  uint64_t misses() const noexcept;
+
+ private:
+  struct entry {
+    bstring key;
+    automaton_ptr acceptor;
+    size_t bytes;
+  };
+
+  using entries = std::list<entry>;
+  using entries_map = absl::flat_hash_map<hashed_bytes_ref, entries::iterator>;
+
+  template<typename Factory>
+  automaton_ptr get(bytes_ref key, Factory&& factory);
+
+  automaton_ptr find(const hashed_bytes_ref& key);
+  void put(const hashed_bytes_ref& key, automaton_ptr acceptor);
+  void erase(entries::iterator it);
+  void evict(size_t max_bytes);
+
+  mutable std::mutex mutex_;
+  entries entries_; // most recently used entry goes first
+  entries_map map_; // keys refer to 'entry::key'
+  size_t max_bytes_;
+  size_t bytes_{};
+  uint64_t hits_{};
+  uint64_t misses_{};
+}; // automaton_cache
+
+} // ROOT
@@ -508,6 +508,8 @@ inline automaton make_all() {
 /// @param index index reader
 /// @param order compiled order
 /// @param bool query boost
+/// @param test_props test properties of 'acceptor', must be false for
+///        automata shared across threads, e.g. the ones of 'automaton_cache'
 /// @returns compiled filter
 //////////////////////////////////////////////////////////////////////////////
 filter::prepared::ptr prepare_automaton_filter(
@@ -516,7 +518,8 @@ filter::prepared::ptr prepare_automaton_filter(
   size_t scored_terms_limit,
   const index_reader& index,
   const order::prepared& order,
-  boost_t boost);
+  boost_t boost,
+  bool test_props = TEST_AUTOMATON_PROPS);
 
 }
 
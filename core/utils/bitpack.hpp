@@ -23,11 +23,16 @@
 #ifndef IRESEARCH_BITPACK_H
 #define IRESEARCH_BITPACK_H
 
+#include <bit>
+#include <limits>
+
 #include "shared.hpp"
 #include "store/data_output.hpp"
 #include "store/data_input.hpp"
 
-#include "utils/simd_utils.hpp"
+#include "utils/bit_packing.hpp"
+#include "utils/bit_utils.hpp"
+#include "utils/simd_dispatch.hpp"
 
 namespace iresearch {
 
@@ -47,12 +52,36 @@ namespace iresearch {
 //   </BlockHeader>
 //   </PackedData>
 //
+// Patched (PFOR) block, written by 'write_block32_patched' only:
+//   <BlockHeader>
+//     </NumberOfBits | PATCHED>
+//     </NumberOfExceptions>
+//   </BlockHeader>
+//   </PackedData>  -- lower 'NumberOfBits' bits of each element
+//   <Exceptions>
+//     </Position></HighBits> -- byte, vint
+//   </Exceptions>
+//
+// Bitmap block of positive deltas, written by 'write_block32_dense' only:
+//   <BlockHeader>
+//     </BITMAP>
+//     </NumberOfWords>
+//   </BlockHeader>
+//   </Words> -- 64 bit words, bit 'i' is set if a prefix sum of the
+//               deltas equals to 'i'
+//
 // ----------------------------------------------------------------------------
 
 namespace bitpack {
 
 constexpr uint32_t ALL_EQUAL = 0U;
 
+// flag of a block header denoting a patched block
+constexpr uint32_t PATCHED = 0x80U;
+
+// header of a bitmap block
+constexpr uint32_t BITMAP = 0x40U;
+
 // returns true if one can use run length encoding for the specified numberof bits
 constexpr bool rl(const uint32_t bits) noexcept {
   return ALL_EQUAL == bits;
@@ -99,18 +128,13 @@ uint32_t write_block32(
   assert(encoded);
   assert(decoded);
 
-  if (simd::all_equal<false>(decoded, size)) {
+  if (simd::dispatch::all_equal(decoded, size)) {
     out.write_byte(ALL_EQUAL);
     out.write_vint(*decoded);
     return ALL_EQUAL;
   }
 
-  // prior AVX2 scalar version works faster for 32-bit values
-#ifdef HWY_CAP_GE256
-  const uint32_t bits = simd::maxbits<false>(decoded, size);
-#else
-  const uint32_t bits = packed::maxbits32(decoded, decoded + size);
-#endif
+  const uint32_t bits = simd::dispatch::maxbits(decoded, size);
   assert(bits);
 
   const size_t buf_size = packed::bytes_required_32(size, bits);
@@ -137,18 +161,13 @@ uint32_t write_block32(
   assert(encoded);
   assert(decoded);
 
-  if (simd::all_equal<false>(decoded, Size)) {
+  if (simd::dispatch::all_equal(decoded, Size)) {
     out.write_byte(ALL_EQUAL);
     out.write_vint(*decoded);
     return ALL_EQUAL;
   }
 
-  // prior AVX2 scalar version works faster for 32-bit values
-#ifdef HWY_CAP_GE256
-  const uint32_t bits = simd::maxbits<Size, false>(decoded);
-#else
-  const uint32_t bits = packed::maxbits32(decoded, decoded + Size);
-#endif
+  const uint32_t bits = simd::dispatch::maxbits(decoded, Size);
   assert(bits);
 
   const size_t buf_size = packed::bytes_required_32(Size, bits);
@@ -176,7 +195,7 @@ uint32_t write_block64(
   assert(encoded);
   assert(decoded);
 
-  if (simd::all_equal<false>(decoded, size)) {
+  if (simd::dispatch::all_equal(decoded, size)) {
     out.write_byte(ALL_EQUAL);
     out.write_vint(*decoded);
     return ALL_EQUAL;
@@ -337,6 +356,311 @@ void read_block64(
   }
 }
 
+// returns number of bits to pack a block of 'Size' 32 bit integers with,
+// values not fitting into them are stored separately as exceptions,
+// 'max_bits' is returned if a block isn't worth patching, the size of
+// the packed data along with the exceptions is stored to 'block_size'
+template<size_t Size>
+uint32_t patch_bits(const uint32_t* decoded, uint32_t max_bits,
+                    size_t* block_size = nullptr) noexcept {
+  static_assert(Size && Size < 256); // position and number of exceptions are bytes
+  assert(max_bits && max_bits <= bits_required<uint32_t>());
+
+  size_t widths[bits_required<uint32_t>() + 1]{};
+  for (size_t i = 0; i < Size; ++i) {
+    ++widths[bits_required<uint32_t>() - std::countl_zero(decoded[i])];
+  }
+
+  uint32_t best_bits = max_bits;
+  size_t best_size = packed::bytes_required_32(Size, max_bits);
+
+  for (uint32_t bits = 1; bits < max_bits; ++bits) {
+    size_t size = 1 + packed::bytes_required_32(Size, bits); // + exceptions count
+
+    for (uint32_t width = bits + 1; width <= max_bits; ++width) {
+      // position + vint of the remaining 'width - bits' bits
+      size += widths[width] * (1 + (width - bits + 6) / 7);
+    }
+
+    if (size < best_size) {
+      best_size = size;
+      best_bits = bits;
+    }
+  }
+
+  if (block_size) {
+    *block_size = best_size;
+  }
+
+  return best_bits;
+}
+
+// writes block of 'Size' 32 bit integers to a stream
+//   all values are equal -> RL encoding,
+//   few outliers         -> bit packing of lower bits + exceptions (PFOR),
+//   otherwise            -> bit packing
+// returns number of bits used to encoded the block (0 == RL)
+template<size_t Size, typename PackFunc>
+uint32_t write_block32_patched(
+    PackFunc&& pack,
+    data_output& out,
+    const uint32_t* RESTRICT decoded,
+    uint32_t* RESTRICT encoded) {
+  static_assert(Size);
+  assert(encoded);
+  assert(decoded);
+
+  if (simd::dispatch::all_equal(decoded, Size)) {
+    out.write_byte(ALL_EQUAL);
+    out.write_vint(*decoded);
+    return ALL_EQUAL;
+  }
+
+  const uint32_t max_bits = simd::dispatch::maxbits(decoded, Size);
+  const uint32_t bits = patch_bits<Size>(decoded, max_bits);
+  assert(bits && bits <= max_bits);
+
+  const size_t buf_size = packed::bytes_required_32(Size, bits);
+  std::memset(encoded, 0, buf_size);
+
+  if (bits == max_bits) {
+    pack(decoded, encoded, bits);
+
+    out.write_byte(static_cast<byte_type>(bits & 0xFF));
+    out.write_bytes(reinterpret_cast<byte_type*>(encoded), buf_size);
+
+    return bits;
+  }
+
+  const uint32_t mask = (uint32_t(1) << bits) - 1;
+  uint32_t lower[Size];
+  byte_type exceptions = 0;
+  for (size_t i = 0; i < Size; ++i) {
+    lower[i] = decoded[i] & mask;
+    exceptions += byte_type(lower[i] != decoded[i]);
+  }
+  pack(lower, encoded, bits);
+
+  out.write_byte(static_cast<byte_type>(bits | PATCHED));
+  out.write_byte(exceptions);
+  out.write_bytes(reinterpret_cast<byte_type*>(encoded), buf_size);
+  for (size_t i = 0; i < Size; ++i) {
+    if (lower[i] != decoded[i]) {
+      out.write_byte(static_cast<byte_type>(i));
+      out.write_vint(decoded[i] >> bits);
+    }
+  }
+
+  return bits;
+}
+
+// reads block of 'Size' 32 bit integers from the stream
+// that was previously encoded with the corresponding
+// 'write_block32_patched' function, 'header' is already read
+template<size_t Size, typename UnpackFunc>
+void read_block32_patched(
+    UnpackFunc&& unpack,
+    data_input& in,
+    uint32_t header,
+    uint32_t* RESTRICT encoded,
+    uint32_t* RESTRICT decoded) {
+  static_assert(Size);
+  assert(encoded);
+  assert(decoded);
+
+  if (ALL_EQUAL == header) {
+    std::fill_n(decoded, Size, in.read_vint());
+    return;
+  }
+
+  const uint32_t bits = header & ~PATCHED;
+  const uint32_t exceptions = (header & PATCHED) ? in.read_byte() : 0;
+  const size_t required = packed::bytes_required_32(Size, bits);
+
+  if (const auto* buf = in.read_buffer(required, BufferHint::NORMAL); buf) {
+    unpack(decoded, reinterpret_cast<const uint32_t*>(buf), bits);
+  } else {
+#ifdef IRESEARCH_DEBUG
+    const auto read = in.read_bytes(
+      reinterpret_cast<byte_type*>(encoded),
+      required);
+    assert(read == required);
+    UNUSED(read);
+#else
+    in.read_bytes(
+      reinterpret_cast<byte_type*>(encoded),
+      required);
+#endif // IRESEARCH_DEBUG
+
+    unpack(decoded, encoded, bits);
+  }
+
+  // patch exceptions
+  for (uint32_t i = 0; i < exceptions; ++i) {
+    const size_t pos = in.read_byte();
+    assert(pos < Size);
+    decoded[pos] |= in.read_vint() << bits;
+  }
+}
+
+// reads block of 'Size' 32 bit integers from the stream
+// that was previously encoded with the corresponding
+// 'write_block32_patched' function
+template<size_t Size, typename UnpackFunc>
+void read_block32_patched(
+    UnpackFunc&& unpack,
+    data_input& in,
+    uint32_t* RESTRICT encoded,
+    uint32_t* RESTRICT decoded) {
+  const uint32_t header = in.read_byte();
+  read_block32_patched<Size>(std::forward<UnpackFunc>(unpack),
+                             in, header, encoded, decoded);
+}
+
+// skip block of the specified size that was previously
+// written with the corresponding 'write_block32_patched' function,
+// 'header' is already read
+inline void skip_block32_patched(index_input& in, uint32_t header,
+                                 uint32_t size) {
+  assert(size);
+
+  if (ALL_EQUAL == header) {
+    in.read_vint();
+    return;
+  }
+
+  const uint32_t exceptions = (header & PATCHED) ? in.read_byte() : 0;
+  in.seek(in.file_pointer() + packed::bytes_required_32(size, header & ~PATCHED));
+
+  for (uint32_t i = 0; i < exceptions; ++i) {
+    in.read_byte();
+    in.read_vint();
+  }
+}
+
+// skip block of the specified size that was previously
+// written with the corresponding 'write_block32_patched' function
+inline void skip_block32_patched(index_input& in, uint32_t size) {
+  const uint32_t header = in.read_byte();
+  skip_block32_patched(in, header, size);
+}
+
+// writes block of 'Size' 32 bit deltas to a stream, all but the first
+// delta are expected to be positive
+//   dense deltas -> bitmap of their prefix sums,
+//   otherwise    -> see 'write_block32_patched'
+// the bitmap is chosen only if it's smaller than the alternatives
+// returns number of bits used to encoded the block (0 == RL, BITMAP)
+template<size_t Size, typename PackFunc>
+uint32_t write_block32_dense(
+    PackFunc&& pack,
+    data_output& out,
+    const uint32_t* RESTRICT decoded,
+    uint32_t* RESTRICT encoded) {
+  static_assert(Size);
+  assert(encoded);
+  assert(decoded);
+
+  // contiguous deltas are cheaper to store as RL
+  if (!simd::dispatch::all_equal(decoded, Size)) {
+    uint64_t span = decoded[0];
+    bool positive = true;
+    for (size_t i = 1; i < Size; ++i) {
+      positive &= (0 != decoded[i]);
+      span += decoded[i];
+    }
+
+    constexpr size_t WORD_BITS = bits_required<uint64_t>();
+    const size_t words = span / WORD_BITS + 1;
+
+    // number of words is a byte
+    if (positive && words <= std::numeric_limits<byte_type>::max()) {
+      const uint32_t max_bits = simd::dispatch::maxbits(decoded, Size);
+      size_t block_size;
+      patch_bits<Size>(decoded, max_bits, &block_size);
+
+      if (1 + words*sizeof(uint64_t) < block_size) {
+        uint64_t word = 0;
+        uint64_t value = 0; // prefix sum
+        size_t word_idx = 0;
+
+        out.write_byte(static_cast<byte_type>(BITMAP));
+        out.write_byte(static_cast<byte_type>(words));
+        for (size_t i = 0; i < Size; ++i) {
+          value += decoded[i];
+          for (; value / WORD_BITS != word_idx; ++word_idx) {
+            out.write_long(static_cast<int64_t>(word));
+            word = 0;
+          }
+          word |= uint64_t(1) << (value % WORD_BITS);
+        }
+        out.write_long(static_cast<int64_t>(word));
+        assert(word_idx + 1 == words);
+
+        return BITMAP;
+      }
+    }
+  }
+
+  return write_block32_patched<Size>(std::forward<PackFunc>(pack),
+                                     out, decoded, encoded);
+}
+
+// reads block of 'Size' 32 bit deltas from the stream that was
+// previously encoded with the corresponding 'write_block32_dense'
+// function, words of a bitmap block are passed to 'visitor' as they're
+// read, in this case 'decoded' is left intact and 'true' is returned
+template<size_t Size, typename UnpackFunc, typename Visitor>
+bool visit_block32_dense(
+    UnpackFunc&& unpack,
+    data_input& in,
+    uint32_t* RESTRICT encoded,
+    uint32_t* RESTRICT decoded,
+    Visitor&& visitor) {
+  const uint32_t header = in.read_byte();
+
+  if (BITMAP == header) {
+    for (size_t words = in.read_byte(); words; --words) {
+      visitor(static_cast<uint64_t>(in.read_long()));
+    }
+    return true;
+  }
+
+  read_block32_patched<Size>(std::forward<UnpackFunc>(unpack),
+                             in, header, encoded, decoded);
+  return false;
+}
+
+// reads block of 'Size' 32 bit deltas from the stream that was
+// previously encoded with the corresponding 'write_block32_dense'
+// function
+template<size_t Size, typename UnpackFunc>
+void read_block32_dense(
+    UnpackFunc&& unpack,
+    data_input& in,
+    uint32_t* RESTRICT encoded,
+    uint32_t* RESTRICT decoded) {
+  constexpr uint32_t WORD_BITS = bits_required<uint64_t>();
+
+  uint32_t* delta = decoded;
+  uint32_t* end = decoded + Size;
+  uint32_t base = 0; // prefix sum denoted by the lowest bit of a word
+  uint32_t prev = 0; // previous prefix sum
+
+  visit_block32_dense<Size>(
+    std::forward<UnpackFunc>(unpack), in, encoded, decoded,
+    [&](uint64_t word) noexcept {
+      for (; word && delta != end; word &= word - 1) {
+        const uint32_t value = base + std::countr_zero(word);
+        *delta++ = value - prev;
+        prev = value;
+      }
+      base += WORD_BITS;
+  });
+
+  assert(delta == decoded || delta == end);
+}
+
 } // bitpack
 } // iresearch
 
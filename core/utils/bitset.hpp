@@ -178,6 +178,14 @@ class dynamic_bitset : public dynamic_bitset_base<Alloc> {
     set_bit(data_[word(i)], bit(i));
   }
 
+  // sets all bits
+  void set() noexcept {
+    if (data_) {
+      std::memset(data_.get(), 0xFF, sizeof(word_t)*words_);
+      sanitize();
+    }
+  }
+
   void unset(size_t i) noexcept {
     unset_bit(data_[word(i)], bit(i));
   }
@@ -22,12 +22,23 @@
 
 #include "cpuinfo.hpp"
 
-#if defined(_MSC_VER)
+#include <hwy/targets.h>
 
+#if defined(_MSC_VER)
 #include "bit_utils.hpp"
+#endif
 
 namespace iresearch {
 
+/*static*/ const char* cpuinfo::simd_target() noexcept {
+  // same as the best target 'HWY_DYNAMIC_DISPATCH' chooses, lower bits
+  // denote better targets
+  const uint32_t targets = hwy::SupportedTargets() & HWY_TARGETS;
+  return hwy::TargetName(targets & ~(targets - 1));
+}
+
+#if defined(_MSC_VER)
+
 const cpuinfo cpuinfo::instance_;
 
 /*static*/ bool cpuinfo::support_popcnt() {
@@ -35,6 +46,6 @@ const cpuinfo cpuinfo::instance_;
   return check_bit<23>(instance_.f1_cpuinfo_[2]);
 }
 
-}
-
 #endif
+
+}
@@ -23,15 +23,24 @@
 #ifndef IRESEARCH_CPUID_ID
 #define IRESEARCH_CPUID_ID
 
-#if defined(_MSC_VER)
-
 #include "shared.hpp"
+
+#if defined(_MSC_VER)
 #include <intrin.h>
+#endif
 
 namespace iresearch {
 
 class cpuinfo {
  public:
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns name of the instruction set the SIMD kernels dispatched at
+  ///          runtime use on the current CPU, e.g. "AVX2",
+  ///          see 'simd_dispatch.hpp'
+  ////////////////////////////////////////////////////////////////////////////
+  static const char* simd_target() noexcept;
+
+#if defined(_MSC_VER)
   static bool support_popcnt();
  private:
   static const cpuinfo instance_;
@@ -41,10 +50,9 @@ class cpuinfo {
   }
 
   int f1_cpuinfo_[4];
+#endif
 };
 
 }
 
 #endif
-
-#endif
@@ -25,6 +25,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "shared.hpp"
 #include "ebo.hpp"
@@ -145,6 +146,145 @@ class freelist : private util::noncopyable {
   slot* head_{};
 }; // freelist
 
+///////////////////////////////////////////////////////////////////////////////
+/// @class pooled_object
+/// @brief base class for objects of type 'T' which memory is recycled via a
+///        bounded per-thread free list rather than returned to the heap,
+///        intended for objects repeatedly created and destroyed during query
+///        execution, e.g. doc iterators
+/// @note memory is recycled by a thread destroying an object, i.e. objects
+///       may be created and destroyed on different threads, objects of
+///       classes derived from 'T' are allocated on the heap as usual
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, size_t Capacity = 32>
+class pooled_object {
+ public:
+  static void* operator new(size_t size) {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "over-aligned types are not supported");
+    static_assert(sizeof(T) >= freelist::MIN_SIZE);
+
+    if (size == sizeof(T)) {
+      if (auto* cache = cache::get(); cache && cache->size) {
+        --cache->size;
+        return cache->slots.pop();
+      }
+    }
+
+    return ::operator new(size);
+  }
+
+  static void operator delete(void* p, size_t size) noexcept {
+    if (size == sizeof(T)) {
+      if (auto* cache = cache::get(); cache && cache->size < Capacity) {
+        cache->slots.push(p);
+        ++cache->size;
+        return;
+      }
+    }
+
+    ::operator delete(p);
+  }
+
+ private:
+  struct cache : private util::noncopyable {
+    static cache* get() noexcept {
+      // must not touch 'instance' once it's destroyed, e.g. when
+      // other thread local objects get destroyed after it
+      if (destroyed()) {
+        return nullptr;
+      }
+
+      thread_local cache instance;
+      return &instance;
+    }
+
+    static bool& destroyed() noexcept {
+      thread_local bool destroyed = false;
+      return destroyed;
+    }
+
+    ~cache() {
+      destroyed() = true;
+
+      for (; size; --size) {
+        ::operator delete(slots.pop());
+      }
+    }
+
+    freelist slots;
+    size_t size{};
+  };
+}; // pooled_object
+
+///////////////////////////////////////////////////////////////////////////////
+/// @class vector_pool
+/// @brief bounded per-thread cache of buffers of 'std::vector<T>', intended
+///        for vectors repeatedly built and dropped during query execution,
+///        e.g. sub-iterators of conjunctions and disjunctions
+/// @note buffers of more than 'MaxSize' elements aren't cached
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, size_t Capacity = 16, size_t MaxSize = 1024>
+class vector_pool {
+ public:
+  using vector_t = std::vector<T>;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns empty vector capable of holding at least 'size' elements
+  ////////////////////////////////////////////////////////////////////////////
+  static vector_t make(size_t size) {
+    vector_t v;
+
+    if (auto* cache = cache::get(); cache && cache->size) {
+      v = std::move(cache->slots[--cache->size]);
+    }
+
+    v.reserve(size);
+    return v;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief destroys elements of 'v' and keeps its buffer for reuse
+  ////////////////////////////////////////////////////////////////////////////
+  static void release(vector_t& v) noexcept {
+    v.clear();
+
+    if (!v.capacity() || v.capacity() > MaxSize) {
+      return;
+    }
+
+    if (auto* cache = cache::get(); cache && cache->size < Capacity) {
+      cache->slots[cache->size++] = std::move(v);
+    }
+  }
+
+ private:
+  struct cache : private util::noncopyable {
+    static cache* get() noexcept {
+      // must not touch 'instance' once it's destroyed, e.g. when
+      // other thread local objects get destroyed after it
+      if (destroyed()) {
+        return nullptr;
+      }
+
+      thread_local cache instance;
+      return &instance;
+    }
+
+    static bool& destroyed() noexcept {
+      thread_local bool destroyed = false;
+      return destroyed;
+    }
+
+    ~cache() {
+      destroyed() = true;
+    }
+
+    vector_t slots[Capacity];
+    size_t size{};
+  };
+}; // vector_pool
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief BlockAllocator concept
 ///
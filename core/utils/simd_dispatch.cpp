@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "simd_dispatch.hpp"
+
+// re-includes this file once per target supported by Highway
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "utils/simd_dispatch.cpp"
+#include <hwy/foreach_target.h>
+#include <hwy/highway.h>
+
+#include "utils/simd_utils.hpp"
+
+HWY_BEFORE_NAMESPACE();
+namespace iresearch {
+namespace simd {
+namespace HWY_NAMESPACE {
+namespace {
+
+using dispatch::kDeltaBlockSize;
+using dispatch::kScoreBlockSize;
+
+// kernels aren't 'noexcept' since Highway dispatch tables don't support
+// 'noexcept' function types
+
+size_t count_less32(const uint32_t* begin, size_t size,
+                    uint32_t value) {
+  return count_less(begin, size, value);
+}
+
+std::pair<uint32_t, uint32_t> maxmin32(const uint32_t* begin,
+                                       size_t size) {
+  return maxmin<false>(begin, size);
+}
+
+uint32_t maxbits32(const uint32_t* begin, size_t size) {
+#if HWY_CAP_GE256
+  return maxbits<false>(begin, size);
+#else
+  // prior AVX2 scalar version works faster for 32-bit values
+  return packed::maxbits32(begin, begin + size);
+#endif
+}
+
+bool all_equal32(const uint32_t* begin, size_t size) {
+  return all_equal<false>(begin, size);
+}
+
+bool all_equal64(const uint64_t* begin, size_t size) {
+  return all_equal<false>(begin, size);
+}
+
+void delta_encode32(uint32_t* begin, uint32_t init) {
+  delta_encode<kDeltaBlockSize, false>(begin, init);
+}
+
+void score_bm25(const uint32_t* freqs, size_t count, float_t* out,
+                float_t c0, float_t c1) {
+  constexpr HWY_FULL(float_t) float_tag;
+  const auto vc0 = Set(float_tag, c0);
+  const auto vc1 = Set(float_tag, c1);
+  const auto one = Set(float_tag, 1.f);
+
+  score_block<kScoreBlockSize>(
+    freqs, nullptr, count, out,
+    [&](auto tf, auto /*norm*/) { return vc0 - vc0 / (one + tf / vc1); });
+}
+
+void score_bm25_inv(const uint32_t* freqs, const float_t* inv_c1,
+                    size_t count, float_t* out, float_t c0) {
+  constexpr HWY_FULL(float_t) float_tag;
+  const auto vc0 = Set(float_tag, c0);
+  const auto one = Set(float_tag, 1.f);
+
+  score_block<kScoreBlockSize>(
+    freqs, inv_c1, count, out,
+    [&](auto tf, auto inv) { return vc0 - vc0 / (one + tf * inv); });
+}
+
+void score_bm25_norm(const uint32_t* freqs, const float_t* norms,
+                     size_t count, float_t* out, float_t c0,
+                     float_t norm_const, float_t norm_length,
+                     bool sqrt_tf) {
+  constexpr HWY_FULL(float_t) float_tag;
+  const auto vc0 = Set(float_tag, c0);
+  const auto vnorm_const = Set(float_tag, norm_const);
+  const auto vnorm_length = Set(float_tag, norm_length);
+
+  auto score = [&](auto tf, auto norm) {
+    const auto c1 = vnorm_const + vnorm_length * norm;
+    return vc0 - vc0 * c1 / (c1 + tf);
+  };
+
+  if (sqrt_tf) {
+    score_block<kScoreBlockSize>(
+      freqs, norms, count, out,
+      [&](auto tf, auto norm) { return score(Sqrt(tf), norm); });
+  } else {
+    score_block<kScoreBlockSize>(freqs, norms, count, out, score);
+  }
+}
+
+void score_tfidf(const uint32_t* freqs, const float_t* norms,
+                 size_t count, float_t* out, float_t idf) {
+  constexpr HWY_FULL(float_t) float_tag;
+  const auto vidf = Set(float_tag, idf);
+
+  if (norms) {
+    score_block<kScoreBlockSize>(
+      freqs, norms, count, out,
+      [&](auto tf, auto norm) { return vidf * Sqrt(tf) * norm; });
+  } else {
+    score_block<kScoreBlockSize>(
+      freqs, nullptr, count, out,
+      [&](auto tf, auto /*norm*/) { return vidf * Sqrt(tf); });
+  }
+}
+
+}
+} // HWY_NAMESPACE
+} // simd
+} // ROOT
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+
+namespace iresearch {
+namespace simd {
+
+HWY_EXPORT(count_less32);
+HWY_EXPORT(maxmin32);
+HWY_EXPORT(maxbits32);
+HWY_EXPORT(all_equal32);
+HWY_EXPORT(all_equal64);
+HWY_EXPORT(delta_encode32);
+HWY_EXPORT(score_bm25);
+HWY_EXPORT(score_bm25_inv);
+HWY_EXPORT(score_bm25_norm);
+HWY_EXPORT(score_tfidf);
+
+namespace dispatch {
+
+size_t count_less(const uint32_t* begin, size_t size,
+                  uint32_t value) noexcept {
+  return HWY_DYNAMIC_DISPATCH(count_less32)(begin, size, value);
+}
+
+count_less_f count_less_kernel() noexcept {
+  if (!hwy::chosen_target.IsInitialized()) {
+    // the first entry of a dispatch table chooses the target on call
+    hwy::chosen_target.Update();
+  }
+
+  return &HWY_DYNAMIC_DISPATCH(count_less32);
+}
+
+std::pair<uint32_t, uint32_t> maxmin(const uint32_t* begin,
+                                     size_t size) noexcept {
+  return HWY_DYNAMIC_DISPATCH(maxmin32)(begin, size);
+}
+
+uint32_t maxbits(const uint32_t* begin, size_t size) noexcept {
+  return HWY_DYNAMIC_DISPATCH(maxbits32)(begin, size);
+}
+
+bool all_equal(const uint32_t* begin, size_t size) noexcept {
+  return HWY_DYNAMIC_DISPATCH(all_equal32)(begin, size);
+}
+
+bool all_equal(const uint64_t* begin, size_t size) noexcept {
+  return HWY_DYNAMIC_DISPATCH(all_equal64)(begin, size);
+}
+
+void delta_encode(uint32_t* begin, uint32_t init) noexcept {
+  HWY_DYNAMIC_DISPATCH(delta_encode32)(begin, init);
+}
+
+void score_bm25(const uint32_t* freqs, size_t count, float_t* out,
+                float_t c0, float_t c1) noexcept {
+  HWY_DYNAMIC_DISPATCH(score_bm25)(freqs, count, out, c0, c1);
+}
+
+void score_bm25_inv(const uint32_t* freqs, const float_t* inv_c1,
+                    size_t count, float_t* out, float_t c0) noexcept {
+  HWY_DYNAMIC_DISPATCH(score_bm25_inv)(freqs, inv_c1, count, out, c0);
+}
+
+void score_bm25_norm(const uint32_t* freqs, const float_t* norms,
+                     size_t count, float_t* out, float_t c0,
+                     float_t norm_const, float_t norm_length,
+                     bool sqrt_tf) noexcept {
+  HWY_DYNAMIC_DISPATCH(score_bm25_norm)(
+    freqs, norms, count, out, c0, norm_const, norm_length, sqrt_tf);
+}
+
+void score_tfidf(const uint32_t* freqs, const float_t* norms,
+                 size_t count, float_t* out, float_t idf) noexcept {
+  HWY_DYNAMIC_DISPATCH(score_tfidf)(freqs, norms, count, out, idf);
+}
+
+} // dispatch
+} // simd
+} // ROOT
+
+#endif
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <utility>
+
+#include "shared.hpp"
+
+// Kernels of 'simd_utils.hpp' compiled for every target supported by
+// Highway, the best one the CPU supports is chosen on the first call,
+// see 'cpuinfo::simd_target()'. Results don't depend on the chosen target.
+namespace iresearch {
+namespace simd {
+namespace dispatch {
+
+// max number of elements scored by a single call of a 'score_*' kernel
+constexpr size_t kScoreBlockSize = 128;
+
+// block size of 'delta_encode(...)'
+constexpr size_t kDeltaBlockSize = 128;
+
+// see 'simd::count_less(...)'
+size_t count_less(const uint32_t* begin, size_t size, uint32_t value) noexcept;
+
+using count_less_f = size_t(*)(const uint32_t*, size_t, uint32_t);
+
+// Returns 'count_less(...)' kernel of the chosen target, i.e. it may be
+// cached by a caller to avoid the dispatch on every call in a hot loop.
+count_less_f count_less_kernel() noexcept;
+
+// see 'simd::maxmin(...)'
+std::pair<uint32_t, uint32_t> maxmin(const uint32_t* begin, size_t size) noexcept;
+
+// see 'simd::maxbits(...)'
+uint32_t maxbits(const uint32_t* begin, size_t size) noexcept;
+
+// see 'simd::all_equal(...)'
+bool all_equal(const uint32_t* begin, size_t size) noexcept;
+bool all_equal(const uint64_t* begin, size_t size) noexcept;
+
+// see 'simd::delta_encode(...)', 'begin' must hold 'kDeltaBlockSize' values
+void delta_encode(uint32_t* begin, uint32_t init) noexcept;
+
+// Following kernels evaluate a score for each of 'count' elements of
+// 'freqs', 'count' mustn't exceed 'kScoreBlockSize'. 'norms', if any, must
+// hold 'kScoreBlockSize' values, see 'simd::score_block(...)'.
+
+// out[i] = c0 - c0 / (1 + freqs[i] / c1)
+void score_bm25(const uint32_t* freqs, size_t count, float_t* out,
+                float_t c0, float_t c1) noexcept;
+
+// out[i] = c0 - c0 / (1 + freqs[i] * inv_c1[i])
+void score_bm25_inv(const uint32_t* freqs, const float_t* inv_c1,
+                    size_t count, float_t* out, float_t c0) noexcept;
+
+// out[i] = c0 - c0 * c1 / (c1 + tf), where
+//   c1 = norm_const + norm_length * norms[i]
+//   tf = sqrt_tf ? sqrt(freqs[i]) : freqs[i]
+void score_bm25_norm(const uint32_t* freqs, const float_t* norms,
+                     size_t count, float_t* out, float_t c0,
+                     float_t norm_const, float_t norm_length,
+                     bool sqrt_tf) noexcept;
+
+// out[i] = idf * sqrt(freqs[i]) * (norms ? norms[i] : 1)
+void score_tfidf(const uint32_t* freqs, const float_t* norms,
+                 size_t count, float_t* out, float_t idf) noexcept;
+
+} // dispatch
+} // simd
+} // ROOT
@@ -20,17 +20,27 @@
 /// @author Andrey Abramov
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifndef IRESEARCH_SIMD_UTILS_H
+// Per-target include guard, the header is compiled once per target by
+// translation units including it through 'hwy/foreach_target.h', e.g.
+// 'simd_dispatch.cpp', and once for the static target otherwise
+#if defined(IRESEARCH_SIMD_UTILS_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef IRESEARCH_SIMD_UTILS_H
+#undef IRESEARCH_SIMD_UTILS_H
+#else
 #define IRESEARCH_SIMD_UTILS_H
+#endif
 
 #include <algorithm>
+#include <cstring>
 #include <hwy/highway.h>
 
 #include "shared.hpp"
 #include "utils/bit_packing.hpp"
 
+HWY_BEFORE_NAMESPACE();
 namespace iresearch {
 namespace simd {
+namespace HWY_NAMESPACE {
 
 using namespace hwy::HWY_NAMESPACE;
 
@@ -329,7 +339,87 @@ template<
   }
 }
 
+// Evaluates 'func(tf, norm)' for each of 'count' elements, where 'tf' and
+// 'norm' are vectors of float values of 'freqs' and 'norms' respectively,
+// stores results to 'out'. 'norms' may be 'nullptr', otherwise it must hold
+// at least 'MaxCount' values since the tail is processed as a full vector.
+template<size_t MaxCount, typename Func>
+void score_block(const uint32_t* freqs, const float_t* norms,
+                 size_t count, float_t* out, Func&& func) noexcept {
+  constexpr HWY_FULL(float_t) float_tag;
+  constexpr HWY_FULL(int32_t) int_tag;
+  constexpr size_t Step = MaxLanes(float_tag);
+  static_assert(0 == (MaxCount % Step));
+  assert(count <= MaxCount);
+
+  auto load_norms = [&](size_t i) {
+    return norms ? LoadU(float_tag, norms + i) : Zero(float_tag);
+  };
+
+  size_t i = 0;
+  for (; i + Step <= count; i += Step) {
+    // frequencies never exceed 'std::numeric_limits<int32_t>::max()'
+    const auto tf = ConvertTo(
+      float_tag, LoadU(int_tag, reinterpret_cast<const int32_t*>(freqs + i)));
+    StoreU(func(tf, load_norms(i)), float_tag, out + i);
+  }
+
+  if (const size_t tail = count - i; tail) {
+    int32_t tail_freqs[Step]{};
+    float_t tail_out[Step];
+    std::memcpy(tail_freqs, freqs + i, tail*sizeof(uint32_t));
+    const auto tf = ConvertTo(float_tag, LoadU(int_tag, tail_freqs));
+    StoreU(func(tf, load_norms(i)), float_tag, tail_out);
+    std::memcpy(out + i, tail_out, tail*sizeof(float_t));
+  }
 }
+
+// Returns number of elements less than 'value' in the sorted block denoted
+// by [begin;begin+size), i.e. position of the first element not less than
+// 'value'.
+inline size_t count_less(const uint32_t* begin, size_t size,
+                         uint32_t value) noexcept {
+  constexpr HWY_FULL(int32_t) simd_tag;
+  constexpr size_t Step = MaxLanes(simd_tag);
+
+  // flipping the sign bit maps unsigned order onto signed one
+  const auto sign = Set(simd_tag, std::numeric_limits<int32_t>::min());
+  const auto target = Xor(Set(simd_tag, int32_t(value)), sign);
+
+  size_t i = 0;
+  for (; i + Step <= size; i += Step) {
+    const auto v = Xor(
+      LoadU(simd_tag, reinterpret_cast<const int32_t*>(begin + i)), sign);
+    const size_t less = CountTrue(simd_tag, v < target);
+
+    if (less < Step) {
+      return i + less;
+    }
+  }
+
+  for (; i < size && begin[i] < value; ++i) { }
+
+  return i;
 }
 
+} // HWY_NAMESPACE
+} // simd
+} // ROOT
+HWY_AFTER_NAMESPACE();
+
 #endif // IRESEARCH_SIMD_UTILS_H
+
+#if HWY_ONCE && !defined(IRESEARCH_SIMD_UTILS_STATIC_H)
+#define IRESEARCH_SIMD_UTILS_STATIC_H
+
+namespace iresearch {
+namespace simd {
+
+// kernels compiled for the static target, i.e. the one denoted by compiler
+// flags, see 'simd_dispatch.hpp' for the ones chosen at runtime
+using namespace HWY_NAMESPACE;
+
+}
+}
+
+#endif // IRESEARCH_SIMD_UTILS_STATIC_H
@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include "search/conjunction.hpp"
+#include "utils/misc.hpp"
+#include "utils/simd_dispatch.hpp"
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        count_less
+// -----------------------------------------------------------------------------
+
+// remaining part of a block as seen by 'block_conjunction::seek(...)'
+constexpr size_t kRangeSize = 16;
+
+void BM_count_less_dispatch(benchmark::State& state) {
+  uint32_t values[irs::block_conjunction::kBlockSize];
+  std::iota(std::begin(values), std::end(values), 0);
+
+  size_t pos = 0;
+  for (auto _ : state) {
+    pos = (pos + 1) % (IRESEARCH_COUNTOF(values) - kRangeSize);
+    benchmark::DoNotOptimize(irs::simd::dispatch::count_less(
+      values + pos, kRangeSize, uint32_t(pos + kRangeSize/2)));
+  }
+}
+
+BENCHMARK(BM_count_less_dispatch);
+
+void BM_count_less_resolved(benchmark::State& state) {
+  uint32_t values[irs::block_conjunction::kBlockSize];
+  std::iota(std::begin(values), std::end(values), 0);
+  const auto count_less = irs::simd::dispatch::count_less_kernel();
+
+  size_t pos = 0;
+  for (auto _ : state) {
+    pos = (pos + 1) % (IRESEARCH_COUNTOF(values) - kRangeSize);
+    benchmark::DoNotOptimize(count_less(
+      values + pos, kRangeSize, uint32_t(pos + kRangeSize/2)));
+  }
+}
+
+BENCHMARK(BM_count_less_resolved);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 block_conjunction
+// -----------------------------------------------------------------------------
+
+class docs_iterator final : public irs::doc_iterator {
+ public:
+  explicit docs_iterator(const std::vector<irs::doc_id_t>& docs) noexcept
+    : begin_(docs.data()), end_(docs.data() + docs.size()) {
+    std::get<irs::cost>(attrs_).reset(docs.size());
+  }
+
+  virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    return irs::get_mutable(attrs_, type);
+  }
+
+  virtual irs::doc_id_t value() const noexcept override {
+    return std::get<irs::document>(attrs_).value;
+  }
+
+  virtual bool next() override {
+    auto& doc = std::get<irs::document>(attrs_);
+
+    if (begin_ == end_) {
+      doc.value = irs::doc_limits::eof();
+      return false;
+    }
+
+    doc.value = *begin_++;
+    return true;
+  }
+
+  virtual irs::doc_id_t seek(irs::doc_id_t target) override {
+    auto& doc = std::get<irs::document>(attrs_);
+
+    if (target <= doc.value) {
+      return doc.value;
+    }
+
+    begin_ = std::lower_bound(begin_, end_, target);
+    next();
+    return doc.value;
+  }
+
+  virtual size_t next_batch(irs::doc_id_t* docs, uint32_t* freqs,
+                            size_t count) override {
+    const size_t read = std::min(count, size_t(end_ - begin_));
+    std::copy_n(begin_, read, docs);
+    begin_ += read;
+
+    if (freqs) {
+      std::fill_n(freqs, read, 0);
+    }
+
+    std::get<irs::document>(attrs_).value = read < count
+      ? irs::doc_limits::eof()
+      : docs[read - 1];
+
+    return read;
+  }
+
+ private:
+  std::tuple<irs::document, irs::cost> attrs_;
+  const irs::doc_id_t* begin_;
+  const irs::doc_id_t* end_;
+};
+
+std::vector<irs::doc_id_t> make_docs(size_t step, size_t max) {
+  std::vector<irs::doc_id_t> docs;
+  for (size_t doc = irs::doc_limits::min(); doc < max; doc += step) {
+    docs.emplace_back(irs::doc_id_t(doc));
+  }
+  return docs;
+}
+
+irs::block_conjunction::doc_iterators_t make_itrs(
+    const std::vector<std::vector<irs::doc_id_t>>& postings) {
+  irs::block_conjunction::doc_iterators_t itrs;
+  for (auto& docs : postings) {
+    itrs.emplace_back(irs::memory::make_managed<docs_iterator>(docs));
+  }
+  return itrs;
+}
+
+// every 'state.range(0)'th document of the lead iterator is looked up via
+// 'seek(...)' as if the conjunction is a part of another one
+void BM_block_conjunction_seek(benchmark::State& state) {
+  constexpr size_t kMaxDoc = 1 << 20;
+  const std::vector<std::vector<irs::doc_id_t>> postings{
+    make_docs(3, kMaxDoc), make_docs(5, kMaxDoc), make_docs(7, kMaxDoc) };
+  const auto step = irs::doc_id_t(state.range(0));
+
+  for (auto _ : state) {
+    irs::block_conjunction it(make_itrs(postings));
+    for (irs::doc_id_t target = irs::doc_limits::min();
+         !irs::doc_limits::eof(it.seek(target));
+         target = it.value() + step) {
+      benchmark::DoNotOptimize(it.value());
+    }
+  }
+}
+
+BENCHMARK(BM_block_conjunction_seek)->Arg(1)->Arg(16)->Arg(256);
+
+void BM_block_conjunction_next(benchmark::State& state) {
+  constexpr size_t kMaxDoc = 1 << 20;
+  const std::vector<std::vector<irs::doc_id_t>> postings{
+    make_docs(3, kMaxDoc), make_docs(5, kMaxDoc), make_docs(7, kMaxDoc) };
+
+  for (auto _ : state) {
+    irs::block_conjunction it(make_itrs(postings));
+    while (it.next()) {
+      benchmark::DoNotOptimize(it.value());
+    }
+  }
+}
+
+BENCHMARK(BM_block_conjunction_next);
+
+}
@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "analysis/delimited_token_stream.hpp"
+#include "analysis/shingle_token_stream.hpp"
+
+#include "gtest/gtest.h"
+#include "tests_config.hpp"
+#include "velocypack/Parser.h"
+#include "velocypack/velocypack-aliases.h"
+
+namespace {
+
+// emits predefined tokens along with their increments
+class tokens_analyzer final : public irs::analysis::analyzer {
+ public:
+  static constexpr irs::string_ref type_name() noexcept { return "tokens_analyzer"; }
+
+  explicit tokens_analyzer(std::vector<std::pair<std::string, uint32_t>> tokens)
+    : analyzer(irs::type<tokens_analyzer>::get()),
+      tokens_(std::move(tokens)) {
+  }
+
+  virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    return irs::get_mutable(attrs_, type);
+  }
+
+  virtual bool next() override {
+    if (it_ == tokens_.end()) {
+      return false;
+    }
+
+    std::get<irs::term_attribute>(attrs_).value = irs::ref_cast<irs::byte_type>(it_->first);
+    std::get<irs::increment>(attrs_).value = it_->second;
+    ++it_;
+    return true;
+  }
+
+  virtual bool reset(irs::string_ref) override {
+    it_ = tokens_.begin();
+    return true;
+  }
+
+ private:
+  std::vector<std::pair<std::string, uint32_t>> tokens_;
+  std::vector<std::pair<std::string, uint32_t>>::const_iterator it_;
+  std::tuple<irs::increment, irs::term_attribute> attrs_;
+};
+
+struct pair {
+  std::string term;
+  uint32_t pos;
+  uint32_t start;
+  uint32_t end;
+};
+
+std::vector<pair> collect(irs::analysis::analyzer& stream, irs::string_ref data) {
+  std::vector<pair> pairs;
+
+  auto* term = irs::get<irs::term_attribute>(stream);
+  auto* inc = irs::get<irs::increment>(stream);
+  auto* offset = irs::get<irs::offset>(stream);
+  EXPECT_NE(nullptr, term);
+  EXPECT_NE(nullptr, inc);
+
+  EXPECT_TRUE(stream.reset(data));
+
+  uint32_t pos = 0;
+  while (stream.next()) {
+    pos += inc->value;
+    pairs.emplace_back(pair{
+      static_cast<std::string>(irs::ref_cast<char>(term->value)), pos,
+      offset ? offset->start : 0, offset ? offset->end : 0 });
+  }
+
+  return pairs;
+}
+
+} // namespace {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+#ifndef IRESEARCH_DLL
+
+TEST(shingle_token_stream_tests, consts) {
+  static_assert("shingle" == irs::type<irs::analysis::shingle_token_stream>::name());
+}
+
+TEST(shingle_token_stream_tests, pairs) {
+  irs::analysis::shingle_token_stream stream({
+    irs::analysis::delimited_token_stream::make(" "), "_" });
+  ASSERT_EQ(irs::type<irs::analysis::shingle_token_stream>::id(), stream.type());
+  ASSERT_EQ("_", stream.delimiter());
+  ASSERT_EQ(nullptr, irs::get<irs::payload>(stream));
+  ASSERT_NE(nullptr, irs::get<irs::offset>(stream));
+
+  {
+    const auto pairs = collect(stream, "new york city");
+    ASSERT_EQ(2, pairs.size());
+    ASSERT_EQ("new_york", pairs[0].term);
+    ASSERT_EQ(1, pairs[0].pos);
+    ASSERT_EQ(0, pairs[0].start);
+    ASSERT_EQ(8, pairs[0].end);
+    ASSERT_EQ("york_city", pairs[1].term);
+    ASSERT_EQ(2, pairs[1].pos);
+    ASSERT_EQ(4, pairs[1].start);
+    ASSERT_EQ(13, pairs[1].end);
+  }
+
+  // single token
+  ASSERT_TRUE(collect(stream, "new").empty());
+}
+
+TEST(shingle_token_stream_tests, gaps_and_synonyms) {
+  irs::analysis::shingle_token_stream stream({
+    std::make_unique<tokens_analyzer>(
+      std::vector<std::pair<std::string, uint32_t>>{
+        { "a", 1 }, { "b", 1 }, { "c", 2 }, { "d", 1 }, { "e", 0 }, { "f", 1 } }) });
+  ASSERT_EQ(irs::analysis::shingle_token_stream::kDefaultDelimiter, stream.delimiter());
+  ASSERT_EQ(nullptr, irs::get<irs::offset>(stream));
+
+  const auto pairs = collect(stream, "");
+  ASSERT_EQ(5, pairs.size());
+  ASSERT_EQ("a b", pairs[0].term);
+  ASSERT_EQ(1, pairs[0].pos);
+  // no pair over a gap at position 3
+  ASSERT_EQ("c d", pairs[1].term);
+  ASSERT_EQ(4, pairs[1].pos);
+  // 'e' shares position with 'd', both are paired with their neighbours
+  ASSERT_EQ("c e", pairs[2].term);
+  ASSERT_EQ(4, pairs[2].pos);
+  ASSERT_EQ("d f", pairs[3].term);
+  ASSERT_EQ(5, pairs[3].pos);
+  ASSERT_EQ("e f", pairs[4].term);
+  ASSERT_EQ(5, pairs[4].pos);
+}
+
+TEST(shingle_token_stream_tests, same_position) {
+  irs::analysis::shingle_token_stream stream({
+    std::make_unique<tokens_analyzer>(
+      std::vector<std::pair<std::string, uint32_t>>{
+        { "new", 1 }, { "york", 1 }, { "ny", 0 }, { "nyc", 0 }, { "city", 1 },
+        { "hall", 1 } }), "_" });
+
+  // every token at a position is paired with every token at the next one
+  const std::vector<std::pair<std::string, uint32_t>> expected{
+    { "new_york", 1 }, { "new_ny", 1 }, { "new_nyc", 1 },
+    { "york_city", 2 }, { "ny_city", 2 }, { "nyc_city", 2 },
+    { "city_hall", 3 } };
+
+  for (size_t i = 0; i < 2; ++i) { // stream is reusable
+    const auto pairs = collect(stream, "");
+    ASSERT_EQ(expected.size(), pairs.size());
+    for (size_t j = 0; j < pairs.size(); ++j) {
+      ASSERT_EQ(expected[j].first, pairs[j].term);
+      ASSERT_EQ(expected[j].second, pairs[j].pos);
+    }
+  }
+}
+
+TEST(shingle_token_stream_tests, make_json) {
+  auto stream = irs::analysis::analyzers::get(
+    "shingle", irs::type<irs::text_format::json>::get(),
+    "{\"delimiter\":\"|\",\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\",\"}}}");
+  ASSERT_NE(nullptr, stream);
+  ASSERT_EQ(irs::type<irs::analysis::shingle_token_stream>::id(), stream->type());
+
+  const auto pairs = collect(*stream, "of,the,people");
+  ASSERT_EQ(2, pairs.size());
+  ASSERT_EQ("of|the", pairs[0].term);
+  ASSERT_EQ("the|people", pairs[1].term);
+
+  // missing analyzer
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "shingle", irs::type<irs::text_format::json>::get(), "{\"delimiter\":\"|\"}"));
+  // unknown analyzer
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "shingle", irs::type<irs::text_format::json>::get(),
+    "{\"analyzer\":{\"type\":\"unknown\",\"properties\":{}}}"));
+  // invalid delimiter
+  ASSERT_EQ(nullptr, irs::analysis::analyzers::get(
+    "shingle", irs::type<irs::text_format::json>::get(),
+    "{\"delimiter\":1,\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\",\"}}}"));
+}
+
+TEST(shingle_token_stream_tests, make_config_json) {
+  std::string config =
+    "{\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\",\",\"invalid_parameter\":true}}}";
+  std::string actual;
+  ASSERT_TRUE(irs::analysis::analyzers::normalize(
+    actual, "shingle", irs::type<irs::text_format::json>::get(), config));
+  ASSERT_EQ(VPackParser::fromJson(
+    "{\"delimiter\":\" \",\"analyzer\":{\"type\":\"delimiter\",\"properties\":{\"delimiter\":\",\"}}}")->toString(),
+    actual);
+}
+
+#endif
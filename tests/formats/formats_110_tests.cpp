@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "formats_test_case_base.hpp"
+#include "formats/formats_10.hpp"
+#include "formats/formats_10_attributes.hpp"
+#include "store/directory_attributes.hpp"
+
+namespace {
+
+using tests::format_test_case;
+using tests::format_test_case_with_encryption;
+
+constexpr auto kFeatures = irs::IndexFeatures::FREQ;
+
+class format_110_test_case : public tests::postings_test_case { };
+
+TEST_P(format_110_test_case, postings_pulsed) {
+  const std::vector<postings_t> terms{
+    { { 5, 1 } },
+    { { 1, 3 }, { 7, 1 } },
+    { { 2, 1 }, { 3, 2 }, { 100, 1 }, { 9000, 42 } },
+    { { 1, 1 }, { 2, 1 }, { 3, 1 }, { 4, 1 }, { 5, 7 } },
+    { { 10, 2 }, { 20, 1 }, { 30, 2 } }
+  };
+
+  auto codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
+  ASSERT_NE(nullptr, codec);
+  auto legacy = std::dynamic_pointer_cast<const irs::version10::format>(
+    irs::formats::get(irs::string_ref("1_10") == codec->type().name()
+                        ? "1_9" : "1_9simd"));
+  ASSERT_NE(nullptr, legacy);
+
+  const auto [data, metas, length] = write_postings(*codec, "segment", kFeatures, terms);
+  const auto legacy_length = write_postings(*legacy, "legacy", kFeatures, terms).length;
+  // only the term with 5 documents is stored in a postings file
+  ASSERT_LT(length, legacy_length);
+
+  std::vector<irs::version10::term_meta> read_metas;
+  auto reader = read_postings(*codec, "segment", kFeatures, data, read_metas);
+  ASSERT_EQ(terms.size(), read_metas.size());
+
+  for (size_t i = 0; i < terms.size(); ++i) {
+    auto& term = terms[i];
+    auto& read_meta = read_metas[i];
+
+    ASSERT_EQ(term.size(), read_meta.docs_count);
+    ASSERT_EQ(metas[i].pulsed, read_meta.pulsed);
+    ASSERT_EQ(term.size() > 1 &&
+                term.size() <= irs::version10::term_meta::MAX_PULSED_DOCS,
+              read_meta.pulsed);
+    if (!read_meta.pulsed) {
+      ASSERT_EQ(metas[i].doc_start, read_meta.doc_start);
+    }
+
+    // every document can be reached
+    {
+      auto it = reader->iterator(kFeatures, kFeatures, read_meta);
+      auto* freq = irs::get<irs::frequency>(*it);
+      ASSERT_NE(nullptr, freq);
+
+      for (auto [doc, doc_freq] : term) {
+        ASSERT_TRUE(it->next());
+        ASSERT_EQ(doc, it->value());
+        ASSERT_EQ(doc_freq, freq->value);
+      }
+      ASSERT_FALSE(it->next());
+      ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+    }
+
+    // seek
+    {
+      auto it = reader->iterator(kFeatures, irs::IndexFeatures::NONE, read_meta);
+      ASSERT_EQ(term.back().first, it->seek(term.back().first));
+      ASSERT_TRUE(irs::doc_limits::eof(it->seek(term.back().first + 1)));
+    }
+
+    // bit union
+    {
+      constexpr size_t kBits = irs::bits_required<size_t>();
+      std::vector<size_t> expected(10000 / kBits + 1);
+      for (const auto& entry : term) {
+        irs::set_bit(expected[entry.first / kBits], entry.first % kBits);
+      }
+
+      std::vector<size_t> actual(expected.size());
+      bool provided = false;
+      ASSERT_EQ(term.size(), reader->bit_union(
+        kFeatures,
+        [&provided, &read_meta]() -> const irs::term_meta* {
+          return std::exchange(provided, true) ? nullptr : &read_meta;
+        },
+        actual.data()));
+      ASSERT_EQ(expected, actual);
+    }
+  }
+}
+
+const auto kDirectoriesWithEncryption =
+    ::testing::Values(
+      &tests::rot13_directory<&tests::memory_directory, 16>,
+      &tests::rot13_directory<&tests::fs_directory, 16>,
+      &tests::rot13_directory<&tests::mmap_directory, 16>,
+      &tests::rot13_directory<&tests::memory_directory, 7>,
+      &tests::rot13_directory<&tests::fs_directory, 7>,
+      &tests::rot13_directory<&tests::mmap_directory, 7>);
+
+const auto kDirectories =
+    ::testing::Values(
+      &tests::directory<&tests::memory_directory>,
+      &tests::directory<&tests::fs_directory>,
+      &tests::directory<&tests::mmap_directory>);
+
+#ifdef IRESEARCH_SSE2
+const auto kFormats =
+     ::testing::Values(tests::format_info{"1_10", "1_0"},
+                       tests::format_info{"1_10simd", "1_0"});
+#else
+const auto kFormats =
+     ::testing::Values(tests::format_info{"1_10", "1_0"});
+#endif
+
+// 1.10 specific tests
+INSTANTIATE_TEST_SUITE_P(
+    format_110_test,
+    format_110_test_case,
+    ::testing::Combine(kDirectoriesWithEncryption, kFormats),
+    format_110_test_case::to_string);
+
+// Generic tests
+INSTANTIATE_TEST_SUITE_P(
+    format_110_test,
+    format_test_case_with_encryption,
+    ::testing::Combine(kDirectoriesWithEncryption, kFormats),
+    format_test_case_with_encryption::to_string);
+
+INSTANTIATE_TEST_SUITE_P(
+    format_110_test,
+    format_test_case,
+    ::testing::Combine(kDirectories, kFormats),
+    format_test_case::to_string);
+
+}
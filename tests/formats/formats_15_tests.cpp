@@ -0,0 +1,329 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "formats_test_case_base.hpp"
+#include "formats/formats_10.hpp"
+#include "formats/formats_10_attributes.hpp"
+#include "store/directory_attributes.hpp"
+
+namespace {
+
+using tests::format_test_case;
+using tests::format_test_case_with_encryption;
+
+constexpr size_t kBlockSize = 128;
+
+class format_15_test_case : public format_test_case_with_encryption {
+ protected:
+  // postings with a frequency varying from document to document
+  class freq_postings final : public irs::doc_iterator {
+   public:
+    explicit freq_postings(irs::doc_id_t count) noexcept
+      : count_{count} {
+    }
+
+    static uint32_t freq(irs::doc_id_t doc) noexcept {
+      return 1 + (doc * 7919) % 97;
+    }
+
+    virtual bool next() override {
+      if (doc_.value == count_) {
+        doc_.value = irs::doc_limits::eof();
+        return false;
+      }
+
+      ++doc_.value;
+      freq_.value = freq(doc_.value);
+      return true;
+    }
+
+    virtual irs::doc_id_t value() const override {
+      return doc_.value;
+    }
+
+    virtual irs::doc_id_t seek(irs::doc_id_t target) override {
+      irs::seek(*this, target);
+      return value();
+    }
+
+    virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+      if (irs::type<irs::document>::id() == type) {
+        return &doc_;
+      }
+
+      if (irs::type<irs::frequency>::id() == type) {
+        return &freq_;
+      }
+
+      return nullptr;
+    }
+
+   private:
+    irs::document doc_;
+    irs::frequency freq_;
+    irs::doc_id_t count_;
+  };
+
+  void postings_impact(irs::doc_id_t count);
+};
+
+void format_15_test_case::postings_impact(irs::doc_id_t count) {
+  constexpr auto kFeatures = irs::IndexFeatures::FREQ;
+
+  auto codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
+  ASSERT_NE(nullptr, codec);
+  auto writer = codec->get_postings_writer(false);
+  ASSERT_NE(nullptr, writer);
+  irs::postings_writer::state term_meta; // must be destroyed before the writer
+
+  // write postings
+  {
+    irs::flush_state state;
+    state.dir = &dir();
+    state.doc_count = count + 1;
+    state.name = "segment_name";
+    state.index_features = kFeatures;
+
+    auto out = dir().create("attributes");
+    ASSERT_FALSE(!out);
+
+    writer->prepare(*out, state);
+    writer->begin_field(kFeatures);
+    freq_postings docs{count};
+    term_meta = writer->write(docs);
+    writer->encode(*out, *term_meta);
+    writer->end();
+  }
+
+  irs::segment_meta meta;
+  meta.name = "segment_name";
+
+  irs::reader_state state;
+  state.dir = &dir();
+  state.meta = &meta;
+
+  auto in = dir().open("attributes", irs::IOAdvice::NORMAL);
+  ASSERT_FALSE(!in);
+
+  auto reader = codec->get_postings_reader();
+  ASSERT_NE(nullptr, reader);
+  reader->prepare(*in, state, kFeatures);
+
+  irs::bstring in_data(in->length() - in->file_pointer(), 0);
+  in->read_bytes(&in_data[0], in_data.size());
+
+  irs::version10::term_meta read_meta;
+  reader->decode(in_data.c_str(), kFeatures, read_meta);
+  ASSERT_EQ(count, read_meta.docs_count);
+
+  // expected max frequency of a block containing a given document
+  auto block_max = [count](irs::doc_id_t doc) {
+    const irs::doc_id_t begin = 1 + ((doc - 1) / kBlockSize) * kBlockSize;
+    const irs::doc_id_t end = std::min(count + 1, irs::doc_id_t(begin + kBlockSize));
+
+    uint32_t max = 0;
+    for (auto i = begin; i < end; ++i) {
+      max = std::max(max, freq_postings::freq(i));
+    }
+    return std::make_pair(end - 1, max);
+  };
+
+  // shallow seek for every document
+  {
+    auto it = reader->iterator(kFeatures, kFeatures, read_meta);
+    auto* impact = irs::get_mutable<irs::impact>(it.get());
+    ASSERT_NE(nullptr, impact);
+
+    for (irs::doc_id_t doc = 1; doc <= count; ++doc) {
+      const auto max_doc = impact->shallow_seek(doc);
+      ASSERT_EQ(max_doc, impact->max_doc);
+      ASSERT_LE(doc, max_doc);
+
+      if (irs::doc_limits::eof(max_doc)) {
+        // the last block, upper bound is only known
+        ASSERT_GE(impact->max_freq, block_max(doc).second);
+      } else {
+        const auto [expected_max_doc, expected_max_freq] = block_max(doc);
+        ASSERT_EQ(expected_max_doc, max_doc);
+        ASSERT_EQ(expected_max_freq, impact->max_freq);
+      }
+    }
+  }
+
+  // shallow seek doesn't affect iteration
+  {
+    auto it = reader->iterator(kFeatures, kFeatures, read_meta);
+    auto* freq = irs::get<irs::frequency>(*it);
+    ASSERT_NE(nullptr, freq);
+    auto* impact = irs::get_mutable<irs::impact>(it.get());
+    ASSERT_NE(nullptr, impact);
+
+    for (irs::doc_id_t doc = 1; doc <= count; doc += 3) {
+      impact->shallow_seek(doc + kBlockSize);
+      ASSERT_EQ(doc, it->seek(doc));
+      ASSERT_EQ(freq_postings::freq(doc), freq->value);
+    }
+  }
+
+  // every document can be reached
+  {
+    auto it = reader->iterator(kFeatures, kFeatures, read_meta);
+    auto* freq = irs::get<irs::frequency>(*it);
+    ASSERT_NE(nullptr, freq);
+
+    for (irs::doc_id_t doc = 1; doc <= count; ++doc) {
+      ASSERT_TRUE(it->next());
+      ASSERT_EQ(doc, it->value());
+      ASSERT_EQ(freq_postings::freq(doc), freq->value);
+    }
+    ASSERT_FALSE(it->next());
+  }
+
+  // read in batches
+  for (auto features : { kFeatures, irs::IndexFeatures::NONE }) {
+    const bool has_freq = irs::IndexFeatures::NONE != features;
+
+    for (size_t batch : { size_t(1), size_t(7), kBlockSize, kBlockSize + 1 }) {
+      auto it = reader->iterator(kFeatures, features, read_meta);
+      auto* freq = irs::get<irs::frequency>(*it);
+      ASSERT_EQ(has_freq, nullptr != freq);
+
+      std::vector<irs::doc_id_t> docs(batch);
+      std::vector<uint32_t> freqs(batch);
+      irs::doc_id_t expected = 1;
+
+      for (;;) {
+        const size_t read = it->next_batch(docs.data(), freqs.data(), batch);
+        ASSERT_LE(read, batch);
+
+        for (size_t i = 0; i < read; ++i, ++expected) {
+          ASSERT_EQ(expected, docs[i]);
+          ASSERT_EQ(has_freq ? freq_postings::freq(expected) : 0, freqs[i]);
+        }
+
+        if (read < batch) {
+          break;
+        }
+
+        ASSERT_EQ(docs.back(), it->value());
+        if (has_freq) {
+          ASSERT_EQ(freqs.back(), freq->value);
+        }
+      }
+
+      ASSERT_EQ(count + 1, expected);
+      ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+      ASSERT_EQ(0, it->next_batch(docs.data(), freqs.data(), batch));
+      ASSERT_FALSE(it->next());
+    }
+  }
+
+  // read in batches mixed with 'seek' and 'next'
+  if (count > 2*kBlockSize) {
+    auto it = reader->iterator(kFeatures, kFeatures, read_meta);
+    auto* freq = irs::get<irs::frequency>(*it);
+    ASSERT_NE(nullptr, freq);
+
+    irs::doc_id_t docs[kBlockSize];
+    uint32_t freqs[kBlockSize];
+
+    ASSERT_EQ(kBlockSize - 5, it->seek(kBlockSize - 5));
+    ASSERT_EQ(kBlockSize, it->next_batch(docs, freqs, kBlockSize));
+    for (size_t i = 0; i < kBlockSize; ++i) {
+      const irs::doc_id_t expected = irs::doc_id_t(kBlockSize - 4 + i);
+      ASSERT_EQ(expected, docs[i]);
+      ASSERT_EQ(freq_postings::freq(expected), freqs[i]);
+    }
+
+    ASSERT_TRUE(it->next());
+    ASSERT_EQ(2*kBlockSize - 3, it->value());
+    ASSERT_EQ(freq_postings::freq(it->value()), freq->value);
+
+    ASSERT_EQ(3, it->next_batch(docs, nullptr, 3));
+    ASSERT_EQ(2*kBlockSize - 2, docs[0]);
+    ASSERT_EQ(2*kBlockSize - 1, docs[1]);
+    ASSERT_EQ(2*kBlockSize, docs[2]);
+    ASSERT_EQ(freq_postings::freq(2*kBlockSize), freq->value);
+
+    ASSERT_EQ(2*kBlockSize + 5, it->seek(2*kBlockSize + 5));
+    ASSERT_EQ(freq_postings::freq(2*kBlockSize + 5), freq->value);
+  }
+}
+
+TEST_P(format_15_test_case, postings_impact_single_block) {
+  postings_impact(kBlockSize - 3);
+}
+
+TEST_P(format_15_test_case, postings_impact) {
+  postings_impact(kBlockSize * 100 + 7);
+}
+
+TEST_P(format_15_test_case, postings_impact_multiple_levels) {
+  postings_impact(kBlockSize * 8 * 8 + 1);
+}
+
+const auto kDirectoriesWithEncryption =
+    ::testing::Values(
+      &tests::rot13_directory<&tests::memory_directory, 16>,
+      &tests::rot13_directory<&tests::fs_directory, 16>,
+      &tests::rot13_directory<&tests::mmap_directory, 16>,
+      &tests::rot13_directory<&tests::memory_directory, 7>,
+      &tests::rot13_directory<&tests::fs_directory, 7>,
+      &tests::rot13_directory<&tests::mmap_directory, 7>);
+
+const auto kDirectories =
+    ::testing::Values(
+      &tests::directory<&tests::memory_directory>,
+      &tests::directory<&tests::fs_directory>,
+      &tests::directory<&tests::mmap_directory>);
+
+#ifdef IRESEARCH_SSE2
+const auto kFormats =
+     ::testing::Values(tests::format_info{"1_5", "1_0"},
+                       tests::format_info{"1_5simd", "1_0"});
+#else
+const auto kFormats =
+     ::testing::Values(tests::format_info{"1_5", "1_0"});
+#endif
+
+// 1.5 specific tests
+INSTANTIATE_TEST_SUITE_P(
+    format_15_test,
+    format_15_test_case,
+    ::testing::Combine(kDirectoriesWithEncryption, kFormats),
+    format_15_test_case::to_string);
+
+// Generic tests
+INSTANTIATE_TEST_SUITE_P(
+    format_15_test,
+    format_test_case_with_encryption,
+    ::testing::Combine(kDirectoriesWithEncryption, kFormats),
+    format_test_case_with_encryption::to_string);
+
+INSTANTIATE_TEST_SUITE_P(
+    format_15_test,
+    format_test_case,
+    ::testing::Combine(kDirectories, kFormats),
+    format_test_case::to_string);
+
+}
@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "formats_test_case_base.hpp"
+#include "search/term_filter.hpp"
+#include "store/directory_attributes.hpp"
+
+namespace {
+
+using tests::format_test_case;
+using tests::format_test_case_with_encryption;
+
+class format_16_test_case : public format_test_case_with_encryption {
+ protected:
+  // writes 'mask' with 'codec', ensures it's read back intact,
+  // returns length of the written file
+  uint64_t write_mask(const irs::format& codec,
+                      const irs::segment_meta& meta,
+                      const irs::document_mask& mask) {
+    auto writer = codec.get_document_mask_writer();
+    writer->write(dir(), meta, mask);
+
+    irs::document_mask actual;
+    EXPECT_TRUE(codec.get_document_mask_reader()->read(dir(), meta, actual));
+    EXPECT_EQ(mask, actual);
+
+    uint64_t length = 0;
+    EXPECT_TRUE(dir().length(length, writer->filename(meta)));
+    return length;
+  }
+};
+
+TEST_P(format_16_test_case, document_mask_encodings) {
+  auto legacy = irs::formats::get("1_5");
+  ASSERT_NE(nullptr, legacy);
+
+  // dense mask is stored as a bitmap
+  {
+    irs::document_mask mask;
+    for (irs::doc_id_t doc = irs::doc_limits::min(); doc < 10000; doc += 2) {
+      mask.emplace(doc);
+    }
+
+    const auto length = write_mask(*codec(), irs::segment_meta("_1", nullptr), mask);
+    const auto legacy_length = write_mask(*legacy, irs::segment_meta("_2", nullptr), mask);
+    ASSERT_LT(4*length, legacy_length);
+  }
+
+  // sparse mask is stored as deltas
+  {
+    const irs::document_mask mask{ 1, 1000000, 2000000, 2000001 };
+
+    const auto length = write_mask(*codec(), irs::segment_meta("_3", nullptr), mask);
+    const auto legacy_length = write_mask(*legacy, irs::segment_meta("_4", nullptr), mask);
+    ASSERT_LE(length, legacy_length);
+  }
+
+  // mask written by a previous format version
+  {
+    const irs::segment_meta meta("_5", nullptr);
+    const irs::document_mask mask{ 1, 4, 5, 7, 10, 12 };
+    legacy->get_document_mask_writer()->write(dir(), meta, mask);
+
+    irs::document_mask actual;
+    ASSERT_TRUE(codec()->get_document_mask_reader()->read(dir(), meta, actual));
+    ASSERT_EQ(mask, actual);
+  }
+}
+
+TEST_P(format_16_test_case, live_docs) {
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  {
+    auto reader = open_reader();
+    ASSERT_EQ(1, reader.size());
+    ASSERT_EQ(nullptr, reader[0].live_docs());
+  }
+
+  // remove documents "A" and "C"
+  {
+    auto writer = open_writer(irs::OM_APPEND);
+    for (const irs::string_ref name : { "A", "C" }) {
+      auto removal = std::make_unique<irs::by_term>();
+      *removal->mutable_field() = "name";
+      removal->mutable_options()->term = irs::ref_cast<irs::byte_type>(name);
+      writer->documents().remove(irs::filter::ptr(std::move(removal)));
+    }
+    writer->commit();
+  }
+
+  auto reader = open_reader();
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0];
+  ASSERT_EQ(32, segment.docs_count());
+  ASSERT_EQ(30, segment.live_docs_count());
+
+  auto* live_docs = segment.live_docs();
+  ASSERT_NE(nullptr, live_docs);
+  ASSERT_EQ(30, live_docs->count());
+  ASSERT_FALSE(live_docs->test(irs::doc_limits::invalid()));
+  ASSERT_FALSE(live_docs->test(1));
+  ASSERT_TRUE(live_docs->test(2));
+  ASSERT_FALSE(live_docs->test(3));
+  ASSERT_TRUE(live_docs->test(32));
+
+  // live documents
+  {
+    std::vector<irs::doc_id_t> expected;
+    for (irs::doc_id_t doc = 1; doc <= 32; ++doc) {
+      if (doc != 1 && doc != 3) {
+        expected.emplace_back(doc);
+      }
+    }
+
+    std::vector<irs::doc_id_t> actual;
+    for (auto it = segment.docs_iterator(); it->next();) {
+      actual.emplace_back(it->value());
+    }
+    ASSERT_EQ(expected, actual);
+  }
+
+  // masked postings
+  {
+    auto* field = segment.field("same");
+    ASSERT_NE(nullptr, field);
+    auto term = field->iterator(irs::SeekMode::NORMAL);
+    ASSERT_TRUE(term->seek(irs::ref_cast<irs::byte_type>(irs::string_ref("xyz"))));
+
+    auto it = segment.mask(term->postings(irs::IndexFeatures::NONE));
+    ASSERT_EQ(2, it->seek(1));
+    ASSERT_EQ(4, it->seek(3));
+    size_t count = 2;
+    for (; it->next(); ++count) { }
+    ASSERT_EQ(30, count);
+    ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+  }
+}
+
+const auto kDirectoriesWithEncryption =
+    ::testing::Values(
+      &tests::rot13_directory<&tests::memory_directory, 16>,
+      &tests::rot13_directory<&tests::fs_directory, 16>,
+      &tests::rot13_directory<&tests::mmap_directory, 16>,
+      &tests::rot13_directory<&tests::memory_directory, 7>,
+      &tests::rot13_directory<&tests::fs_directory, 7>,
+      &tests::rot13_directory<&tests::mmap_directory, 7>);
+
+const auto kDirectories =
+    ::testing::Values(
+      &tests::directory<&tests::memory_directory>,
+      &tests::directory<&tests::fs_directory>,
+      &tests::directory<&tests::mmap_directory>);
+
+#ifdef IRESEARCH_SSE2
+const auto kFormats =
+     ::testing::Values(tests::format_info{"1_6", "1_0"},
+                       tests::format_info{"1_6simd", "1_0"});
+#else
+const auto kFormats =
+     ::testing::Values(tests::format_info{"1_6", "1_0"});
+#endif
+
+// 1.6 specific tests
+INSTANTIATE_TEST_SUITE_P(
+    format_16_test,
+    format_16_test_case,
+    ::testing::Combine(kDirectoriesWithEncryption, kFormats),
+    format_16_test_case::to_string);
+
+// Generic tests
+INSTANTIATE_TEST_SUITE_P(
+    format_16_test,
+    format_test_case_with_encryption,
+    ::testing::Combine(kDirectoriesWithEncryption, kFormats),
+    format_test_case_with_encryption::to_string);
+
+INSTANTIATE_TEST_SUITE_P(
+    format_16_test,
+    format_test_case,
+    ::testing::Combine(kDirectories, kFormats),
+    format_test_case::to_string);
+
+}
@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+
+#include <bit>
+#include <set>
+
+#include "formats_test_case_base.hpp"
+#include "search/term_filter.hpp"
+#include "store/directory_attributes.hpp"
+
+namespace {
+
+using tests::format_test_case;
+using tests::format_test_case_with_encryption;
+
+class format_17_test_case : public format_test_case_with_encryption {
+ protected:
+  irs::document_mask read_mask(const irs::segment_meta& meta) {
+    irs::document_mask mask;
+    EXPECT_TRUE(codec()->get_document_mask_reader()->read(dir(), meta, mask));
+    return mask;
+  }
+
+  static irs::document_mask make_mask(irs::doc_id_t begin, irs::doc_id_t end) {
+    irs::document_mask mask;
+    for (; begin < end; ++begin) {
+      mask.emplace(begin);
+    }
+    return mask;
+  }
+
+  static size_t count_masks(const irs::segment_meta& meta) {
+    return std::count_if(
+      meta.files.begin(), meta.files.end(),
+      [](const std::string& file) { return file.ends_with(".doc_mask"); });
+  }
+};
+
+TEST_P(format_17_test_case, document_mask_update) {
+  auto writer = codec()->get_document_mask_writer();
+  irs::segment_meta meta("_1", nullptr);
+  irs::document_mask expected = make_mask(1, 101);
+
+  writer->write(dir(), meta, expected);
+  const auto base = writer->filename(meta);
+
+  // small mask is stacked on top of a larger one
+  meta.version = 2;
+  {
+    const irs::document_mask mask{ 500 };
+    ASSERT_TRUE(writer->update(dir(), meta, 0, mask).empty());
+    expected.insert(mask.begin(), mask.end());
+    ASSERT_EQ(expected, read_mask(meta));
+  }
+  const auto delta = writer->filename(meta);
+
+  // masks of the same size are merged
+  meta.version = 4;
+  {
+    const irs::document_mask mask{ 501 };
+    const auto unused = writer->update(dir(), meta, 2, mask);
+    ASSERT_EQ(std::vector<std::string>{ delta }, unused);
+    expected.insert(mask.begin(), mask.end());
+    ASSERT_EQ(expected, read_mask(meta));
+  }
+  const auto merged = writer->filename(meta);
+
+  // ensure stacked masks are read from their own files
+  {
+    irs::segment_meta base_meta("_1", nullptr);
+    irs::document_mask mask;
+    ASSERT_TRUE(codec()->get_document_mask_reader()->read(dir(), base_meta, mask));
+    ASSERT_EQ(make_mask(1, 101), mask);
+  }
+
+  // large mask absorbs all of the previous ones
+  meta.version = 6;
+  {
+    const auto mask = make_mask(1000, 1200);
+    auto unused = writer->update(dir(), meta, 4, mask);
+    std::sort(unused.begin(), unused.end());
+    std::vector<std::string> expected_unused{ base, merged };
+    std::sort(expected_unused.begin(), expected_unused.end());
+    ASSERT_EQ(expected_unused, unused);
+    expected.insert(mask.begin(), mask.end());
+
+    for (auto& file : unused) {
+      ASSERT_TRUE(dir().remove(file));
+    }
+    ASSERT_EQ(expected, read_mask(meta));
+  }
+
+  // update of a segment without deletes
+  {
+    irs::segment_meta empty("_2", nullptr);
+    empty.version = 2;
+    const irs::document_mask mask{ 1, 2, 3 };
+    ASSERT_TRUE(writer->update(dir(), empty, 0, mask).empty());
+    ASSERT_EQ(mask, read_mask(empty));
+  }
+}
+
+TEST_P(format_17_test_case, document_mask_update_legacy) {
+  auto legacy = irs::formats::get("1_6");
+  ASSERT_NE(nullptr, legacy);
+  auto writer = legacy->get_document_mask_writer();
+
+  irs::segment_meta meta("_1", nullptr);
+  writer->write(dir(), meta, irs::document_mask{ 1, 2 });
+  const auto prev = writer->filename(meta);
+
+  // legacy format rewrites the whole mask
+  meta.version = 2;
+  ASSERT_EQ(std::vector<std::string>{ prev },
+            writer->update(dir(), meta, 0, irs::document_mask{ 3 }));
+  ASSERT_TRUE(dir().remove(prev));
+
+  irs::document_mask mask;
+  ASSERT_TRUE(legacy->get_document_mask_reader()->read(dir(), meta, mask));
+  ASSERT_EQ((irs::document_mask{ 1, 2, 3 }), mask);
+}
+
+TEST_P(format_17_test_case, document_mask_update_shrinking) {
+  auto writer = codec()->get_document_mask_writer();
+  irs::segment_meta meta("_1", nullptr);
+  irs::document_mask expected;
+  std::set<std::string> files;
+
+  // every update removes slightly fewer documents than the previous one
+  irs::doc_id_t doc = irs::doc_limits::min();
+  uint64_t prev_version = 0;
+  for (irs::doc_id_t count = 100; count; --count) {
+    const auto mask = make_mask(doc, doc + count);
+    doc += count;
+    expected.insert(mask.begin(), mask.end());
+
+    if (files.empty()) {
+      writer->write(dir(), meta, mask);
+    } else {
+      meta.version = prev_version + 2;
+      for (auto& file : writer->update(dir(), meta, prev_version, mask)) {
+        ASSERT_EQ(1, files.erase(file));
+        ASSERT_TRUE(dir().remove(file));
+      }
+    }
+    files.emplace(writer->filename(meta));
+    prev_version = meta.version;
+
+    // each stacked mask is more than twice as large as the next one
+    ASSERT_LE(files.size(), size_t(std::bit_width(expected.size())));
+    ASSERT_EQ(expected, read_mask(meta));
+  }
+}
+
+TEST_P(format_17_test_case, remove_incrementally) {
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto remove = [this](std::initializer_list<irs::string_ref> names) {
+    auto writer = open_writer(irs::OM_APPEND);
+    for (const auto name : names) {
+      auto removal = std::make_unique<irs::by_term>();
+      *removal->mutable_field() = "name";
+      removal->mutable_options()->term = irs::ref_cast<irs::byte_type>(name);
+      writer->documents().remove(irs::filter::ptr(std::move(removal)));
+    }
+    writer->commit();
+  };
+
+  // small masks are stacked on top of a much larger one
+  // until they're merged with it
+  const std::tuple<std::initializer_list<irs::string_ref>, uint64_t, size_t> removals[] {
+    { { "A", "B", "C", "D", "E" }, 27, 1 },
+    { { "F" }, 26, 2 },
+    { { "G" }, 25, 2 },
+    { { "H" }, 24, 1 },
+    { { "A" }, 24, 1 }
+  };
+
+  for (auto& [names, live_docs_count, masks] : removals) {
+    remove(names);
+
+    auto reader = open_reader();
+    ASSERT_EQ(1, reader.size());
+    auto& segment = reader[0];
+    ASSERT_EQ(live_docs_count, segment.live_docs_count());
+    ASSERT_EQ(live_docs_count, segment.live_docs()->count());
+    ASSERT_EQ(masks, count_masks(reader.meta().meta.begin()->meta));
+
+    size_t count = 0;
+    for (auto it = segment.docs_iterator(); it->next(); ++count) { }
+    ASSERT_EQ(live_docs_count, count);
+  }
+
+  // removed documents stay removed
+  auto reader = open_reader();
+  auto& segment = reader[0];
+  for (const irs::doc_id_t doc : { 1, 2, 3, 4, 5, 6, 7, 8 }) {
+    ASSERT_FALSE(segment.live_docs()->test(doc));
+  }
+  ASSERT_TRUE(segment.live_docs()->test(9));
+}
+
+const auto kDirectoriesWithEncryption =
+    ::testing::Values(
+      &tests::rot13_directory<&tests::memory_directory, 16>,
+      &tests::rot13_directory<&tests::fs_directory, 16>,
+      &tests::rot13_directory<&tests::mmap_directory, 16>,
+      &tests::rot13_directory<&tests::memory_directory, 7>,
+      &tests::rot13_directory<&tests::fs_directory, 7>,
+      &tests::rot13_directory<&tests::mmap_directory, 7>);
+
+const auto kDirectories =
+    ::testing::Values(
+      &tests::directory<&tests::memory_directory>,
+      &tests::directory<&tests::fs_directory>,
+      &tests::directory<&tests::mmap_directory>);
+
+#ifdef IRESEARCH_SSE2
+const auto kFormats =
+     ::testing::Values(tests::format_info{"1_7", "1_0"},
+                       tests::format_info{"1_7simd", "1_0"});
+#else
+const auto kFormats =
+     ::testing::Values(tests::format_info{"1_7", "1_0"});
+#endif
+
+// 1.7 specific tests
+INSTANTIATE_TEST_SUITE_P(
+    format_17_test,
+    format_17_test_case,
+    ::testing::Combine(kDirectoriesWithEncryption, kFormats),
+    format_17_test_case::to_string);
+
+// Generic tests
+INSTANTIATE_TEST_SUITE_P(
+    format_17_test,
+    format_test_case_with_encryption,
+    ::testing::Combine(kDirectoriesWithEncryption, kFormats),
+    format_test_case_with_encryption::to_string);
+
+INSTANTIATE_TEST_SUITE_P(
+    format_17_test,
+    format_test_case,
+    ::testing::Combine(kDirectories, kFormats),
+    format_test_case::to_string);
+
+}
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "formats_test_case_base.hpp"
+#include "formats/formats_10.hpp"
+#include "formats/formats_10_attributes.hpp"
+#include "store/directory_attributes.hpp"
+
+namespace {
+
+using tests::format_test_case;
+using tests::format_test_case_with_encryption;
+
+class format_19_test_case : public tests::postings_test_case {
+ protected:
+  // postings with small gaps between documents
+  static postings_t dense_postings(irs::doc_id_t count) {
+    postings_t docs;
+    for (irs::doc_id_t i = 1; i <= count; ++i) {
+      const irs::doc_id_t doc = i + i / 8 + (i / 1000) * 100000;
+      docs.emplace_back(doc, 1 + doc % 5);
+    }
+    return docs;
+  }
+};
+
+TEST_P(format_19_test_case, postings_dense) {
+  constexpr irs::doc_id_t kCount = 3000;
+  constexpr auto kFeatures = irs::IndexFeatures::NONE;
+
+  auto codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
+  ASSERT_NE(nullptr, codec);
+  auto legacy = std::dynamic_pointer_cast<const irs::version10::format>(
+    irs::formats::get(irs::string_ref("1_9") == codec->type().name()
+                        ? "1_8" : "1_8simd"));
+  ASSERT_NE(nullptr, legacy);
+
+  const auto docs = dense_postings(kCount);
+  const auto written = write_postings(*codec, "segment", kFeatures, { docs });
+  const auto legacy_length = write_postings(*legacy, "legacy", kFeatures, { docs }).length;
+  // bitmaps are smaller than blocks of 2 bit deltas
+  ASSERT_LT(written.length, legacy_length);
+
+  std::vector<irs::version10::term_meta> metas;
+  auto reader = read_postings(*codec, "segment", kFeatures, written.data, metas);
+  ASSERT_EQ(1, metas.size());
+  auto& meta = metas.front();
+  ASSERT_EQ(kCount, meta.docs_count);
+
+  // every document can be reached
+  {
+    auto it = reader->iterator(kFeatures, kFeatures, meta);
+    for (auto& entry : docs) {
+      ASSERT_TRUE(it->next());
+      ASSERT_EQ(entry.first, it->value());
+    }
+    ASSERT_FALSE(it->next());
+  }
+
+  // seek over skipped blocks
+  {
+    auto it = reader->iterator(kFeatures, kFeatures, meta);
+    for (size_t i = 0; i < docs.size(); i += 97) {
+      const auto doc = docs[i].first;
+      ASSERT_EQ(doc, it->seek(doc));
+    }
+  }
+
+  // seek to a missing document
+  {
+    auto it = reader->iterator(kFeatures, kFeatures, meta);
+    ASSERT_EQ(docs[7].first, it->seek(docs[7].first - 1));
+    ASSERT_TRUE(it->next());
+    ASSERT_EQ(docs[8].first, it->value());
+  }
+}
+
+TEST_P(format_19_test_case, postings_dense_bit_union) {
+  constexpr irs::doc_id_t kCount = 3000;
+  constexpr size_t kBits = irs::bits_required<size_t>();
+
+  auto codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
+  ASSERT_NE(nullptr, codec);
+
+  const auto docs = dense_postings(kCount);
+
+  for (const auto features : { irs::IndexFeatures::NONE, irs::IndexFeatures::FREQ }) {
+    const std::string name = "segment" + std::to_string(size_t(features));
+    const auto data = write_postings(*codec, name, features, { docs }).data;
+
+    std::vector<irs::version10::term_meta> metas;
+    auto reader = read_postings(*codec, name, features, data, metas);
+    ASSERT_EQ(1, metas.size());
+    auto& meta = metas.front();
+    ASSERT_EQ(kCount, meta.docs_count);
+
+    // frequencies are read back intact
+    if (irs::IndexFeatures::NONE != features) {
+      auto it = reader->iterator(features, features, meta);
+      auto* freq = irs::get<irs::frequency>(*it);
+      ASSERT_NE(nullptr, freq);
+      for (auto [doc, doc_freq] : docs) {
+        ASSERT_TRUE(it->next());
+        ASSERT_EQ(doc, it->value());
+        ASSERT_EQ(doc_freq, freq->value);
+      }
+      ASSERT_FALSE(it->next());
+    }
+
+    const size_t words = docs.back().first / kBits + 1;
+    std::vector<size_t> expected(words);
+    for (auto& entry : docs) {
+      irs::set_bit(expected[entry.first / kBits], entry.first % kBits);
+    }
+
+    std::vector<size_t> actual(words);
+    bool provided = false;
+    ASSERT_EQ(kCount, reader->bit_union(
+      features,
+      [&provided, &meta]() -> const irs::term_meta* {
+        return std::exchange(provided, true) ? nullptr : &meta;
+      },
+      actual.data()));
+    ASSERT_EQ(expected, actual);
+  }
+}
+
+const auto kDirectoriesWithEncryption =
+    ::testing::Values(
+      &tests::rot13_directory<&tests::memory_directory, 16>,
+      &tests::rot13_directory<&tests::fs_directory, 16>,
+      &tests::rot13_directory<&tests::mmap_directory, 16>,
+      &tests::rot13_directory<&tests::memory_directory, 7>,
+      &tests::rot13_directory<&tests::fs_directory, 7>,
+      &tests::rot13_directory<&tests::mmap_directory, 7>);
+
+const auto kDirectories =
+    ::testing::Values(
+      &tests::directory<&tests::memory_directory>,
+      &tests::directory<&tests::fs_directory>,
+      &tests::directory<&tests::mmap_directory>);
+
+#ifdef IRESEARCH_SSE2
+const auto kFormats =
+     ::testing::Values(tests::format_info{"1_9", "1_0"},
+                       tests::format_info{"1_9simd", "1_0"});
+#else
+const auto kFormats =
+     ::testing::Values(tests::format_info{"1_9", "1_0"});
+#endif
+
+// 1.9 specific tests
+INSTANTIATE_TEST_SUITE_P(
+    format_19_test,
+    format_19_test_case,
+    ::testing::Combine(kDirectoriesWithEncryption, kFormats),
+    format_19_test_case::to_string);
+
+// Generic tests
+INSTANTIATE_TEST_SUITE_P(
+    format_19_test,
+    format_test_case_with_encryption,
+    ::testing::Combine(kDirectoriesWithEncryption, kFormats),
+    format_test_case_with_encryption::to_string);
+
+INSTANTIATE_TEST_SUITE_P(
+    format_19_test,
+    format_test_case,
+    ::testing::Combine(kDirectories, kFormats),
+    format_test_case::to_string);
+
+}
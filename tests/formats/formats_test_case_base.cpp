@@ -81,6 +81,86 @@ irs::column_info format_test_case::none_column_info() const noexcept {
       bool(dir().attributes().encryption()) };
 }
 
+postings_test_case::written_postings postings_test_case::write_postings(
+    const irs::version10::format& codec,
+    const std::string& name,
+    irs::IndexFeatures features,
+    const std::vector<postings_t>& terms) {
+  auto writer = codec.get_postings_writer(false);
+  EXPECT_NE(nullptr, writer);
+  written_postings written;
+
+  irs::doc_id_t max_doc = irs::doc_limits::min();
+  for (auto& term : terms) {
+    if (!term.empty()) {
+      max_doc = std::max(max_doc, term.back().first);
+    }
+  }
+
+  irs::flush_state state;
+  state.dir = &dir();
+  state.doc_count = max_doc + 1;
+  state.name = name;
+  state.index_features = features;
+
+  {
+    auto out = dir().create(name + ".attributes");
+    EXPECT_FALSE(!out);
+
+    writer->prepare(*out, state);
+    writer->begin_field(features);
+    writer->begin_block();
+    for (auto& term : terms) {
+      postings_iterator docs{term};
+      auto term_meta = writer->write(docs);
+      writer->encode(*out, *term_meta);
+      written.metas.emplace_back(
+        static_cast<irs::version10::term_meta&>(*term_meta));
+    }
+    writer->end();
+  }
+
+  EXPECT_TRUE(dir().length(written.length, name + ".doc"));
+
+  auto in = dir().open(name + ".attributes", irs::IOAdvice::NORMAL);
+  EXPECT_FALSE(!in);
+  written.data.resize(in->length());
+  in->read_bytes(&written.data[0], written.data.size());
+
+  return written;
+}
+
+irs::postings_reader::ptr postings_test_case::read_postings(
+    const irs::version10::format& codec,
+    const std::string& name,
+    irs::IndexFeatures features,
+    const irs::bstring& data,
+    std::vector<irs::version10::term_meta>& metas) {
+  irs::segment_meta segment;
+  segment.name = name;
+
+  irs::reader_state state;
+  state.dir = &dir();
+  state.meta = &segment;
+
+  auto in = dir().open(name + ".attributes", irs::IOAdvice::NORMAL);
+  EXPECT_FALSE(!in);
+
+  auto reader = codec.get_postings_reader();
+  EXPECT_NE(nullptr, reader);
+  reader->prepare(*in, state, features);
+
+  // terms of a block are decoded sequentially
+  metas.clear();
+  const auto* begin = data.c_str() + in->file_pointer();
+  for (const auto* end = data.c_str() + data.size(); begin < end;) {
+    begin += reader->decode(begin, features, metas.emplace_back());
+  }
+  EXPECT_EQ(data.c_str() + data.size(), begin);
+
+  return reader;
+}
+
 TEST_P(format_test_case, directory_artifact_cleaner) {
   tests::json_doc_generator gen{
     resource("simple_sequential.json"),
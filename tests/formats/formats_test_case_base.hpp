@@ -33,6 +33,8 @@
 #include "iql/query_builder.hpp"
 
 #include "analysis/token_attributes.hpp"
+#include "formats/formats_10.hpp"
+#include "formats/formats_10_attributes.hpp"
 #include "store/memory_directory.hpp"
 #include "utils/version_utils.hpp"
 
@@ -283,6 +285,89 @@ class format_test_case : public index_test_base {
 
 class format_test_case_with_encryption : public format_test_case { };
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                               Postings test case
+// ----------------------------------------------------------------------------
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief base for the tests writing postings directly via the postings
+///        writer of a format and reading them back via its postings reader
+//////////////////////////////////////////////////////////////////////////////
+class postings_test_case : public format_test_case_with_encryption {
+ public:
+  // documents of a term along with their in-document frequencies
+  using postings_t = std::vector<std::pair<irs::doc_id_t, uint32_t>>;
+
+  class postings_iterator final : public irs::doc_iterator {
+   public:
+    explicit postings_iterator(const postings_t& docs) noexcept
+      : it_{docs.begin()}, end_{docs.end()} {
+    }
+
+    virtual bool next() override {
+      if (it_ == end_) {
+        doc_.value = irs::doc_limits::eof();
+        return false;
+      }
+
+      doc_.value = it_->first;
+      freq_.value = it_->second;
+      ++it_;
+      return true;
+    }
+
+    virtual irs::doc_id_t value() const override {
+      return doc_.value;
+    }
+
+    virtual irs::doc_id_t seek(irs::doc_id_t target) override {
+      irs::seek(*this, target);
+      return value();
+    }
+
+    virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+      if (irs::type<irs::document>::id() == type) {
+        return &doc_;
+      }
+
+      if (irs::type<irs::frequency>::id() == type) {
+        return &freq_;
+      }
+
+      return nullptr;
+    }
+
+   private:
+    irs::document doc_;
+    irs::frequency freq_;
+    postings_t::const_iterator it_;
+    postings_t::const_iterator end_;
+  }; // postings_iterator
+
+  struct written_postings {
+    irs::bstring data; // encoded metadata of the terms
+    std::vector<irs::version10::term_meta> metas; // metadata of every term
+    uint64_t length; // length of '.doc' file
+  };
+
+  // writes postings of 'terms' as a single block of a term dictionary
+  // with 'codec' to segment 'name'
+  written_postings write_postings(
+    const irs::version10::format& codec,
+    const std::string& name,
+    irs::IndexFeatures features,
+    const std::vector<postings_t>& terms);
+
+  // returns reader of postings previously written to segment 'name',
+  // 'metas' are filled with decoded metadata of every term
+  irs::postings_reader::ptr read_postings(
+    const irs::version10::format& codec,
+    const std::string& name,
+    irs::IndexFeatures features,
+    const irs::bstring& data,
+    std::vector<irs::version10::term_meta>& metas);
+}; // postings_test_case
+
 } // tests
 
 namespace iresearch {
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index_tests.hpp"
+#include "index/column_values_reader.hpp"
+
+namespace {
+
+using namespace tests;
+
+class column_values_reader_test_case : public index_test_base {
+ protected:
+  void add_segments() {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+    gen.reset();
+    add_segment(gen, irs::OM_APPEND);
+  }
+
+  // reads a value via a fresh column iterator
+  static std::optional<irs::bstring> expected_value(
+      const irs::sub_reader& segment,
+      irs::string_ref field,
+      irs::doc_id_t doc) {
+    auto* column = segment.column(field);
+
+    if (!column) {
+      return std::nullopt;
+    }
+
+    auto it = column->iterator(false);
+    if (doc != it->seek(doc)) {
+      return std::nullopt;
+    }
+
+    auto* payload = irs::get<irs::payload>(*it);
+    return payload ? irs::bstring(payload->value) : irs::bstring();
+  }
+
+  static void assert_value(
+      const std::optional<irs::bstring>& expected,
+      irs::bytes_ref actual) {
+    ASSERT_EQ(!expected, actual.null());
+    if (expected) {
+      ASSERT_EQ(irs::bytes_ref(*expected), actual);
+    }
+  }
+};
+
+TEST_P(column_values_reader_test_case, read_segment) {
+  add_segments();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+  auto& segment = reader[0];
+
+  for (auto* field : { "name", "prefix", "duplicated", "missing" }) {
+    irs::column_values_reader values_reader(field);
+    ASSERT_EQ(field, values_reader.field());
+
+    // subsequent calls reuse the same column iterator, including
+    // the ones starting before the last read document
+    for (auto docs : { std::vector<irs::doc_id_t>{ 1, 2, 5, 6, 31, 32 },
+                       std::vector<irs::doc_id_t>{ 4, 7, 8 },
+                       std::vector<irs::doc_id_t>{ 32 },
+                       std::vector<irs::doc_id_t>{ 1 },
+                       std::vector<irs::doc_id_t>{ } }) {
+      std::vector<irs::bytes_ref> values(docs.size());
+      const size_t found = values_reader.read(segment, docs, values.data());
+
+      size_t expected_found = 0;
+      for (size_t i = 0; i < docs.size(); ++i) {
+        const auto expected = expected_value(segment, field, docs[i]);
+        expected_found += bool(expected);
+        assert_value(expected, values[i]);
+      }
+      ASSERT_EQ(expected_found, found);
+    }
+
+    values_reader.clear();
+  }
+}
+
+TEST_P(column_values_reader_test_case, read_index) {
+  add_segments();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+
+  const std::vector<irs::column_values_reader::doc_ref> docs{
+    { 1, 5 }, { 0, 31 }, { 1, 1 }, { 0, 2 }, { 0, 3 }, { 1, 32 }, { 0, 1 } };
+
+  irs::column_values_reader values_reader("prefix");
+
+  for (size_t attempt = 0; attempt < 2; ++attempt) {
+    std::vector<irs::bytes_ref> values(docs.size());
+    const size_t found = values_reader.read(reader, docs, values.data());
+
+    size_t expected_found = 0;
+    for (size_t i = 0; i < docs.size(); ++i) {
+      const auto expected = expected_value(
+        reader[docs[i].segment], "prefix", docs[i].doc);
+      expected_found += bool(expected);
+      assert_value(expected, values[i]);
+    }
+    ASSERT_EQ(expected_found, found);
+    ASSERT_LT(0, found);
+    ASSERT_GT(docs.size(), found);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  column_values_reader_test,
+  column_values_reader_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::directory<&tests::memory_directory>,
+      &tests::directory<&tests::fs_directory>,
+      &tests::directory<&tests::mmap_directory>),
+    ::testing::Values("1_0", "1_4")),
+  column_values_reader_test_case::to_string
+);
+
+}
@@ -64,6 +64,46 @@ TEST_P(all_filter_test_case, all_sequential) {
   ASSERT_EQ(&score, irs::get_mutable<irs::score>(it.get()));
 }
 
+TEST_P(all_filter_test_case, all_next_batch) {
+  // add segment
+  {
+    tests::json_doc_generator gen(
+       resource("simple_sequential.json"),
+       &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_NE(nullptr, rdr);
+  ASSERT_EQ(1, rdr->size());
+  auto& segment = rdr[0];
+
+  auto it = irs::all().prepare(*rdr)->execute(segment);
+  auto* doc = irs::get<irs::document>(*it);
+  ASSERT_TRUE(doc);
+
+  irs::doc_id_t docs[10];
+  uint32_t freqs[10];
+  irs::doc_id_t expected = irs::doc_limits::min();
+
+  for (size_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(10, it->next_batch(docs, freqs, 10));
+    for (size_t j = 0; j < 10; ++j) {
+      ASSERT_EQ(expected++, docs[j]);
+      ASSERT_EQ(0, freqs[j]);
+    }
+    ASSERT_EQ(expected - 1, it->value());
+    ASSERT_EQ(expected - 1, doc->value);
+  }
+
+  ASSERT_EQ(2, it->next_batch(docs, nullptr, 10));
+  ASSERT_EQ(31, docs[0]);
+  ASSERT_EQ(32, docs[1]);
+  ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+  ASSERT_EQ(0, it->next_batch(docs, nullptr, 10));
+  ASSERT_FALSE(it->next());
+}
+
 TEST_P(all_filter_test_case, all_order) {
   // add segment
   {
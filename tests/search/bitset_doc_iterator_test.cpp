@@ -925,4 +925,80 @@ TEST(bitset_iterator_test, seek_next) {
   }
 }
 
+TEST(bitset_iterator_test, next_batch) {
+  // empty bitset
+  {
+    irs::bitset bs(13);
+    irs::bitset_doc_iterator it(bs.begin(), bs.end());
+
+    irs::doc_id_t docs[4];
+    ASSERT_EQ(0, it.next_batch(docs, nullptr, 4));
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+  }
+
+  // sparse bitset
+  {
+    const size_t size = 1000;
+    irs::bitset bs(size);
+
+    std::vector<irs::doc_id_t> expected;
+    for (irs::doc_id_t i = 1; i < size; i += 1 + i % 7) {
+      bs.set(i);
+      expected.emplace_back(i);
+    }
+
+    for (size_t batch : { 1, 2, 5, 64, 65, 128, 1000 }) {
+      irs::bitset_doc_iterator it(bs.begin(), bs.end());
+      auto* doc = irs::get<irs::document>(it);
+      ASSERT_TRUE(bool(doc));
+
+      std::vector<irs::doc_id_t> docs(batch);
+      std::vector<uint32_t> freqs(batch, 42);
+      std::vector<irs::doc_id_t> actual;
+
+      for (;;) {
+        const size_t read = it.next_batch(docs.data(), freqs.data(), batch);
+        ASSERT_LE(read, batch);
+        actual.insert(actual.end(), docs.begin(), docs.begin() + read);
+        ASSERT_TRUE(std::all_of(freqs.begin(), freqs.begin() + read,
+                                [](uint32_t freq) { return 0 == freq; }));
+
+        if (read < batch) {
+          break;
+        }
+
+        ASSERT_EQ(docs.back(), it.value());
+        ASSERT_EQ(docs.back(), doc->value);
+      }
+
+      ASSERT_EQ(expected, actual);
+      ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+      ASSERT_EQ(0, it.next_batch(docs.data(), nullptr, batch));
+      ASSERT_FALSE(it.next());
+    }
+  }
+
+  // mixed with 'seek' and 'next'
+  {
+    irs::bitset bs(256);
+    for (irs::doc_id_t i : { 3, 5, 64, 65, 66, 127, 128, 200 }) {
+      bs.set(i);
+    }
+
+    irs::bitset_doc_iterator it(bs.begin(), bs.end());
+    irs::doc_id_t docs[3];
+    ASSERT_EQ(5, it.seek(4));
+    ASSERT_EQ(3, it.next_batch(docs, nullptr, 3));
+    ASSERT_EQ(64, docs[0]);
+    ASSERT_EQ(65, docs[1]);
+    ASSERT_EQ(66, docs[2]);
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(127, it.value());
+    ASSERT_EQ(2, it.next_batch(docs, nullptr, 3));
+    ASSERT_EQ(128, docs[0]);
+    ASSERT_EQ(200, docs[1]);
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+  }
+}
+
 #endif
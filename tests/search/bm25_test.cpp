@@ -24,6 +24,7 @@
 #include "tests_shared.hpp"
 #include "index/index_tests.hpp"
 #include "index/norm.hpp"
+#include "search/filter_test_case_base.hpp"
 #include "search/all_filter.hpp"
 #include "search/boolean_filter.hpp"
 #include "search/column_existence_filter.hpp"
@@ -79,6 +80,8 @@ class bm25_test_case : public index_test_base {
  protected:
   void test_query_norms(irs::type_info::type_id norm,
                         irs::feature_writer_factory_t handler);
+  void test_bulk_score(irs::type_info::type_id norm,
+                       irs::feature_writer_factory_t handler);
 };
 
 
@@ -1498,6 +1501,158 @@ TEST_P(bm25_test_case, test_order) {
   }
 }
 
+TEST_P(bm25_test_case, test_max_score) {
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential_order.json"),
+      [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        if (data.is_string()) { // field
+          doc.insert(std::make_shared<string_field>(name, data.str), true, false);
+        } else if (data.is_number()) { // seq
+          const auto value = std::to_string(data.as_number<uint64_t>());
+          doc.insert(std::make_shared<string_field>(name, value), false, true);
+        }
+    });
+    add_segment(gen);
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  assert_max_score(reader, irs::bm25_sort::make(), "field", { "0", "2", "7", "9" });
+}
+
+void bm25_test_case::test_bulk_score(irs::type_info::type_id norm,
+                                     irs::feature_writer_factory_t handler) {
+  {
+    std::vector<irs::type_info::type_id> extra_features;
+    if (handler) {
+      extra_features.emplace_back(norm);
+    }
+
+    // terms occur in more documents than scored by a single kernel call
+    const auto data = make_digit_docs(500);
+    tests::json_doc_generator gen(
+      data.c_str(),
+      [&extra_features](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        if (data.is_string()) { // field
+          doc.insert(
+            std::make_shared<string_field>(
+              name, data.str, irs::IndexFeatures::NONE,
+              extra_features),
+            true, false);
+        }
+    });
+
+    irs::index_writer::init_options opts;
+    opts.features = [&](irs::type_info::type_id id) {
+      irs::column_info info{irs::type<irs::compression::lz4>::get(), {}, false};
+
+      if (handler && id == norm) {
+        return std::make_pair(info, handler);
+      }
+
+      return std::make_pair(info, irs::feature_writer_factory_t{});
+    };
+
+    add_segment(gen, irs::OM_CREATE, opts);
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+  auto& segment = *(reader.begin());
+  const auto* field = segment.field("field");
+  ASSERT_NE(nullptr, field);
+
+  for (auto& scorer : std::initializer_list<std::function<irs::sort::ptr()>>{
+         [] { return std::make_unique<irs::bm25_sort>(); },
+         [] { return std::make_unique<irs::bm25_sort>(irs::bm25_sort::K(), 0.f); },
+         [] { return std::make_unique<irs::bm25_sort>(0.5f, 0.3f, true); } }) {
+    irs::order order;
+    order.add(true, scorer());
+    auto prepared_order = order.prepare();
+    auto& bucket = *prepared_order.begin()->bucket;
+
+    for (auto* term : { "0", "2", "5", "7", "9" }) {
+      const auto value = irs::ref_cast<irs::byte_type>(irs::string_ref(term));
+
+      // scores evaluated document by document
+      std::vector<irs::doc_id_t> docs;
+      std::vector<float_t> expected;
+      {
+        irs::by_term filter;
+        *filter.mutable_field() = "field";
+        filter.mutable_options()->term = value;
+
+        auto prepared = filter.prepare(reader, prepared_order);
+        auto it = prepared->execute(segment, prepared_order);
+        auto& score = irs::score::get(*it);
+        // documents read via 'next_batch(...)' may be scored at once
+        ASSERT_TRUE(score.bulk);
+
+        while (it->next()) {
+          docs.emplace_back(it->value());
+          expected.emplace_back(prepared_order.get<float_t>(score.evaluate(), 0));
+        }
+      }
+      ASSERT_LT(irs::bulk_score_function::kBlockSize, docs.size());
+
+      auto terms = field->iterator(irs::SeekMode::NORMAL);
+      ASSERT_TRUE(terms->seek(value));
+      terms->read();
+
+      std::vector<uint32_t> freqs;
+      {
+        auto it = terms->postings(irs::IndexFeatures::FREQ);
+        auto* freq = irs::get<irs::frequency>(*it);
+        ASSERT_NE(nullptr, freq);
+
+        while (it->next()) {
+          freqs.emplace_back(freq->value);
+        }
+      }
+      ASSERT_EQ(docs.size(), freqs.size());
+
+      // collect statistics the same way the filter does
+      irs::bstring stats(prepared_order.stats_size(), 0);
+      {
+        auto field_collector = bucket.prepare_field_collector();
+        ASSERT_NE(nullptr, field_collector);
+        field_collector->collect(segment, *field);
+        auto term_collector = bucket.prepare_term_collector();
+        ASSERT_NE(nullptr, term_collector);
+        term_collector->collect(segment, *field, *terms);
+        bucket.collect(&stats[0], reader, field_collector.get(), term_collector.get());
+      }
+
+      auto bulk_score = bucket.prepare_bulk_scorer(
+        segment, *field, stats.c_str(), irs::no_boost());
+      ASSERT_TRUE(bulk_score);
+
+      // score all documents at once
+      std::vector<float_t> actual(docs.size());
+      bulk_score(docs.data(), freqs.data(), docs.size(), actual.data());
+
+      for (size_t i = 0; i < docs.size(); ++i) {
+        ASSERT_FLOAT_EQ(expected[i], actual[i]);
+      }
+
+      // score documents one by one
+      for (size_t i = 0; i < docs.size(); ++i) {
+        float_t score;
+        bulk_score(docs.data() + i, freqs.data() + i, 1, &score);
+        ASSERT_FLOAT_EQ(expected[i], score);
+      }
+    }
+  }
+}
+
+TEST_P(bm25_test_case, test_bulk_score) {
+  test_bulk_score(irs::type<irs::Norm>::id(), &irs::Norm::MakeWriter);
+}
+
+TEST_P(bm25_test_case, test_bulk_score_no_norms) {
+  test_bulk_score(irs::type<irs::Norm>::id(), {});
+}
+
 #endif // IRESEARCH_DLL
 
 INSTANTIATE_TEST_SUITE_P(
@@ -1518,6 +1673,14 @@ TEST_P(bm25_test_case_14, test_query_norms) {
   test_query_norms(irs::type<irs::Norm2>::id(), &irs::Norm2::MakeWriter);
 }
 
+#ifndef IRESEARCH_DLL
+
+TEST_P(bm25_test_case_14, test_bulk_score) {
+  test_bulk_score(irs::type<irs::Norm2>::id(), &irs::Norm2::MakeWriter);
+}
+
+#endif // IRESEARCH_DLL
+
 INSTANTIATE_TEST_SUITE_P(
   bm25_test_14,
   bm25_test_case_14,
@@ -1530,4 +1693,63 @@ INSTANTIATE_TEST_SUITE_P(
   bm25_test_case_14::to_string
 );
 
+class bm25_test_case_15 : public bm25_test_case { };
+
+TEST_P(bm25_test_case_15, test_max_score_blocks) {
+  {
+    // terms occur in several blocks of postings
+    const auto data = make_digit_docs(2000);
+    tests::json_doc_generator gen(
+      data.c_str(),
+      [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        if (data.is_string()) { // field
+          doc.insert(std::make_shared<string_field>(name, data.str), true, false);
+        }
+    });
+    add_segment(gen);
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+
+  // postings expose block-level bounds
+  {
+    irs::order order;
+    order.add<irs::bm25_sort>(true);
+    auto prepared_order = order.prepare();
+
+    irs::by_term filter;
+    *filter.mutable_field() = "field";
+    filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("7"));
+
+    auto docs = filter.prepare(reader, prepared_order)->execute(reader[0], prepared_order);
+    ASSERT_NE(nullptr, irs::get<irs::impact>(*docs));
+    auto& score = irs::score::get(*docs);
+    ASSERT_TRUE(score.bounds.block);
+    ASSERT_NE(nullptr, score.bounds.block_ctx);
+    const float_t bound = score.bounds.block(score.bounds.block_ctx, 1);
+    ASSERT_LE(bound, score.bounds.block(score.bounds.block_ctx, 2));
+
+    // bounds are forwarded along with the score
+    irs::score forwarded;
+    forwarded.reset(score);
+    ASSERT_EQ(score.bounds.block, forwarded.bounds.block);
+    ASSERT_EQ(bound, forwarded.bounds.block(forwarded.bounds.block_ctx, 1));
+  }
+
+  assert_max_score(reader, irs::bm25_sort::make(), "field", { "0", "2", "7", "9" });
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  bm25_test_15,
+  bm25_test_case_15,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::directory<&tests::memory_directory>,
+      &tests::directory<&tests::fs_directory>,
+      &tests::directory<&tests::mmap_directory>),
+    ::testing::Values("1_5")),
+  bm25_test_case_15::to_string
+);
+
 }
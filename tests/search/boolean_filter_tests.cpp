@@ -9858,6 +9858,89 @@ TEST(block_disjunction_test, scored_seek_next_no_readahead) {
   }
 }
 
+TEST(block_disjunction_test, next_batch) {
+  std::vector<std::vector<irs::doc_id_t>> docs{
+    { 1, 2, 5, 7, 9, 11, 45, 65, 78, 127, 128, 129, 300, 1145, 111165 },
+    { 1, 3, 6, 63, 64, 65, 66, 190, 191, 192, 193, 1111178 },
+    { 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192 }
+  };
+  const auto expected = detail::union_all(docs);
+
+  auto assert_batches = [&](auto&& make_iterator) {
+    for (size_t batch : { 1, 2, 3, 7, 64, 100 }) {
+      auto it = make_iterator();
+      auto* doc = irs::get<irs::document>(it);
+      ASSERT_TRUE(bool(doc));
+
+      std::vector<irs::doc_id_t> result;
+      std::vector<irs::doc_id_t> buf(batch);
+      std::vector<uint32_t> freqs(batch, 42);
+
+      for (;;) {
+        const size_t read = it.next_batch(buf.data(), freqs.data(), batch);
+        ASSERT_LE(read, batch);
+        result.insert(result.end(), buf.begin(), buf.begin() + read);
+        ASSERT_TRUE(std::all_of(freqs.begin(), freqs.begin() + read,
+                                [](uint32_t freq) { return 0 == freq; }));
+
+        if (read < batch) {
+          break;
+        }
+
+        ASSERT_EQ(buf.back(), doc->value);
+        ASSERT_EQ(buf.back(), it.value());
+      }
+
+      ASSERT_EQ(expected, result);
+      ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+      ASSERT_EQ(0, it.next_batch(buf.data(), nullptr, batch));
+      ASSERT_FALSE(it.next());
+    }
+  };
+
+  {
+    using disjunction = irs::block_disjunction<
+      irs::doc_iterator::ptr,
+      irs::block_disjunction_traits<false, irs::MatchType::MATCH, false, 1>>;
+
+    assert_batches([&docs]() {
+      return disjunction(detail::execute_all<disjunction::adapter>(docs));
+    });
+  }
+
+  {
+    using disjunction = irs::block_disjunction<
+      irs::doc_iterator::ptr,
+      irs::block_disjunction_traits<false, irs::MatchType::MATCH, false, 2>>;
+
+    assert_batches([&docs]() {
+      return disjunction(detail::execute_all<disjunction::adapter>(docs));
+    });
+  }
+
+  // mixed with 'next' and 'seek'
+  {
+    using disjunction = irs::block_disjunction<
+      irs::doc_iterator::ptr,
+      irs::block_disjunction_traits<false, irs::MatchType::MATCH, false, 1>>;
+
+    disjunction it(detail::execute_all<disjunction::adapter>(docs));
+    irs::doc_id_t buf[4];
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(1, it.value());
+    ASSERT_EQ(4, it.next_batch(buf, nullptr, 4));
+    ASSERT_EQ((std::vector<irs::doc_id_t>{ 2, 3, 4, 5 }),
+              (std::vector<irs::doc_id_t>(std::begin(buf), std::end(buf))));
+    ASSERT_EQ(5, it.value());
+    ASSERT_EQ(64, it.seek(64));
+    ASSERT_EQ(4, it.next_batch(buf, nullptr, 4));
+    ASSERT_EQ((std::vector<irs::doc_id_t>{ 65, 66, 78, 127 }),
+              (std::vector<irs::doc_id_t>(std::begin(buf), std::end(buf))));
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(128, it.value());
+  }
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--         disjunction (iterator0 OR iterator1 OR iterator2 OR ...)
 // ----------------------------------------------------------------------------
@@ -10842,6 +10925,72 @@ TEST(disjunction_test, scored_seek_next) {
   }
 }
 
+TEST(disjunction_test, next_batch) {
+  std::vector<std::vector<irs::doc_id_t>> docs{
+    { 1, 2, 5, 7, 9, 11, 45 },
+    { 1, 5, 6, 12, 29 },
+    { 1, 5, 6, 30, 31, 32, 33 }
+  };
+  const auto expected = detail::union_all(docs);
+
+  auto assert_batches = [&](auto&& make_iterator) {
+    for (size_t batch : { size_t(1), size_t(2), size_t(3), expected.size(), expected.size() + 1 }) {
+      auto it = make_iterator();
+
+      std::vector<irs::doc_id_t> result;
+      std::vector<irs::doc_id_t> buf(batch);
+      std::vector<uint32_t> freqs(batch, 42);
+
+      for (;;) {
+        const size_t read = it.next_batch(buf.data(), freqs.data(), batch);
+        ASSERT_LE(read, batch);
+        result.insert(result.end(), buf.begin(), buf.begin() + read);
+        ASSERT_TRUE(std::all_of(freqs.begin(), freqs.begin() + read,
+                                [](uint32_t freq) { return 0 == freq; }));
+
+        if (read < batch) {
+          break;
+        }
+
+        ASSERT_EQ(buf.back(), it.value());
+      }
+
+      ASSERT_EQ(expected, result);
+      ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+      ASSERT_EQ(0, it.next_batch(buf.data(), nullptr, batch));
+    }
+  };
+
+  {
+    using disjunction = irs::disjunction<irs::doc_iterator::ptr>;
+
+    assert_batches([&docs]() {
+      return disjunction(detail::execute_all<disjunction::adapter>(docs));
+    });
+  }
+
+  {
+    using disjunction = irs::small_disjunction<irs::doc_iterator::ptr>;
+
+    assert_batches([&docs]() {
+      return disjunction(detail::execute_all<disjunction::adapter>(docs));
+    });
+  }
+
+  // unary disjunction delegates to the underlying iterator
+  {
+    using disjunction = irs::unary_disjunction<irs::doc_iterator::ptr>;
+
+    auto itrs = detail::execute_all<disjunction::doc_iterator_t>({ docs.front() });
+    disjunction it(std::move(itrs.front()));
+    irs::doc_id_t buf[10];
+    ASSERT_EQ(docs.front().size(), it.next_batch(buf, nullptr, 10));
+    ASSERT_EQ(docs.front(),
+              (std::vector<irs::doc_id_t>(buf, buf + docs.front().size())));
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+  }
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--  Minimum match count: iterator0 OR iterator1 OR iterator2 OR ...
 // ----------------------------------------------------------------------------
@@ -13462,6 +13611,181 @@ TEST(conjunction_test, scored_seek_next) {
   }
 }
 
+TEST(block_conjunction_test, next) {
+  using conjunction = irs::block_conjunction;
+  auto shortest = [](const std::vector<irs::doc_id_t>& lhs, const std::vector<irs::doc_id_t>& rhs) {
+    return lhs.size() < rhs.size();
+  };
+
+  auto intersect = [](const std::vector<std::vector<irs::doc_id_t>>& docs) {
+    auto result = docs.front();
+    for (auto it = docs.begin() + 1; it != docs.end(); ++it) {
+      std::vector<irs::doc_id_t> tmp;
+      std::set_intersection(result.begin(), result.end(),
+                            it->begin(), it->end(),
+                            std::back_inserter(tmp));
+      result = std::move(tmp);
+    }
+    return result;
+  };
+
+  auto sequence = [](irs::doc_id_t begin, irs::doc_id_t end, irs::doc_id_t step) {
+    std::vector<irs::doc_id_t> docs;
+    for (; begin < end; begin += step) {
+      docs.emplace_back(begin);
+    }
+    return docs;
+  };
+
+  const std::vector<std::vector<std::vector<irs::doc_id_t>>> cases{
+    // simple case
+    { { 1, 5, 6 },
+      { 1, 2, 5, 7, 9, 11, 45 },
+      { 1, 5, 6, 12, 29 },
+      { 1, 5, 79, 101, 141, 1025, 1101 } },
+    // no intersection
+    { { 1, 3, 5, 7 },
+      { 2, 4, 6, 8 } },
+    // multiple blocks, comparable sizes
+    { sequence(1, 10000, 2),
+      sequence(1, 10000, 3),
+      sequence(1, 10000, 5) },
+    // skewed sizes, the longest one is probed via seek
+    { sequence(1, 100000, 1),
+      sequence(7, 100000, 997),
+      sequence(1, 100000, 7) },
+    // one of the iterators is exhausted early
+    { sequence(1, 300, 1),
+      sequence(1, 10000, 2) }
+  };
+
+  for (auto& docs : cases) {
+    const auto expected = intersect(docs);
+
+    conjunction it(detail::execute_all<irs::doc_iterator::ptr>(docs));
+    ASSERT_EQ(docs.size(), it.size());
+    auto* doc = irs::get<irs::document>(it);
+    ASSERT_TRUE(bool(doc));
+    ASSERT_TRUE(irs::score::get(it).is_default());
+    ASSERT_EQ(std::min_element(docs.begin(), docs.end(), shortest)->size(), irs::cost::extract(it));
+    ASSERT_EQ(irs::doc_limits::invalid(), it.value());
+
+    std::vector<irs::doc_id_t> result;
+    while (it.next()) {
+      result.push_back(it.value());
+      ASSERT_EQ(it.value(), doc->value);
+    }
+    ASSERT_FALSE(it.next());
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+    ASSERT_EQ(expected, result);
+  }
+}
+
+TEST(block_conjunction_test, seek_next) {
+  using conjunction = irs::block_conjunction;
+
+  {
+    std::vector<std::vector<irs::doc_id_t>> docs{
+      { 1, 2, 4, 5, 7, 8, 9, 11, 14, 45 },
+      { 1, 4, 5, 6, 8, 12, 14, 29 },
+      { 1, 4, 5, 8, 14 }
+    };
+
+    conjunction it(detail::execute_all<irs::doc_iterator::ptr>(docs));
+    ASSERT_EQ(irs::doc_limits::invalid(), it.value());
+    ASSERT_EQ(4, it.seek(3));
+    ASSERT_EQ(4, it.seek(2)); // seek backwards
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(5, it.value());
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(8, it.value());
+    ASSERT_EQ(14, it.seek(14));
+    ASSERT_FALSE(it.next());
+    ASSERT_EQ(irs::doc_limits::eof(), it.value());
+    ASSERT_EQ(irs::doc_limits::eof(), it.seek(5));
+    ASSERT_FALSE(it.next());
+  }
+
+  // seek over blocks
+  {
+    std::vector<std::vector<irs::doc_id_t>> docs(2);
+    for (irs::doc_id_t i = 1; i < 100000; ++i) {
+      docs[0].emplace_back(i);
+      if (0 == i % 3) {
+        docs[1].emplace_back(i);
+      }
+    }
+
+    conjunction it(detail::execute_all<irs::doc_iterator::ptr>(docs));
+    ASSERT_EQ(3, it.seek(1));
+    ASSERT_EQ(1002, it.seek(1001));
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(1005, it.value());
+    ASSERT_EQ(50001, it.seek(50000));
+    ASSERT_EQ(99999, it.seek(99998));
+    ASSERT_FALSE(it.next());
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+  }
+}
+
+TEST(block_conjunction_test, next_batch) {
+  using conjunction = irs::block_conjunction;
+
+  std::vector<std::vector<irs::doc_id_t>> docs(3);
+  std::vector<irs::doc_id_t> expected;
+  for (irs::doc_id_t i = 1; i < 20000; ++i) {
+    docs[0].emplace_back(i);
+    if (0 == i % 2) {
+      docs[1].emplace_back(i);
+    }
+    if (0 == i % 3) {
+      docs[2].emplace_back(i);
+    }
+    if (0 == i % 6) {
+      expected.emplace_back(i);
+    }
+  }
+
+  for (size_t batch : { size_t(1), size_t(5), conjunction::kBlockSize, size_t(1000) }) {
+    conjunction it(detail::execute_all<irs::doc_iterator::ptr>(docs));
+
+    std::vector<irs::doc_id_t> result;
+    std::vector<irs::doc_id_t> buf(batch);
+    std::vector<uint32_t> freqs(batch, 42);
+
+    for (;;) {
+      const size_t read = it.next_batch(buf.data(), freqs.data(), batch);
+      ASSERT_LE(read, batch);
+      result.insert(result.end(), buf.begin(), buf.begin() + read);
+      ASSERT_TRUE(std::all_of(freqs.begin(), freqs.begin() + read,
+                              [](uint32_t freq) { return 0 == freq; }));
+
+      if (read < batch) {
+        break;
+      }
+
+      ASSERT_EQ(buf.back(), it.value());
+    }
+
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+    ASSERT_EQ(expected, result);
+  }
+
+  // mixed with seek and next
+  {
+    conjunction it(detail::execute_all<irs::doc_iterator::ptr>(docs));
+    irs::doc_id_t buf[3];
+    ASSERT_EQ(600, it.seek(599));
+    ASSERT_EQ(3, it.next_batch(buf, nullptr, 3));
+    ASSERT_EQ(606, buf[0]);
+    ASSERT_EQ(612, buf[1]);
+    ASSERT_EQ(618, buf[2]);
+    ASSERT_EQ(618, it.value());
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(624, it.value());
+  }
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                      iterator0 AND NOT iterator1
 // ----------------------------------------------------------------------------
@@ -14111,6 +14435,112 @@ TEST_P(boolean_filter_test_case, and_sequential) {
   }
 }
 
+TEST_P(boolean_filter_test_case, and_execution_strategy) {
+  constexpr irs::doc_id_t kDocs = 10000;
+
+  // add segment
+  {
+    auto writer = open_writer();
+    {
+      auto ctx = writer->documents();
+      for (irs::doc_id_t i = 0; i < kDocs; ++i) {
+        auto doc = ctx.insert();
+        const auto two = std::make_shared<tests::string_field>("two", std::to_string(i % 2));
+        doc.insert<irs::Action::INDEX>(*two);
+        const auto three = std::make_shared<tests::string_field>("three", std::to_string(i % 3));
+        doc.insert<irs::Action::INDEX>(*three);
+        const auto rare = std::make_shared<tests::string_field>("rare", std::to_string(i % 500));
+        doc.insert<irs::Action::INDEX>(*rare);
+      }
+    }
+    writer->commit();
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  ASSERT_EQ(kDocs, rdr[0].docs_count());
+
+  auto expected = [](auto&& pred) {
+    docs_t docs;
+    for (irs::doc_id_t i = 0; i < kDocs; ++i) {
+      if (pred(i)) {
+        docs.emplace_back(i + irs::doc_limits::min());
+      }
+    }
+    return docs;
+  };
+
+  // dense sub-iterators, intersected via bitsets, cost is exact
+  {
+    irs::And root;
+    append<irs::by_term>(root, "two", "0");
+    append<irs::by_term>(root, "three", "0");
+    const auto docs = expected([](auto i) { return 0 == i % 6; });
+    check_query(root, docs, costs_t{ docs.size() }, rdr);
+  }
+
+  // dense sub-iterators with exclusion
+  {
+    irs::And root;
+    append<irs::by_term>(root, "two", "0");
+    append<irs::by_term>(root, "three", "0");
+    root.add<irs::Not>().filter<irs::by_term>() =
+      make_filter<irs::by_term>("rare", "0");
+    const auto docs = expected([](auto i) { return 0 == i % 6 && 0 != i % 500; });
+    check_query(root, docs, costs_t{ docs.size() }, rdr);
+  }
+
+  // sparse lead sub-iterator, intersected via blocks, cost of the lead one
+  {
+    irs::And root;
+    append<irs::by_term>(root, "two", "0");
+    append<irs::by_term>(root, "three", "0");
+    append<irs::by_term>(root, "rare", "12");
+    const auto docs = expected([](auto i) { return 0 == i % 6 && 12 == i % 500; });
+    check_query(root, docs, costs_t{ kDocs / 500 }, rdr);
+  }
+
+  // sparse lead sub-iterator with exclusion
+  {
+    irs::And root;
+    append<irs::by_term>(root, "rare", "12");
+    append<irs::by_term>(root, "two", "0");
+    root.add<irs::Not>().filter<irs::by_term>() =
+      make_filter<irs::by_term>("three", "0");
+    const auto docs = expected([](auto i) { return 12 == i % 500 && 0 != i % 3; });
+    check_query(root, docs, costs_t{ kDocs / 500 }, rdr);
+  }
+
+  // pure conjunction via min match
+  {
+    irs::Or root;
+    root.min_match_count(2);
+    append<irs::by_term>(root, "two", "1");
+    append<irs::by_term>(root, "three", "2");
+    const auto docs = expected([](auto i) { return 1 == i % 2 && 2 == i % 3; });
+    check_query(root, docs, costs_t{ docs.size() }, rdr);
+  }
+
+  // scored conjunction matches the same documents
+  {
+    irs::And root;
+    append<irs::by_term>(root, "two", "0");
+    append<irs::by_term>(root, "three", "0");
+
+    irs::order ord;
+    ord.add<irs::bm25_sort>(false);
+    auto prepared_order = ord.prepare();
+    auto prepared = root.prepare(rdr, prepared_order);
+    auto it = prepared->execute(rdr[0], prepared_order);
+
+    docs_t result;
+    while (it->next()) {
+      result.emplace_back(it->value());
+    }
+    ASSERT_EQ(expected([](auto i) { return 0 == i % 6; }), result);
+  }
+}
+
 TEST_P(boolean_filter_test_case, not_standalone_sequential_ordered) {
   // add segment
   {
@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "search/boolean_filter.hpp"
+#include "search/column_range_filter.hpp"
+#include "search/term_filter.hpp"
+
+namespace {
+
+// indexes granular terms of a value and stores its most precise term
+class column_long_field : public tests::long_field {
+ public:
+  column_long_field() {
+    this->features_.emplace_back(irs::type<irs::granularity_prefix>::id());
+  }
+
+  bool write(irs::data_output& out) const override {
+    using traits_t = irs::numeric_utils::numeric_traits<int64_t>;
+
+    irs::byte_type buf[traits_t::size()];
+    const auto size = traits_t::encode(value(), buf);
+    out.write_bytes(buf, size);
+    return true;
+  }
+};
+
+void column_range_field_factory(
+    tests::document& doc,
+    const std::string& name,
+    const tests::json_doc_generator::json_value& data) {
+  if (data.is_string()) {
+    doc.insert(std::make_shared<tests::string_field>(name, data.str),
+               true, false);
+  } else if (data.is_number()) {
+    doc.insert(std::make_shared<column_long_field>());
+    auto& field = (doc.indexed.end() - 1).as<tests::long_field>();
+    field.name(name);
+    field.value(data.as_number<int64_t>());
+  }
+}
+
+irs::by_column_range make_filter(
+    const irs::string_ref& field,
+    int64_t min, irs::BoundType min_type,
+    int64_t max, irs::BoundType max_type,
+    size_t selectivity) {
+  irs::by_column_range filter;
+  *filter.mutable_field() = field;
+  auto& opts = *filter.mutable_options();
+  opts.selectivity = selectivity;
+
+  if (irs::BoundType::UNBOUNDED != min_type) {
+    irs::numeric_token_stream stream;
+    stream.reset(min);
+    irs::set_granular_term(opts.range.min, stream);
+    opts.range.min_type = min_type;
+  }
+
+  if (irs::BoundType::UNBOUNDED != max_type) {
+    irs::numeric_token_stream stream;
+    stream.reset(max);
+    irs::set_granular_term(opts.range.max, stream);
+    opts.range.max_type = max_type;
+  }
+
+  return filter;
+}
+
+irs::by_granular_range make_granular_filter(const irs::by_column_range& filter) {
+  irs::by_granular_range q;
+  *q.mutable_field() = filter.field();
+  q.mutable_options()->range = filter.options().range;
+  return q;
+}
+
+class column_range_filter_test_case : public tests::filter_test_case_base {
+ protected:
+  std::vector<irs::doc_id_t> execute(
+      const irs::filter& filter,
+      const irs::index_reader& rdr) {
+    auto prepared = filter.prepare(rdr, irs::order::prepared::unordered());
+    EXPECT_NE(nullptr, prepared);
+
+    std::vector<irs::doc_id_t> docs;
+    for (auto& segment : rdr) {
+      auto it = prepared->execute(segment);
+      EXPECT_NE(nullptr, irs::get<irs::document>(*it));
+
+      while (it->next()) {
+        docs.emplace_back(it->value());
+      }
+    }
+    return docs;
+  }
+};
+
+TEST_P(column_range_filter_test_case, by_range_sequential) {
+  // add segment
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &column_range_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr->size());
+
+  constexpr irs::BoundType kBounds[] {
+    irs::BoundType::UNBOUNDED,
+    irs::BoundType::INCLUSIVE,
+    irs::BoundType::EXCLUSIVE
+  };
+
+  // results must match the ones of term expansion
+  // regardless of the chosen execution strategy
+  for (const std::string field : { "seq", "value" }) {
+    for (int64_t min = -1; min < 130; min += 7) {
+      for (int64_t max = min; max < 140; max += 11) {
+        for (auto min_type : kBounds) {
+          for (auto max_type : kBounds) {
+            SCOPED_TRACE(testing::Message("field=") << field
+                         << " min=" << min << " max=" << max);
+
+            const auto expected = execute(
+              make_granular_filter(make_filter(field, min, min_type,
+                                               max, max_type, 0)),
+              *rdr);
+
+            for (size_t selectivity : { size_t(0), size_t(16), size_t(1) << 20 }) {
+              ASSERT_EQ(expected, execute(make_filter(field, min, min_type, max,
+                                                      max_type, selectivity),
+                                          *rdr));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // missing column
+  ASSERT_TRUE(execute(make_filter("missing", 0, irs::BoundType::INCLUSIVE,
+                                  10, irs::BoundType::INCLUSIVE, 0),
+                      *rdr).empty());
+
+  // empty range
+  ASSERT_TRUE(execute(make_filter("seq", 10, irs::BoundType::INCLUSIVE,
+                                  10, irs::BoundType::EXCLUSIVE, 0),
+                      *rdr).empty());
+  ASSERT_TRUE(execute(make_filter("seq", 11, irs::BoundType::INCLUSIVE,
+                                  10, irs::BoundType::INCLUSIVE, 0),
+                      *rdr).empty());
+}
+
+TEST_P(column_range_filter_test_case, by_range_conjunction) {
+  // add segment
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &column_range_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr->size());
+  auto& segment = (*rdr)[0];
+
+  // column scan
+  {
+    auto filter = make_filter("value", 100, irs::BoundType::INCLUSIVE,
+                              123, irs::BoundType::INCLUSIVE, 0);
+    auto prepared = filter.prepare(*rdr, irs::order::prepared::unordered());
+    auto it = prepared->execute(segment);
+    ASSERT_NE(nullptr, it);
+    ASSERT_NE(nullptr, irs::get<irs::document>(*it));
+
+    auto* column = segment.column("value");
+    ASSERT_NE(nullptr, column);
+    ASSERT_EQ(column->size(), irs::cost::extract(*it));
+
+    // verification of the target document
+    ASSERT_EQ(1, it->seek(1));  // "value":100
+    ASSERT_EQ(1, it->seek(1));
+    ASSERT_EQ(3, it->seek(3));  // "value":123
+    ASSERT_EQ(5, it->seek(4));  // "value":12, next is "value":100
+    ASSERT_EQ(5, it->value());
+    ASSERT_TRUE(irs::doc_limits::eof(it->seek(irs::doc_limits::eof())));
+    ASSERT_FALSE(it->next());
+  }
+
+  // range inside a selective conjunction
+  {
+    irs::And root;
+    auto& name = root.add<irs::by_term>();
+    *name.mutable_field() = "name";
+    name.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("C"));
+
+    auto& range = root.add<irs::by_column_range>();
+    range = make_filter("value", 100, irs::BoundType::INCLUSIVE,
+                        123, irs::BoundType::INCLUSIVE, 0);
+
+    check_query(root, docs_t{ 3 }, rdr);
+  }
+
+  {
+    irs::And root;
+    auto& name = root.add<irs::by_term>();
+    *name.mutable_field() = "name";
+    name.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("D"));
+
+    auto& range = root.add<irs::by_column_range>();
+    range = make_filter("value", 100, irs::BoundType::INCLUSIVE,
+                        123, irs::BoundType::INCLUSIVE, 0);
+
+    check_query(root, docs_t{ }, rdr);
+  }
+}
+
+TEST(by_column_range, options) {
+  irs::by_column_range_options opts;
+  ASSERT_EQ(irs::by_granular_range_options::range_type{}, opts.range);
+  ASSERT_EQ(size_t(16), opts.selectivity);
+}
+
+TEST(by_column_range, ctor) {
+  irs::by_column_range filter;
+  ASSERT_EQ(irs::type<irs::by_column_range>::id(), filter.type());
+  ASSERT_EQ(irs::by_column_range_options{}, filter.options());
+  ASSERT_TRUE(filter.field().empty());
+  ASSERT_EQ(irs::no_boost(), filter.boost());
+}
+
+TEST(by_column_range, equal) {
+  ASSERT_EQ(irs::by_column_range(), irs::by_column_range());
+
+  {
+    auto q0 = make_filter("seq", 1, irs::BoundType::INCLUSIVE,
+                          5, irs::BoundType::EXCLUSIVE, 16);
+    auto q1 = make_filter("seq", 1, irs::BoundType::INCLUSIVE,
+                          5, irs::BoundType::EXCLUSIVE, 16);
+    ASSERT_EQ(q0, q1);
+    ASSERT_EQ(q0.hash(), q1.hash());
+  }
+
+  {
+    auto q0 = make_filter("seq", 1, irs::BoundType::INCLUSIVE,
+                          5, irs::BoundType::EXCLUSIVE, 16);
+    auto q1 = make_filter("seq", 1, irs::BoundType::INCLUSIVE,
+                          5, irs::BoundType::EXCLUSIVE, 0);
+    ASSERT_NE(q0, q1);
+  }
+
+  {
+    auto q0 = make_filter("seq", 1, irs::BoundType::INCLUSIVE,
+                          5, irs::BoundType::EXCLUSIVE, 16);
+    auto q1 = make_filter("value", 1, irs::BoundType::INCLUSIVE,
+                          5, irs::BoundType::EXCLUSIVE, 16);
+    ASSERT_NE(q0, q1);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  column_range_filter_test,
+  column_range_filter_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::directory<&tests::memory_directory>,
+      &tests::directory<&tests::fs_directory>,
+      &tests::directory<&tests::mmap_directory>),
+    ::testing::Values("1_0", "1_4")),
+  column_range_filter_test_case::to_string
+);
+
+}
@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "search/all_filter.hpp"
+#include "search/facet_collector.hpp"
+#include "search/term_filter.hpp"
+
+namespace {
+
+using namespace tests;
+
+// stores a value encoded the same way as its most precise term
+class encoded_long_field final : public long_field {
+ public:
+  bool write(irs::data_output& out) const override {
+    using traits_t = irs::numeric_utils::numeric_traits<int64_t>;
+
+    irs::byte_type buf[traits_t::size()];
+    out.write_bytes(buf, traits_t::encode(value(), buf));
+    return true;
+  }
+};
+
+// stores nothing, i.e. produces a column without data
+class mask_field final : public ifield {
+ public:
+  explicit mask_field(std::string name) : name_{std::move(name)} { }
+
+  irs::string_ref name() const override { return name_; }
+  irs::IndexFeatures index_features() const override { return irs::IndexFeatures::NONE; }
+  irs::features_t features() const override { return {}; }
+  irs::token_stream& get_tokens() const override { return stream_; }
+  bool write(irs::data_output&) const override { return true; }
+
+ private:
+  std::string name_;
+  mutable irs::null_token_stream stream_;
+};
+
+class facet_collector_test_case : public index_test_base {
+ protected:
+  void add_segments() {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        if (data.is_string()) {
+          doc.insert(std::make_shared<string_field>(name, data.str));
+
+          if (name == "prefix") {
+            doc.insert(std::make_shared<mask_field>("mask"), false, true);
+          }
+        } else if (data.is_number()) {
+          doc.insert(std::make_shared<encoded_long_field>(), false, true);
+          auto& field = (doc.stored.end() - 1).as<long_field>();
+          field.name(name);
+          field.value(data.as_number<int64_t>());
+        }
+    });
+    add_segment(gen);
+    gen.reset();
+    add_segment(gen, irs::OM_APPEND);
+  }
+
+  // feeds values of matched documents one by one to 'aggr'
+  static size_t aggregate(
+      const irs::index_reader& reader,
+      const irs::filter::prepared& filter,
+      irs::string_ref field,
+      irs::aggregator& aggr) {
+    size_t matched = 0;
+
+    for (auto& segment : reader) {
+      auto docs = segment.mask(filter.execute(segment));
+      auto* column = segment.column(field);
+      auto values = column ? column->iterator(false) : irs::doc_iterator::empty();
+      auto* payload = irs::get<irs::payload>(*values);
+
+      while (docs->next()) {
+        ++matched;
+
+        if (docs->value() != values->seek(docs->value())) {
+          continue;
+        }
+
+        irs::bytes_ref value = payload ? payload->value : irs::bytes_ref::NIL;
+        if (value.null()) {
+          value = irs::bytes_ref::EMPTY;
+        }
+
+        aggr.collect(&value, 1);
+      }
+    }
+
+    return matched;
+  }
+
+  static irs::filter::prepared::ptr prepare(
+      const irs::index_reader& reader,
+      irs::string_ref field,
+      irs::string_ref term) {
+    irs::by_term filter;
+    *filter.mutable_field() = field;
+    filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+    return filter.prepare(reader);
+  }
+};
+
+TEST_P(facet_collector_test_case, collect) {
+  add_segments();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+
+  for (auto& prepared : { irs::all().prepare(reader),
+                          prepare(reader, "duplicated", "vczc"),
+                          prepare(reader, "same", "xyz"),
+                          prepare(reader, "name", "missing") }) {
+    ASSERT_NE(nullptr, prepared);
+
+    irs::count_aggregator expected_count, count, missing;
+    irs::term_aggregator expected_terms, terms;
+    irs::numeric_aggregator<int64_t> expected_stats, stats;
+    irs::histogram_aggregator<int64_t> expected_histogram(0, 100, 5), histogram(0, 100, 5);
+
+    irs::facet_collector collector;
+    ASSERT_TRUE(collector.empty());
+    collector.add("mask", count);
+    collector.add("duplicated", terms);
+    collector.add("value", stats);
+    collector.add("value", histogram);
+    collector.add("missing", missing);
+    ASSERT_EQ(5, collector.size());
+
+    const size_t matched = collector.collect(reader, *prepared);
+
+    ASSERT_EQ(matched, aggregate(reader, *prepared, "mask", expected_count));
+    aggregate(reader, *prepared, "duplicated", expected_terms);
+    aggregate(reader, *prepared, "value", expected_stats);
+    aggregate(reader, *prepared, "value", expected_histogram);
+
+    ASSERT_EQ(expected_count.count(), count.count());
+    ASSERT_EQ(0, missing.count());
+
+    ASSERT_EQ(expected_terms.values().size(), terms.values().size());
+    for (auto& entry : expected_terms.values()) {
+      ASSERT_EQ(entry.count, terms.count(entry.value));
+    }
+
+    ASSERT_EQ(expected_stats.count(), stats.count());
+    ASSERT_EQ(expected_stats.sum(), stats.sum());
+    if (stats.count()) {
+      ASSERT_EQ(expected_stats.min(), stats.min());
+      ASSERT_EQ(expected_stats.max(), stats.max());
+    }
+
+    ASSERT_EQ(expected_histogram.buckets(), histogram.buckets());
+    ASSERT_EQ(expected_histogram.outside(), histogram.outside());
+  }
+}
+
+TEST_P(facet_collector_test_case, collect_all) {
+  add_segments();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+
+  irs::count_aggregator count;
+  irs::term_aggregator terms;
+  irs::numeric_aggregator<int64_t> stats;
+
+  irs::facet_collector collector;
+  collector.add("prefix", count);
+  collector.add("duplicated", terms);
+  collector.add("seq", stats);
+
+  auto prepared = irs::all().prepare(reader);
+  ASSERT_NE(nullptr, prepared);
+  ASSERT_EQ(reader.docs_count(), collector.collect(reader, *prepared));
+
+  // every segment contains 32 documents with 'seq' from 0 to 31
+  ASSERT_EQ(reader.docs_count(), stats.count());
+  ASSERT_EQ(0, stats.min());
+  ASSERT_EQ(31, stats.max());
+  ASSERT_EQ(2*(31*32/2), stats.sum());
+
+  ASSERT_LT(0, count.count());
+  ASSERT_GT(reader.docs_count(), count.count());
+
+  auto top = terms.top(1);
+  ASSERT_EQ(1, top.size());
+  ASSERT_EQ(terms.values().size(), terms.top(100).size());
+  for (auto& entry : terms.values()) {
+    ASSERT_LE(entry.count, top.front()->count);
+  }
+}
+
+TEST_P(facet_collector_test_case, collect_removed) {
+  add_segments();
+
+  {
+    auto writer = open_writer(irs::OM_APPEND);
+    for (const irs::string_ref name : { "A", "C", "Q" }) {
+      irs::by_term removal;
+      *removal.mutable_field() = "name";
+      removal.mutable_options()->term = irs::ref_cast<irs::byte_type>(name);
+      writer->documents().remove(removal);
+      writer->commit();
+    }
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+  ASSERT_EQ(reader.docs_count() - 6, reader.live_docs_count());
+
+  for (auto& prepared : { irs::all().prepare(reader),
+                          prepare(reader, "same", "xyz") }) {
+    ASSERT_NE(nullptr, prepared);
+
+    irs::term_aggregator expected_terms, terms;
+    irs::numeric_aggregator<int64_t> expected_stats, stats;
+
+    irs::facet_collector collector;
+    collector.add("duplicated", terms);
+    collector.add("seq", stats);
+
+    // deleted documents are neither matched nor aggregated
+    ASSERT_EQ(reader.live_docs_count(), collector.collect(reader, *prepared));
+    ASSERT_EQ(reader.live_docs_count(), aggregate(reader, *prepared, "seq", expected_stats));
+    aggregate(reader, *prepared, "duplicated", expected_terms);
+
+    ASSERT_EQ(reader.live_docs_count(), stats.count());
+    ASSERT_EQ(expected_stats.sum(), stats.sum());
+    ASSERT_EQ(expected_stats.min(), stats.min());
+    ASSERT_EQ(expected_stats.max(), stats.max());
+
+    ASSERT_EQ(expected_terms.values().size(), terms.values().size());
+    for (auto& entry : expected_terms.values()) {
+      ASSERT_EQ(entry.count, terms.count(entry.value));
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  facet_collector_test,
+  facet_collector_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::directory<&tests::memory_directory>,
+      &tests::directory<&tests::fs_directory>,
+      &tests::directory<&tests::mmap_directory>),
+    ::testing::Values("1_0", "1_4")),
+  facet_collector_test_case::to_string
+);
+
+}
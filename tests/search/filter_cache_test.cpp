@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "search/filter_cache.hpp"
+
+#include "index/index_tests.hpp"
+#include "index/index_writer.hpp"
+#include "search/bm25.hpp"
+#include "search/cost.hpp"
+#include "search/score.hpp"
+#include "search/term_filter.hpp"
+#include "store/memory_directory.hpp"
+#include "tests_shared.hpp"
+
+namespace {
+
+using namespace tests;
+using namespace iresearch;
+
+class filter_cache_test_case : public ::testing::Test {
+ protected:
+  static constexpr size_t kDocs = 1000;
+
+  virtual void SetUp() override {
+    writer_ = irs::index_writer::make(dir_, irs::formats::get("1_0"),
+                                      irs::OM_CREATE);
+    {
+      auto ctx = writer_->documents();
+      for (size_t i = 0; i < kDocs; ++i) {
+        auto doc = ctx.insert();
+        const auto parity = std::make_shared<tests::string_field>(
+            "parity", i % 2 ? "odd" : "even");
+        doc.insert<Action::INDEX>(*parity);
+        const auto rare = std::make_shared<tests::string_field>(
+            "rare", i % 100 ? "no" : "yes");
+        doc.insert<Action::INDEX>(*rare);
+      }
+    }
+    writer_->commit();
+    reader_ = irs::directory_reader::open(dir_);
+    ASSERT_EQ(1, reader_.size());
+  }
+
+  static void make_term(by_term& filter, string_ref field, string_ref term) {
+    *filter.mutable_field() = field;
+    filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+  }
+
+  static cached_filter make_cached(filter_cache& cache, string_ref field,
+                                   string_ref term) {
+    cached_filter filter;
+    filter.set_cache(cache);
+    make_term(filter.set_filter<by_term>(), field, term);
+    return filter;
+  }
+
+  static std::vector<doc_id_t> collect(const filter& filter,
+                                       const sub_reader& segment,
+                                       const index_reader& reader) {
+    std::vector<doc_id_t> docs;
+    auto it = filter.prepare(reader)->execute(segment);
+    while (it->next()) {
+      docs.emplace_back(it->value());
+    }
+    EXPECT_TRUE(doc_limits::eof(it->value()));
+    return docs;
+  }
+
+  irs::memory_directory dir_;
+  irs::index_writer::ptr writer_;
+  irs::directory_reader reader_;
+};
+
+TEST_F(filter_cache_test_case, cached_results) {
+  filter_cache cache;
+
+  for (auto [field, term] : {std::make_pair("parity", "even"),
+                             std::make_pair("rare", "yes"),
+                             std::make_pair("rare", "missing")}) {
+    by_term real;
+    make_term(real, field, term);
+    const auto expected = collect(real, reader_[0], reader_);
+
+    const auto hits = cache.hits();
+    const auto misses = cache.misses();
+
+    // miss
+    auto filter = make_cached(cache, field, term);
+    ASSERT_EQ(expected, collect(filter, reader_[0], reader_));
+    ASSERT_EQ(hits, cache.hits());
+    ASSERT_EQ(misses + 1, cache.misses());
+
+    // hit, the same filter
+    ASSERT_EQ(expected, collect(filter, reader_[0], reader_));
+    ASSERT_EQ(hits + 1, cache.hits());
+
+    // hit, equal filter
+    auto other = make_cached(cache, field, term);
+    ASSERT_EQ(filter, other);
+    ASSERT_EQ(filter.hash(), other.hash());
+    ASSERT_EQ(expected, collect(other, reader_[0], reader_));
+    ASSERT_EQ(hits + 2, cache.hits());
+    ASSERT_EQ(misses + 1, cache.misses());
+  }
+
+  ASSERT_EQ(3, cache.size());
+  ASSERT_LE(cache.bytes(), cache.max_bytes());
+
+  cache.clear();
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(0, cache.bytes());
+}
+
+TEST_F(filter_cache_test_case, seek_and_batch) {
+  filter_cache cache;
+
+  for (auto [field, term] : {std::make_pair("parity", "odd"),
+                             std::make_pair("rare", "yes")}) {
+    by_term real;
+    make_term(real, field, term);
+    const auto expected = collect(real, reader_[0], reader_);
+    ASSERT_FALSE(expected.empty());
+
+    auto filter = make_cached(cache, field, term);
+    auto prepared = filter.prepare(reader_);
+
+    // populate cache
+    const auto misses = cache.misses();
+    collect(filter, reader_[0], reader_);
+    ASSERT_EQ(misses + 1, cache.misses());
+
+    for (size_t i = 0; i < 2; ++i) {
+      auto it = prepared->execute(reader_[0]);
+      auto* cost = irs::get<irs::cost>(*it);
+      ASSERT_NE(nullptr, cost);
+      ASSERT_EQ(expected.size(), cost->estimate());
+
+      ASSERT_EQ(expected[1], it->seek(expected[0] + 1));
+
+      doc_id_t docs[3];
+      ASSERT_EQ(3, it->next_batch(docs, nullptr, 3));
+      ASSERT_EQ(expected[2], docs[0]);
+      ASSERT_EQ(expected[3], docs[1]);
+      ASSERT_EQ(expected[4], docs[2]);
+      ASSERT_EQ(expected[4], it->value());
+
+      ASSERT_TRUE(doc_limits::eof(it->seek(doc_limits::eof())));
+      ASSERT_FALSE(it->next());
+    }
+
+    cache.clear();
+  }
+}
+
+TEST_F(filter_cache_test_case, eviction) {
+  filter_cache cache;
+
+  auto even = make_cached(cache, "parity", "even");
+  collect(even, reader_[0], reader_);
+  ASSERT_EQ(1, cache.size());
+  const size_t even_bytes = cache.bytes();
+
+  auto rare = make_cached(cache, "rare", "yes");
+  collect(rare, reader_[0], reader_);
+  ASSERT_EQ(2, cache.size());
+  const size_t rare_bytes = cache.bytes() - even_bytes;
+
+  // refresh 'even', 'rare' becomes the least recently used one
+  collect(even, reader_[0], reader_);
+  ASSERT_EQ(1, cache.hits());
+
+  auto odd = make_cached(cache, "parity", "odd");
+  cache.max_bytes(2 * even_bytes);
+  ASSERT_EQ(2, cache.size());
+  collect(odd, reader_[0], reader_);
+  ASSERT_EQ(2, cache.size());
+  ASSERT_LE(cache.bytes(), cache.max_bytes());
+
+  collect(even, reader_[0], reader_);
+  ASSERT_EQ(2, cache.hits());
+  collect(odd, reader_[0], reader_);
+  ASSERT_EQ(3, cache.hits());
+  collect(rare, reader_[0], reader_); // evicted
+  ASSERT_EQ(3, cache.hits());
+
+  // results exceeding the budget aren't cached
+  cache.max_bytes(rare_bytes);
+  ASSERT_LE(cache.bytes(), rare_bytes);
+  cache.clear();
+  by_term real;
+  make_term(real, "parity", "even");
+  ASSERT_EQ(collect(real, reader_[0], reader_),
+            collect(even, reader_[0], reader_));
+  ASSERT_EQ(0, cache.size());
+}
+
+TEST_F(filter_cache_test_case, invalidation) {
+  filter_cache cache;
+
+  auto filter = make_cached(cache, "rare", "yes");
+  const auto expected = collect(filter, reader_[0], reader_);
+  ASSERT_EQ(1, cache.size());
+
+  // unchanged segment is shared by the reopened reader
+  reader_ = reader_.reopen();
+  ASSERT_EQ(expected, collect(filter, reader_[0], reader_));
+  ASSERT_EQ(1, cache.hits());
+  cache.purge();
+  ASSERT_EQ(1, cache.size());
+
+  // remove documents which don't match the cached filter
+  {
+    filter::ptr removal = std::make_unique<by_term>();
+    make_term(static_cast<by_term&>(*removal), "parity", "odd");
+    writer_->documents().remove(std::move(removal));
+  }
+  writer_->commit();
+
+  // segment has been changed, old segment is dropped
+  reader_ = reader_.reopen();
+  ASSERT_EQ(1, reader_.size());
+  ASSERT_EQ(kDocs / 2, reader_.live_docs_count());
+  cache.purge();
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(0, cache.bytes());
+
+  ASSERT_EQ(expected, collect(filter, reader_[0], reader_));
+  ASSERT_EQ(1, cache.hits());
+  ASSERT_EQ(2, cache.misses());
+  ASSERT_EQ(1, cache.size());
+
+  // like results of a real filter, cached ones aren't masked
+  auto removed = make_cached(cache, "parity", "odd");
+  by_term real;
+  make_term(real, "parity", "odd");
+  const auto unmasked = collect(real, reader_[0], reader_);
+  ASSERT_EQ(kDocs / 2, unmasked.size());
+  ASSERT_EQ(unmasked, collect(removed, reader_[0], reader_));
+  ASSERT_EQ(unmasked, collect(removed, reader_[0], reader_));
+  ASSERT_EQ(2, cache.hits());
+  auto masked = reader_[0].mask(removed.prepare(reader_)->execute(reader_[0]));
+  ASSERT_FALSE(masked->next());
+}
+
+TEST_F(filter_cache_test_case, bypass) {
+  filter_cache cache;
+
+  auto filter = make_cached(cache, "parity", "even");
+
+  // segments not managed by 'segment_reader' aren't cached
+  ASSERT_TRUE(collect(filter, sub_reader::empty(), reader_).empty());
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(0, cache.misses());
+
+  // scored queries aren't cached
+  irs::order ord;
+  ord.add<irs::bm25_sort>(true);
+  auto order = ord.prepare();
+  auto it = filter.prepare(reader_, order)->execute(reader_[0], order);
+  ASSERT_NE(nullptr, irs::get<irs::score>(*it));
+  size_t count = 0;
+  while (it->next()) {
+    ++count;
+  }
+  ASSERT_EQ(kDocs / 2, count);
+  ASSERT_EQ(0, cache.size());
+
+  // empty filter
+  cached_filter empty;
+  empty.set_cache(cache);
+  ASSERT_TRUE(collect(empty, reader_[0], reader_).empty());
+  ASSERT_NE(empty, filter);
+}
+
+} // namespace
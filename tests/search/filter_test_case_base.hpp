@@ -27,9 +27,11 @@
 #include "tests_shared.hpp"
 #include "analysis/token_attributes.hpp"
 #include "search/cost.hpp"
+#include "search/boolean_filter.hpp"
 #include "search/filter_visitor.hpp"
 #include "search/score.hpp"
 #include "search/filter.hpp"
+#include "search/term_filter.hpp"
 #include "search/tfidf.hpp"
 #include "utils/singleton.hpp"
 #include "utils/type_limits.hpp"
@@ -528,6 +530,112 @@ struct frequency_sort: public irs::sort {
   }
 }; // sort::frequency_sort
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief counts scores evaluated via the wrapped sort
+//////////////////////////////////////////////////////////////////////////////
+struct counting_sort: public irs::sort {
+  class prepared: public irs::sort::prepared {
+   public:
+    prepared(irs::sort::prepared::ptr&& impl, size_t& evaluated)
+      : irs::sort::prepared(impl->bulk_aggregate_func(), impl->aggregate_func(),
+                            impl->bulk_max_func(), impl->max_func()),
+        impl_(std::move(impl)),
+        evaluated_(&evaluated) {
+    }
+
+    virtual void collect(
+        irs::byte_type* stats,
+        const irs::index_reader& index,
+        const irs::sort::field_collector* field,
+        const irs::sort::term_collector* term) const override {
+      impl_->collect(stats, index, field, term);
+    }
+
+    virtual irs::IndexFeatures features() const override {
+      return impl_->features();
+    }
+
+    virtual irs::sort::field_collector::ptr prepare_field_collector() const override {
+      return impl_->prepare_field_collector();
+    }
+
+    virtual irs::score_function prepare_scorer(
+        const irs::sub_reader& segment,
+        const irs::term_reader& field,
+        const irs::byte_type* stats,
+        irs::byte_type* score_buf,
+        const irs::attribute_provider& doc_attrs,
+        irs::boost_t boost) const override {
+      struct scorer: public irs::score_ctx {
+        scorer(irs::score_function&& impl, size_t& evaluated) noexcept
+          : impl(std::move(impl)), evaluated(&evaluated) {
+        }
+
+        irs::score_function impl;
+        size_t* evaluated;
+      };
+
+      return {
+        irs::memory::make_unique<scorer>(
+          impl_->prepare_scorer(segment, field, stats, score_buf, doc_attrs, boost),
+          *evaluated_),
+        [](irs::score_ctx* ctx) -> const irs::byte_type* {
+          auto& state = *static_cast<scorer*>(ctx);
+          ++*state.evaluated;
+          return state.impl();
+        }
+      };
+    }
+
+    virtual irs::max_score_f prepare_max_score(
+        const irs::sub_reader& segment,
+        const irs::term_reader& field,
+        const irs::byte_type* stats,
+        irs::boost_t boost) const override {
+      return impl_->prepare_max_score(segment, field, stats, boost);
+    }
+
+    virtual irs::sort::term_collector::ptr prepare_term_collector() const override {
+      return impl_->prepare_term_collector();
+    }
+
+    virtual bool less(const irs::byte_type* lhs, const irs::byte_type* rhs) const override {
+      return impl_->less(lhs, rhs);
+    }
+
+    virtual std::pair<size_t, size_t> score_size() const override {
+      return impl_->score_size();
+    }
+
+    virtual std::pair<size_t, size_t> stats_size() const override {
+      return impl_->stats_size();
+    }
+
+   private:
+    irs::sort::prepared::ptr impl_;
+    size_t* evaluated_;
+  }; // sort::counting_sort::prepared
+
+  static ptr make(irs::sort::ptr&& impl, size_t& evaluated) {
+    return irs::memory::make_unique<counting_sort>(std::move(impl), evaluated);
+  }
+
+  counting_sort(irs::sort::ptr&& impl, size_t& evaluated)
+    : sort(irs::type<counting_sort>::get()),
+      impl_(std::move(impl)),
+      evaluated_(&evaluated) {
+  }
+
+  virtual prepared::ptr prepare() const {
+    return irs::memory::make_unique<counting_sort::prepared>(
+      impl_->prepare(), *evaluated_);
+  }
+
+ private:
+  irs::sort::ptr impl_;
+  size_t* evaluated_;
+}; // sort::counting_sort
+
 } // sort
 
 class filter_test_case_base : public index_test_base {
@@ -746,6 +854,132 @@ class empty_filter_visitor : public irs::filter_visitor {
   size_t visit_calls_counter_ = 0;
 }; // empty_filter_visitor
 
+//////////////////////////////////////////////////////////////////////////////
+/// @returns JSON array of 'count' documents having a "seq" number and a
+///          "field" of digit terms occurring a varying number of times
+//////////////////////////////////////////////////////////////////////////////
+inline std::string make_digit_docs(size_t count) {
+  std::string data = "[";
+
+  for (size_t i = 0; i < count; ++i) {
+    data += i ? ",\n" : "\n";
+    data += "{ \"seq\": " + std::to_string(i) + ", \"field\": [";
+    for (size_t k = 0, size = i % 8 + 1; k < size; ++k) {
+      data += k ? ", \"" : " \"";
+      data += std::to_string((i*k + i/10) % 10);
+      data += '"';
+    }
+    data += " ] }";
+  }
+
+  return data += "\n]";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief verifies score upper bounds and dynamic pruning of a disjunction
+///        of terms of 'field' scored via 'scorer' producing 'float_t' scores
+//////////////////////////////////////////////////////////////////////////////
+inline void assert_max_score(
+    const irs::index_reader& reader,
+    irs::sort::ptr&& scorer,
+    irs::string_ref field,
+    std::initializer_list<irs::string_ref> terms) {
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0];
+
+  size_t evaluated = 0;
+  irs::order ord;
+  ord.add<sort::counting_sort>(true, std::move(scorer), evaluated);
+  auto prepared_order = ord.prepare();
+
+  auto score_value = [](const irs::score& score) {
+    return *reinterpret_cast<const float_t*>(score.evaluate());
+  };
+
+  // score upper bound of a single term
+  for (auto term : terms) {
+    irs::by_term filter;
+    *filter.mutable_field() = field;
+    filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+
+    auto prepared = filter.prepare(reader, prepared_order);
+    auto docs = prepared->execute(segment, prepared_order);
+    auto* score = irs::get<irs::score>(*docs);
+    ASSERT_NE(nullptr, score);
+    ASSERT_LT(score->bounds.tail, std::numeric_limits<float_t>::max());
+
+    while (docs->next()) {
+      ASSERT_LE(score_value(*score), score->bounds.tail);
+    }
+  }
+
+  irs::Or filter;
+  for (auto term : terms) {
+    auto& sub = filter.add<irs::by_term>();
+    *sub.mutable_field() = field;
+    sub.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+  }
+
+  auto prepared = filter.prepare(reader, prepared_order);
+
+  // no threshold, every matched term is scored
+  std::map<irs::doc_id_t, float_t> expected;
+  evaluated = 0;
+  {
+    auto docs = prepared->execute(segment, prepared_order);
+    auto* score = irs::get<irs::score>(*docs);
+    ASSERT_NE(nullptr, score);
+
+    while (docs->next()) {
+      const auto value = score_value(*score);
+      ASSERT_LE(value, score->bounds.tail);
+      expected.emplace(docs->value(), value);
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+  const size_t evaluated_all = evaluated;
+
+  // documents scored below the threshold may be skipped
+  for (auto& [_, threshold] : expected) {
+    auto docs = prepared->execute(segment, prepared_order);
+    auto* score = irs::get_mutable<irs::score>(docs.get());
+    ASSERT_NE(nullptr, score);
+    score->min(threshold);
+
+    evaluated = 0;
+    std::map<irs::doc_id_t, float_t> actual;
+    while (docs->next()) {
+      actual.emplace(docs->value(), score_value(*score));
+    }
+    ASSERT_LE(evaluated, evaluated_all);
+
+    // all competitive documents must be returned
+    for (auto& [doc, value] : expected) {
+      if (value >= threshold) {
+        auto it = actual.find(doc);
+        ASSERT_NE(actual.end(), it);
+        ASSERT_FLOAT_EQ(value, it->second);
+      }
+    }
+  }
+
+  // terms of the lowest bounds aren't scored for non-competitive candidates
+  {
+    const auto max = std::max_element(
+      expected.begin(), expected.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+
+    auto docs = prepared->execute(segment, prepared_order);
+    auto* score = irs::get_mutable<irs::score>(docs.get());
+    ASSERT_NE(nullptr, score);
+    score->min(max->second);
+
+    evaluated = 0;
+    while (docs->next()) { }
+    ASSERT_LT(evaluated, evaluated_all);
+  }
+}
+
 } // tests
 
 #endif // IRESEARCH_FILTER_TEST_CASE_BASE
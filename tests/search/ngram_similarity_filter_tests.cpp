@@ -587,6 +587,39 @@ TEST_P(ngram_similarity_filter_test_case, check_matcher_10) {
   }
 }
 
+TEST_P(ngram_similarity_filter_test_case, check_matcher_unscored) {
+  {
+    tests::json_doc_generator gen(
+      "[{ \"seq\" : 1, \"field\": [ \"1\", \"3\", \"4\", \"5\", \"6\", \"7\", \"2\"] },"
+      " { \"seq\" : 2, \"field\": [ \"1\", \"2\", \"1\", \"1\", \"3\", \"4\"] },"
+      " { \"seq\" : 3, \"field\": [ \"4\", \"3\", \"2\", \"1\"] }]",
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+
+  // longest sequences are 134, 1234 and 4 (or any other single term)
+  check_query(make_filter("field", {"1", "2", "3", "4"}, 1.f), docs_t{ 2 }, rdr);
+  check_query(make_filter("field", {"1", "2", "3", "4"}, 0.75f), docs_t{ 1, 2 }, rdr);
+  check_query(make_filter("field", {"1", "2", "3", "4"}, 0.5f), docs_t{ 1, 2 }, rdr);
+  check_query(make_filter("field", {"1", "2", "3", "4"}, 0.25f), docs_t{ 1, 2, 3 }, rdr);
+
+  // repeated terms
+  check_query(make_filter("field", {"1", "1", "1", "3"}, 1.f), docs_t{ 2 }, rdr);
+  check_query(make_filter("field", {"1", "1", "1", "3"}, 0.75f), docs_t{ 2 }, rdr);
+  check_query(make_filter("field", {"1", "1", "1", "3"}, 0.5f), docs_t{ 1, 2 }, rdr);
+
+  // more terms than bits in a word, matched the regular way
+  {
+    std::vector<irs::string_ref> ngrams(65, "5");
+    ngrams.front() = "1";
+    ngrams.back() = "2";
+    check_query(make_filter("field", ngrams, 2.5f/65), docs_t{ 1 }, rdr);
+    check_query(make_filter("field", ngrams, 3.5f/65), docs_t{ }, rdr);
+  }
+}
+
 TEST_P(ngram_similarity_filter_test_case, no_match_case) {
   {
     tests::json_doc_generator gen(
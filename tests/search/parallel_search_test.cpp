@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "search/parallel_search.hpp"
+
+#include <atomic>
+#include <thread>
+
+#include "index/index_tests.hpp"
+#include "index/index_writer.hpp"
+#include "store/memory_directory.hpp"
+#include "tests_shared.hpp"
+#include "utils/async_utils.hpp"
+
+namespace {
+
+class parallel_search_test_case : public ::testing::Test {
+ protected:
+  static constexpr size_t kSegments = 17;
+
+  void SetUp() override {
+    auto writer = irs::index_writer::make(dir_, irs::formats::get("1_0"),
+                                          irs::OM_CREATE);
+
+    // a segment per commit, segment 'i' contains 'i + 1' documents
+    for (size_t i = 0; i < kSegments; ++i) {
+      {
+        auto ctx = writer->documents();
+        for (size_t j = 0; j <= i; ++j) {
+          auto doc = ctx.insert();
+          const auto field = std::make_shared<tests::string_field>("name", "value");
+          doc.insert<irs::Action::INDEX>(*field);
+        }
+      }
+      writer->commit();
+    }
+
+    reader_ = irs::directory_reader::open(dir_);
+    ASSERT_EQ(kSegments, reader_.size());
+  }
+
+  irs::memory_directory dir_;
+  irs::directory_reader reader_;
+};
+
+TEST_F(parallel_search_test_case, visit_all) {
+  for (size_t threads : { size_t(0), size_t(1), size_t(4), 2*kSegments }) {
+    irs::async_utils::thread_pool pool(threads, threads);
+
+    std::vector<std::atomic<size_t>> visits(kSegments);
+    std::atomic<uint64_t> docs{0};
+
+    ASSERT_TRUE(irs::parallel_for_each(
+      pool, reader_,
+      [&](const irs::sub_reader& segment, size_t ordinal) {
+        ASSERT_EQ(&reader_[ordinal], &segment);
+        ++visits[ordinal];
+        docs += segment.docs_count();
+      }));
+
+    for (auto& count : visits) {
+      ASSERT_EQ(1, count);
+    }
+    ASSERT_EQ(reader_.docs_count(), docs);
+  }
+}
+
+TEST_F(parallel_search_test_case, empty_index) {
+  irs::async_utils::thread_pool pool(2, 2);
+  size_t visits = 0;
+
+  ASSERT_TRUE(irs::parallel_for_each(
+    pool, irs::sub_reader::empty(),
+    [&visits](const irs::sub_reader&, size_t) { ++visits; }));
+  ASSERT_EQ(0, visits);
+}
+
+TEST_F(parallel_search_test_case, cancel) {
+  irs::async_utils::thread_pool pool(4, 4);
+  std::atomic<size_t> visits{0};
+  std::atomic<size_t> calls{0};
+
+  // cancelled after a few segments
+  ASSERT_FALSE(irs::parallel_for_each(
+    pool, reader_,
+    [&visits](const irs::sub_reader&, size_t) { ++visits; },
+    [&calls]() { return ++calls <= 3; }));
+  ASSERT_LE(visits, 3);
+  ASSERT_LE(calls, kSegments);
+
+  // the pool remains usable
+  visits = 0;
+  ASSERT_TRUE(irs::parallel_for_each(
+    pool, reader_,
+    [&visits](const irs::sub_reader&, size_t) { ++visits; },
+    []() { return true; }));
+  ASSERT_EQ(kSegments, visits);
+}
+
+TEST_F(parallel_search_test_case, exception) {
+  irs::async_utils::thread_pool pool(4, 4);
+  std::atomic<size_t> visits{0};
+
+  ASSERT_THROW(irs::parallel_for_each(
+    pool, reader_,
+    [&visits](const irs::sub_reader&, size_t ordinal) {
+      ++visits;
+      if (5 == ordinal) {
+        throw irs::illegal_state("failure");
+      }
+    }),
+    irs::illegal_state);
+  ASSERT_LE(visits, kSegments);
+}
+
+TEST_F(parallel_search_test_case, stopped_pool) {
+  irs::async_utils::thread_pool pool(2, 2);
+  pool.stop();
+
+  // segments are visited by the calling thread
+  size_t visits = 0;
+  const auto id = std::this_thread::get_id();
+
+  ASSERT_TRUE(irs::parallel_for_each(
+    pool, reader_,
+    [&](const irs::sub_reader&, size_t) {
+      ASSERT_EQ(id, std::this_thread::get_id());
+      ++visits;
+    }));
+  ASSERT_EQ(kSegments, visits);
+}
+
+}  // namespace
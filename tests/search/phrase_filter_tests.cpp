@@ -7387,12 +7387,118 @@ TEST_P(phrase_filter_test_case, sequential_several_terms) {
   }
 }
 
+TEST_P(phrase_filter_test_case, sequential_shingles) {
+  // field containing pairs of adjacent terms of 'text_field'
+  class shingle_field final : public tests::field_base {
+   public:
+    shingle_field(const std::string& name, const std::string& value)
+      : stream_(irs::analysis::analyzers::get(
+          "shingle", irs::type<irs::text_format::json>::get(),
+          "{\"analyzer\":{\"type\":\"text\",\"properties\":{\"locale\":\"C\", \"stopwords\":[]}}}")),
+        value_(value) {
+      this->name(name);
+      index_features_ = irs::IndexFeatures::FREQ | irs::IndexFeatures::POS;
+    }
+
+    irs::token_stream& get_tokens() const override {
+      stream_->reset(value_);
+      return *stream_;
+    }
+
+    bool write(irs::data_output&) const override { return false; }
+
+   private:
+    irs::analysis::analyzer::ptr stream_;
+    std::string value_;
+  }; // shingle_field
+
+  // pairs are indexed in the first segment only
+  {
+    tests::json_doc_generator gen(
+      resource("phrase_sequential.json"),
+      [](tests::document& doc, const std::string& name,
+         const tests::json_doc_generator::json_value& data) {
+        tests::analyzed_json_field_factory(doc, name, data);
+
+        if (data.is_string() && name == "phrase") {
+          doc.indexed.push_back(std::make_shared<shingle_field>(
+            "phrase_shingles", data.str));
+        }
+    });
+    add_segment(gen);
+  }
+  {
+    tests::json_doc_generator gen(
+      resource("phrase_sequential.json"),
+      &tests::analyzed_json_field_factory);
+    add_segment(gen, irs::OM_APPEND);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(2, rdr.size());
+  ASSERT_NE(nullptr, rdr[0].field("phrase_shingles"));
+  ASSERT_EQ(nullptr, rdr[1].field("phrase_shingles"));
+
+  const std::vector<std::vector<std::pair<size_t, irs::string_ref>>> phrases {
+    { { 0, "quick" }, { 1, "brown" } },
+    { { 0, "quick" }, { 1, "brown" }, { 2, "fox" } },
+    { { 0, "fox" }, { 1, "brown" }, { 2, "quick" } },
+    { { 0, "eye" }, { 1, "to" }, { 2, "eye" } },
+    { { 0, "as" }, { 1, "in" }, { 2, "the" }, { 3, "past" } },
+    { { 0, "quick" }, { 2, "fox" } }, // no adjacent terms
+    { { 0, "quick" }, { 1, "brown" }, { 3, "jumps" } },
+    { { 0, "lazy" }, { 1, "fox" } }, // missing pair
+    { { 0, "quick" }, { 1, "missing" } } // missing term
+  };
+
+  size_t matched = 0;
+
+  for (auto& phrase : phrases) {
+    irs::by_phrase expected;
+    *expected.mutable_field() = "phrase_anl";
+    for (auto& [pos, term] : phrase) {
+      expected.mutable_options()->insert<irs::by_term_options>(pos).term =
+        irs::ref_cast<irs::byte_type>(term);
+    }
+
+    irs::by_phrase q = expected;
+    q.mutable_options()->shingles("phrase_shingles", " ");
+    ASSERT_NE(expected, q);
+    ASSERT_EQ("phrase_shingles", q.options().shingles_field());
+    ASSERT_EQ(" ", q.options().shingles_delimiter());
+
+    auto expected_prepared = expected.prepare(rdr);
+    ASSERT_NE(nullptr, expected_prepared);
+    auto prepared = q.prepare(rdr);
+    ASSERT_NE(nullptr, prepared);
+
+    for (auto& segment : rdr) {
+      auto expected_docs = expected_prepared->execute(segment);
+      auto docs = prepared->execute(segment);
+
+      // pairs narrow down candidates only
+      ASSERT_LE(irs::cost::extract(*docs), irs::cost::extract(*expected_docs));
+
+      while (expected_docs->next()) {
+        ASSERT_TRUE(docs->next());
+        ASSERT_EQ(expected_docs->value(), docs->value());
+        ++matched;
+      }
+      ASSERT_FALSE(docs->next());
+    }
+  }
+
+  ASSERT_LT(0, matched);
+}
+
 TEST(by_phrase_test, options) {
   irs::by_phrase_options opts;
   ASSERT_TRUE(opts.simple());
   ASSERT_TRUE(opts.empty());
   ASSERT_EQ(0, opts.size());
   ASSERT_EQ(opts.begin(), opts.end());
+  ASSERT_TRUE(opts.shingles_field().empty());
+  ASSERT_TRUE(opts.shingles_delimiter().empty());
 }
 
 TEST(by_phrase_test, options_clear) {
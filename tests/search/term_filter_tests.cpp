@@ -23,9 +23,11 @@
 
 #include "tests_shared.hpp"
 #include "filter_test_case_base.hpp"
+#include "search/boolean_filter.hpp"
 #include "search/term_filter.hpp"
 #include "search/term_query.hpp"
 #include "search/range_filter.hpp"
+#include "search/terms_filter.hpp"
 
 namespace {
 
@@ -636,6 +638,172 @@ TEST_P(term_filter_test_case, visit) {
   visitor.reset();
 }
 
+TEST_P(term_filter_test_case, count) {
+  // add segment
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+
+  irs::by_terms terms;
+  *terms.mutable_field() = "prefix";
+  for (const irs::string_ref term : { "abc", "abcd", "abcy", "invalid_term" }) {
+    terms.mutable_options()->terms.emplace(irs::ref_cast<irs::byte_type>(term));
+  }
+
+  irs::And conjunction;
+  conjunction.add<irs::by_term>() = make_filter("same", "xyz");
+  conjunction.add<irs::by_term>() = make_filter("duplicated", "vczc");
+
+  // derived from term metadata
+  {
+    auto prepared = make_filter("same", "xyz").prepare(rdr);
+    auto count = prepared->count(rdr);
+    ASSERT_EQ(32, count.value);
+    ASSERT_TRUE(count.exact);
+    count = prepared->count(rdr, 1);
+    ASSERT_EQ(32, count.value);
+    ASSERT_TRUE(count.exact);
+
+    count = make_filter("same", "invalid_term").prepare(rdr)->count(rdr);
+    ASSERT_EQ(0, count.value);
+    ASSERT_TRUE(count.exact);
+  }
+
+  // derived from a union of postings
+  {
+    const auto count = terms.prepare(rdr)->count(rdr, 1);
+    ASSERT_EQ(4, count.value);
+    ASSERT_TRUE(count.exact);
+  }
+
+  // evaluated
+  {
+    auto prepared = conjunction.prepare(rdr);
+    auto count = prepared->count(rdr);
+    ASSERT_EQ(7, count.value);
+    ASSERT_TRUE(count.exact);
+
+    // matches in 1..13 extrapolated over 32 documents
+    count = prepared->count(rdr, 3);
+    ASSERT_EQ(7, count.value);
+    ASSERT_FALSE(count.exact);
+  }
+
+  // nothing evaluated, the first document of a segment matches
+  {
+    irs::And first;
+    first.add<irs::by_term>() = make_filter("same", "xyz");
+    first.add<irs::by_term>() = make_filter("name", "A");
+
+    auto prepared = first.prepare(rdr);
+    auto count = prepared->count(rdr, 0);
+    // bounded by the cost of the conjunction
+    ASSERT_EQ(1, count.value);
+    ASSERT_FALSE(count.exact);
+
+    count = prepared->count(rdr);
+    ASSERT_EQ(1, count.value);
+    ASSERT_TRUE(count.exact);
+  }
+
+  // remove document matched by all of the filters
+  {
+    auto writer = open_writer(irs::OM_APPEND);
+    irs::filter::ptr removal = std::make_unique<irs::by_term>(make_filter("name", "A"));
+    writer->documents().remove(std::move(removal));
+    writer->commit();
+  }
+
+  rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  ASSERT_EQ(31, rdr.live_docs_count());
+
+  // evaluated since deleted documents are involved
+  {
+    auto count = make_filter("same", "xyz").prepare(rdr)->count(rdr);
+    ASSERT_EQ(31, count.value);
+    ASSERT_TRUE(count.exact);
+
+    count = terms.prepare(rdr)->count(rdr);
+    ASSERT_EQ(3, count.value);
+    ASSERT_TRUE(count.exact);
+
+    count = make_filter("same", "xyz").prepare(rdr)->count(rdr, 10);
+    ASSERT_LT(10, count.value);
+    ASSERT_FALSE(count.exact);
+  }
+}
+
+TEST_P(term_filter_test_case, mask) {
+  // add segment
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  // remove documents
+  {
+    auto writer = open_writer(irs::OM_APPEND);
+    for (auto* name : { "A", "C", "Q", "Z" }) {
+      irs::filter::ptr removal = std::make_unique<irs::by_term>(make_filter("name", name));
+      writer->documents().remove(std::move(removal));
+    }
+    writer->commit();
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  auto& segment = rdr[0];
+  ASSERT_EQ(28, segment.live_docs_count());
+
+  // enough terms to evaluate a union of postings at once
+  irs::by_terms terms;
+  *terms.mutable_field() = "name";
+  for (char c = 'A'; c <= 'Z'; ++c) {
+    terms.mutable_options()->terms.emplace(
+      irs::ref_cast<irs::byte_type>(irs::string_ref(&c, 1)));
+  }
+
+  const auto same = make_filter("same", "xyz");
+
+  for (const irs::filter* filter : { static_cast<const irs::filter*>(&terms),
+                                     static_cast<const irs::filter*>(&same) }) {
+    auto prepared = filter->prepare(rdr);
+
+    // deleted documents aren't excluded by the query itself
+    std::vector<irs::doc_id_t> all;
+    for (auto it = prepared->execute(segment); it->next();) {
+      all.emplace_back(it->value());
+    }
+
+    std::vector<irs::doc_id_t> expected;
+    for (auto it = segment.mask(prepared->execute(segment)); it->next();) {
+      expected.emplace_back(it->value());
+    }
+    ASSERT_EQ(all.size() - 4, expected.size());
+
+    // documents read in batches are masked the same way
+    for (size_t batch : { size_t(1), size_t(3), size_t(64) }) {
+      auto it = segment.mask(prepared->execute(segment));
+      std::vector<irs::doc_id_t> docs(batch);
+      std::vector<irs::doc_id_t> actual;
+
+      for (size_t read; (read = it->next_batch(docs.data(), nullptr, batch));) {
+        actual.insert(actual.end(), docs.begin(), docs.begin() + read);
+      }
+      ASSERT_EQ(expected, actual);
+    }
+  }
+}
+
 TEST(by_prefix_test, options) {
   irs::by_term_options opts;
   ASSERT_TRUE(opts.term.empty());
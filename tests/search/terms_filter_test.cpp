@@ -305,6 +305,55 @@ TEST_P(terms_filter_test_case, simple_sequential) {
   }
 }
 
+TEST_P(terms_filter_test_case, bulk_sequential) {
+  // add segment
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  auto& segment = rdr[0];
+
+  // every other name along with missing terms in between and beyond
+  irs::by_terms filter;
+  *filter.mutable_field() = "name";
+  docs_t result;
+  for (char c = 'A'; c <= 'Z'; ++c) {
+    const std::string name(1, c);
+    if (0 == (c - 'A') % 2) {
+      filter.mutable_options()->terms.emplace(irs::ref_cast<irs::byte_type>(name));
+      result.push_back(irs::doc_id_t(irs::doc_limits::min() + (c - 'A')));
+    }
+    filter.mutable_options()->terms.emplace(irs::ref_cast<irs::byte_type>(name + "0"));
+  }
+  filter.mutable_options()->terms.emplace(irs::ref_cast<irs::byte_type>(irs::string_ref("~~")));
+  ASSERT_EQ(13, result.size());
+
+  // unscored terms are merged into a bitset
+  check_query(filter, result, costs_t{ result.size() }, rdr);
+
+  // scored terms are evaluated via a disjunction
+  {
+    irs::order order;
+    order.add<irs::boost_sort>(false);
+    check_query(filter, order, result, rdr);
+  }
+
+  // test visit
+  tests::empty_filter_visitor visitor;
+  const auto* reader = segment.field("name");
+  ASSERT_NE(nullptr, reader);
+  irs::by_terms::visit(segment, *reader, filter.options().terms, visitor);
+  ASSERT_EQ(1, visitor.prepare_calls_counter());
+  ASSERT_EQ(13, visitor.visit_calls_counter());
+  ASSERT_EQ("A", visitor.term_refs<char>().front().first);
+  ASSERT_EQ("Y", visitor.term_refs<char>().back().first);
+}
+
 INSTANTIATE_TEST_SUITE_P(
   terms_filter_test,
   terms_filter_test_case,
@@ -0,0 +1,635 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "index/comparer.hpp"
+#include "search/filter_test_case_base.hpp"
+#include "search/bm25.hpp"
+#include "search/boolean_filter.hpp"
+#include "search/score.hpp"
+#include "search/term_filter.hpp"
+#include "search/top_docs_collector.hpp"
+#include "utils/async_utils.hpp"
+
+namespace {
+
+using namespace tests;
+
+// orders 'long_field' values from the largest to the smallest one,
+// missing values go last
+struct descending_long_comparer final : irs::comparer {
+  static int64_t decode(irs::bytes_ref value) {
+    auto* begin = value.c_str();
+    return irs::zig_zag_decode64(irs::vread<uint64_t>(begin));
+  }
+
+ protected:
+  virtual bool less(const irs::bytes_ref& lhs, const irs::bytes_ref& rhs) const override {
+    if (lhs.empty() || rhs.empty()) {
+      return !lhs.empty() && rhs.empty();
+    }
+
+    return decode(lhs) > decode(rhs);
+  }
+};
+
+// orders by the last decimal digit first
+struct last_digit_long_comparer final : irs::comparer {
+  static std::pair<int64_t, int64_t> key(irs::bytes_ref value) {
+    const auto v = descending_long_comparer::decode(value);
+    return { v % 10, v };
+  }
+
+ protected:
+  virtual bool less(const irs::bytes_ref& lhs, const irs::bytes_ref& rhs) const override {
+    if (lhs.empty() || rhs.empty()) {
+      return !lhs.empty() && rhs.empty();
+    }
+
+    return key(lhs) < key(rhs);
+  }
+};
+
+class top_docs_collector_test_case : public index_test_base {
+ protected:
+  void add_segments() {
+    tests::json_doc_generator gen(
+      resource("simple_sequential_order.json"),
+      [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        if (data.is_string()) { // field
+          doc.insert(std::make_shared<string_field>(name, data.str), true, false);
+        } else if (data.is_number()) { // seq
+          const auto value = std::to_string(data.as_number<uint64_t>());
+          doc.insert(std::make_shared<string_field>(name, value), false, true);
+        }
+    });
+    add_segment(gen);
+    gen.reset();
+    add_segment(gen, irs::OM_APPEND);
+  }
+
+  static irs::filter::ptr make_filter(std::initializer_list<const char*> terms) {
+    auto filter = irs::Or::make();
+    for (auto* term : terms) {
+      auto& sub = static_cast<irs::Or&>(*filter).add<irs::by_term>();
+      *sub.mutable_field() = "field";
+      sub.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref(term));
+    }
+    return filter;
+  }
+
+  // scores of all matched documents ordered from the best to the worst one
+  static std::vector<float_t> expected_scores(
+      const irs::index_reader& reader,
+      const irs::filter::prepared& filter,
+      const irs::order::prepared& order) {
+    std::vector<float_t> scores;
+
+    for (auto& segment : reader) {
+      auto docs = segment.mask(filter.execute(segment, order));
+      auto& score = irs::score::get(*docs);
+
+      while (docs->next()) {
+        scores.emplace_back(order.get<float_t>(score.evaluate(), 0));
+      }
+    }
+
+    std::sort(scores.begin(), scores.end(), std::greater<>());
+    return scores;
+  }
+};
+
+TEST_P(top_docs_collector_test_case, collect) {
+  add_segments();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+
+  irs::order ord;
+  ord.add<irs::bm25_sort>(true);
+  auto order = ord.prepare();
+
+  for (auto terms : { std::initializer_list<const char*>{ "7" },
+                      std::initializer_list<const char*>{ "0", "2", "7", "9" },
+                      std::initializer_list<const char*>{ "2", "4", "8" } }) {
+    auto prepared = make_filter(terms)->prepare(reader, order);
+    ASSERT_NE(nullptr, prepared);
+
+    const auto expected = expected_scores(reader, *prepared, order);
+    ASSERT_FALSE(expected.empty());
+
+    for (size_t limit : { size_t(1), size_t(3), expected.size(), expected.size() + 5 }) {
+      irs::top_docs_collector collector(order, limit);
+      ASSERT_TRUE(collector.prunes());
+      ASSERT_EQ(limit, collector.limit());
+
+      const size_t count = collector.collect(reader, *prepared);
+      ASSERT_LE(count, expected.size());
+      ASSERT_GE(count, std::min(limit, expected.size()));
+
+      auto& top = collector.sorted();
+      ASSERT_EQ(std::min(limit, expected.size()), top.size());
+
+      for (size_t i = 0; i < top.size(); ++i) {
+        ASSERT_LT(top[i].segment, reader.size());
+        ASSERT_TRUE(irs::doc_limits::valid(top[i].doc));
+        ASSERT_FLOAT_EQ(expected[i], order.get<float_t>(top[i].score, 0));
+      }
+
+      // collector is reusable
+      collector.clear();
+      ASSERT_TRUE(collector.empty());
+      collector.collect(reader[0], 0, *prepared);
+      collector.sorted();
+      collector.collect(reader[1], 1, *prepared);
+      ASSERT_EQ(top.size(), collector.sorted().size());
+
+      for (size_t i = 0; i < top.size(); ++i) {
+        ASSERT_FLOAT_EQ(expected[i], order.get<float_t>(top[i].score, 0));
+      }
+    }
+  }
+}
+
+TEST_P(top_docs_collector_test_case, collect_bulk) {
+  // terms occur in more documents than scored by a single kernel call
+  const auto data = make_digit_docs(500);
+  tests::json_doc_generator gen(
+    data.c_str(),
+    [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+      if (data.is_string()) { // field
+        doc.insert(std::make_shared<string_field>(name, data.str), true, false);
+      }
+  });
+  add_segment(gen);
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+
+  irs::order ord;
+  ord.add<irs::bm25_sort>(true);
+  auto order = ord.prepare();
+
+  irs::by_term filter;
+  *filter.mutable_field() = "field";
+  filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("7"));
+
+  auto prepared = filter.prepare(reader, order);
+  ASSERT_NE(nullptr, prepared);
+
+  {
+    auto docs = prepared->execute(reader[0], order);
+    ASSERT_TRUE(irs::score::get(*docs).bulk);
+  }
+
+  const auto expected = expected_scores(reader, *prepared, order);
+  ASSERT_LT(irs::bulk_score_function::kBlockSize, expected.size());
+
+  for (size_t limit : { size_t(1), size_t(10), irs::bulk_score_function::kBlockSize + 1, expected.size() }) {
+    irs::top_docs_collector collector(order, limit);
+    // documents are scored block by block, none of them are skipped
+    ASSERT_EQ(expected.size(), collector.collect(reader, *prepared));
+
+    auto& top = collector.sorted();
+    ASSERT_EQ(limit, top.size());
+
+    for (size_t i = 0; i < top.size(); ++i) {
+      ASSERT_TRUE(irs::doc_limits::valid(top[i].doc));
+      ASSERT_FLOAT_EQ(expected[i], order.get<float_t>(top[i].score, 0));
+    }
+  }
+}
+
+TEST_P(top_docs_collector_test_case, collect_removed) {
+  add_segments();
+
+  // remove documents which would be the best matches otherwise
+  {
+    auto writer = open_writer(irs::OM_APPEND);
+    irs::by_term removal;
+    *removal.mutable_field() = "field";
+    removal.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("7"));
+    writer->documents().remove(removal);
+    writer->commit();
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+  ASSERT_LT(reader.live_docs_count(), reader.docs_count());
+
+  irs::order ord;
+  ord.add<irs::bm25_sort>(true);
+  auto order = ord.prepare();
+
+  auto prepared = make_filter({ "0", "2", "7", "9" })->prepare(reader, order);
+  const auto expected = expected_scores(reader, *prepared, order);
+  ASSERT_FALSE(expected.empty());
+
+  auto assert_live = [&](irs::top_docs_collector& collector, size_t limit) {
+    auto& top = collector.sorted();
+    ASSERT_EQ(std::min(limit, expected.size()), top.size());
+
+    for (size_t i = 0; i < top.size(); ++i) {
+      const auto* live_docs = reader[top[i].segment].live_docs();
+      ASSERT_NE(nullptr, live_docs);
+      ASSERT_TRUE(live_docs->test(top[i].doc));
+      ASSERT_FLOAT_EQ(expected[i], order.get<float_t>(top[i].score, 0));
+    }
+  };
+
+  irs::async_utils::thread_pool pool(2, 2);
+
+  for (size_t limit : { size_t(1), size_t(5), expected.size() + 5 }) {
+    irs::top_docs_collector collector(order, limit);
+    ASSERT_LE(collector.collect(reader, *prepared), expected.size());
+    assert_live(collector, limit);
+
+    irs::top_docs_collector parallel(order, limit);
+    ASSERT_LE(parallel.collect(pool, reader, *prepared), expected.size());
+    assert_live(parallel, limit);
+  }
+}
+
+TEST_P(top_docs_collector_test_case, collect_no_limit) {
+  add_segments();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+
+  irs::order ord;
+  ord.add<irs::bm25_sort>(true);
+  auto order = ord.prepare();
+
+  auto prepared = make_filter({ "0", "2" })->prepare(reader, order);
+  irs::top_docs_collector collector(order, 0);
+  ASSERT_EQ(0, collector.collect(reader, *prepared));
+  ASSERT_TRUE(collector.sorted().empty());
+}
+
+TEST_P(top_docs_collector_test_case, collect_unordered) {
+  add_segments();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  auto& order = irs::order::prepared::unordered();
+
+  auto prepared = make_filter({ "0", "2", "7", "9" })->prepare(reader, order);
+  size_t expected = 0;
+  for (auto& segment : reader) {
+    auto docs = prepared->execute(segment);
+    while (docs->next()) {
+      ++expected;
+    }
+  }
+
+  irs::top_docs_collector collector(order, 3);
+  ASSERT_FALSE(collector.prunes());
+  // all documents are visited
+  ASSERT_EQ(expected, collector.collect(reader, *prepared));
+  ASSERT_EQ(3, collector.sorted().size());
+}
+
+TEST_P(top_docs_collector_test_case, collect_ascending) {
+  add_segments();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+
+  irs::order ord;
+  ord.add<irs::bm25_sort>(false);
+  auto order = ord.prepare();
+
+  auto prepared = make_filter({ "0", "2", "7", "9" })->prepare(reader, order);
+  auto expected = expected_scores(reader, *prepared, order);
+  std::reverse(expected.begin(), expected.end());
+
+  irs::top_docs_collector collector(order, 4);
+  // thresholds are only meaningful for descending order
+  ASSERT_FALSE(collector.prunes());
+  ASSERT_EQ(expected.size(), collector.collect(reader, *prepared));
+
+  auto& top = collector.sorted();
+  ASSERT_EQ(4, top.size());
+  for (size_t i = 0; i < top.size(); ++i) {
+    ASSERT_FLOAT_EQ(expected[i], order.get<float_t>(top[i].score, 0));
+  }
+}
+
+TEST_P(top_docs_collector_test_case, collect_parallel) {
+  add_segments();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+
+  irs::order ord;
+  ord.add<irs::bm25_sort>(true);
+  auto order = ord.prepare();
+
+  auto prepared = make_filter({ "0", "2", "7", "9" })->prepare(reader, order);
+  const auto expected = expected_scores(reader, *prepared, order);
+  ASSERT_FALSE(expected.empty());
+
+  for (size_t threads : { size_t(0), size_t(1), size_t(4) }) {
+    irs::async_utils::thread_pool pool(threads, threads);
+
+    for (size_t limit : { size_t(1), size_t(3), expected.size() + 5 }) {
+      irs::top_docs_collector collector(order, limit);
+      const size_t count = collector.collect(pool, reader, *prepared);
+      ASSERT_LE(count, expected.size());
+      ASSERT_GE(count, std::min(limit, expected.size()));
+
+      auto& top = collector.sorted();
+      ASSERT_EQ(std::min(limit, expected.size()), top.size());
+
+      for (size_t i = 0; i < top.size(); ++i) {
+        ASSERT_LT(top[i].segment, reader.size());
+        ASSERT_TRUE(irs::doc_limits::valid(top[i].doc));
+        ASSERT_FLOAT_EQ(expected[i], order.get<float_t>(top[i].score, 0));
+      }
+
+      // merged entries are sorted the same way as the sequentially collected ones
+      irs::top_docs_collector sequential(order, limit);
+      sequential.collect(reader, *prepared);
+      auto& sequential_top = sequential.sorted();
+      ASSERT_EQ(sequential_top.size(), top.size());
+
+      for (size_t i = 0; i < top.size(); ++i) {
+        ASSERT_FLOAT_EQ(order.get<float_t>(sequential_top[i].score, 0),
+                        order.get<float_t>(top[i].score, 0));
+      }
+    }
+  }
+}
+
+TEST_P(top_docs_collector_test_case, collect_parallel_cancel) {
+  add_segments();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  auto& order = irs::order::prepared::unordered();
+  auto prepared = make_filter({ "0", "2", "7", "9" })->prepare(reader, order);
+
+  irs::async_utils::thread_pool pool(2, 2);
+  irs::top_docs_collector collector(order, 3);
+
+  // cancelled before any segment is visited
+  ASSERT_EQ(0, collector.collect(pool, reader, *prepared, nullptr,
+                                 []() { return false; }));
+  ASSERT_TRUE(collector.empty());
+
+  // not cancelled
+  std::atomic<size_t> calls{0};
+  ASSERT_LT(0, collector.collect(pool, reader, *prepared, nullptr,
+                                 [&calls]() { ++calls; return true; }));
+  ASSERT_LE(reader.size(), calls);
+  ASSERT_EQ(3, collector.sorted().size());
+}
+
+TEST_P(top_docs_collector_test_case, collect_index_sort) {
+  constexpr size_t kSegments = 3;
+  constexpr size_t kDocsPerSegment = 300;
+
+  descending_long_comparer less;
+  irs::index_writer::init_options opts;
+  opts.comparator = &less;
+
+  // newest documents go first in every segment
+  auto writer = open_writer(irs::OM_CREATE, opts);
+  std::vector<int64_t> expected;
+
+  for (size_t i = 0; i < kSegments; ++i) {
+    {
+      auto ctx = writer->documents();
+
+      for (size_t j = 0; j < kDocsPerSegment; ++j) {
+        const int64_t seq = int64_t((j * 7919 + i) % (kSegments * kDocsPerSegment));
+        auto doc = ctx.insert();
+
+        const auto tag = std::make_shared<string_field>("tag", seq % 3 ? "b" : "a");
+        doc.insert<irs::Action::INDEX>(*tag);
+
+        const auto value = std::make_shared<long_field>();
+        value->name("seq");
+        value->value(seq);
+        doc.insert<irs::Action::STORE_SORTED>(*value);
+
+        if (!(seq % 3)) {
+          expected.emplace_back(seq);
+        }
+      }
+    }
+    writer->commit();
+  }
+
+  std::sort(expected.begin(), expected.end(), std::greater<>());
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(kSegments, reader.size());
+  for (auto& segment : reader) {
+    ASSERT_NE(nullptr, segment.sort());
+  }
+
+  irs::by_term filter;
+  *filter.mutable_field() = "tag";
+  filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("a"));
+  auto prepared = filter.prepare(reader);
+
+  for (size_t limit : { size_t(1), size_t(10), expected.size(), expected.size() + 5 }) {
+    irs::top_sorted_docs_collector collector(less, &less, limit);
+    ASSERT_EQ(limit, collector.limit());
+
+    const size_t count = collector.collect(reader, *prepared);
+
+    if (limit < expected.size()) {
+      // at most 'limit + 1' documents are visited per segment
+      ASSERT_LE(count, kSegments * (limit + 1));
+    } else {
+      ASSERT_EQ(expected.size(), count);
+    }
+
+    auto& top = collector.sorted();
+    ASSERT_EQ(std::min(limit, expected.size()), top.size());
+
+    for (size_t i = 0; i < top.size(); ++i) {
+      ASSERT_EQ(expected[i], descending_long_comparer::decode(top[i].key));
+      ASSERT_LT(top[i].segment, reader.size());
+
+      // collected key matches the one of a document
+      auto values = reader[top[i].segment].sort()->iterator(false);
+      auto* payload = irs::get<irs::payload>(*values);
+      ASSERT_NE(nullptr, payload);
+      ASSERT_EQ(top[i].doc, values->seek(top[i].doc));
+      ASSERT_EQ(irs::bytes_ref(top[i].key), payload->value);
+    }
+
+    // collector is reusable
+    collector.clear();
+    ASSERT_TRUE(collector.empty());
+    for (size_t i = reader.size(); i; --i) {
+      collector.collect(reader[i - 1], i - 1, *prepared);
+      collector.sorted();
+    }
+    ASSERT_EQ(top.size(), collector.sorted().size());
+
+    for (size_t i = 0; i < top.size(); ++i) {
+      ASSERT_EQ(expected[i], descending_long_comparer::decode(top[i].key));
+    }
+  }
+
+  irs::top_sorted_docs_collector collector(less, &less, 0);
+  ASSERT_EQ(0, collector.collect(reader, *prepared));
+  ASSERT_TRUE(collector.sorted().empty());
+}
+
+TEST_P(top_docs_collector_test_case, collect_index_sort_removed) {
+  constexpr size_t kDocsPerSegment = 300;
+
+  descending_long_comparer less;
+  irs::index_writer::init_options opts;
+  opts.comparator = &less;
+
+  auto writer = open_writer(irs::OM_CREATE, opts);
+  {
+    auto ctx = writer->documents();
+
+    for (size_t j = 0; j < kDocsPerSegment; ++j) {
+      auto doc = ctx.insert();
+
+      const auto tag = std::make_shared<string_field>("tag", "a");
+      doc.insert<irs::Action::INDEX>(*tag);
+
+      const auto parity = std::make_shared<string_field>("parity", j % 2 ? "odd" : "even");
+      doc.insert<irs::Action::INDEX>(*parity);
+
+      const auto value = std::make_shared<long_field>();
+      value->name("seq");
+      value->value(int64_t(j));
+      doc.insert<irs::Action::STORE_SORTED>(*value);
+    }
+  }
+  writer->commit();
+
+  // remove every document with an odd key, including the greatest one
+  irs::by_term removal;
+  *removal.mutable_field() = "parity";
+  removal.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("odd"));
+  writer->documents().remove(removal);
+  writer->commit();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+  ASSERT_NE(nullptr, reader[0].sort());
+  ASSERT_EQ(kDocsPerSegment / 2, reader.live_docs_count());
+  const auto* live_docs = reader[0].live_docs();
+  ASSERT_NE(nullptr, live_docs);
+
+  irs::by_term filter;
+  *filter.mutable_field() = "tag";
+  filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("a"));
+  auto prepared = filter.prepare(reader);
+
+  for (const bool pass_index_less : { false, true }) {
+    constexpr size_t kLimit = 10;
+
+    irs::top_sorted_docs_collector collector(
+      less, pass_index_less ? &less : nullptr, kLimit);
+    const size_t count = collector.collect(reader, *prepared);
+    ASSERT_LE(count, kDocsPerSegment / 2);
+
+    // greatest even keys only
+    auto& top = collector.sorted();
+    ASSERT_EQ(kLimit, top.size());
+    for (size_t i = 0; i < top.size(); ++i) {
+      ASSERT_EQ(int64_t(kDocsPerSegment - 2 - 2 * i),
+                descending_long_comparer::decode(top[i].key));
+      ASSERT_TRUE(live_docs->test(top[i].doc));
+    }
+  }
+}
+
+TEST_P(top_docs_collector_test_case, collect_index_sort_mismatch) {
+  constexpr size_t kDocsPerSegment = 300;
+
+  descending_long_comparer index_less;
+  irs::index_writer::init_options opts;
+  opts.comparator = &index_less;
+
+  auto writer = open_writer(irs::OM_CREATE, opts);
+  {
+    auto ctx = writer->documents();
+
+    for (size_t j = 0; j < kDocsPerSegment; ++j) {
+      auto doc = ctx.insert();
+
+      const auto tag = std::make_shared<string_field>("tag", "a");
+      doc.insert<irs::Action::INDEX>(*tag);
+
+      const auto value = std::make_shared<long_field>();
+      value->name("seq");
+      value->value(int64_t(j));
+      doc.insert<irs::Action::STORE_SORTED>(*value);
+    }
+  }
+  writer->commit();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+  ASSERT_NE(nullptr, reader[0].sort());
+
+  irs::by_term filter;
+  *filter.mutable_field() = "tag";
+  filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("a"));
+  auto prepared = filter.prepare(reader);
+
+  constexpr size_t kLimit = 10;
+
+  // smallest values having 0 as the last digit
+  std::vector<int64_t> expected;
+  for (int64_t i = 0; i < int64_t(kLimit); ++i) {
+    expected.emplace_back(i * 10);
+  }
+
+  // requested order differs from the order of the index,
+  // documents of a sorted segment must not be skipped
+  for (const bool pass_index_less : { false, true }) {
+    last_digit_long_comparer less;
+    irs::top_sorted_docs_collector collector(
+      less, pass_index_less ? &index_less : nullptr, kLimit);
+    ASSERT_EQ(kDocsPerSegment, collector.collect(reader, *prepared));
+
+    auto& top = collector.sorted();
+    ASSERT_EQ(kLimit, top.size());
+    for (size_t i = 0; i < top.size(); ++i) {
+      ASSERT_EQ(expected[i], descending_long_comparer::decode(top[i].key));
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  top_docs_collector_test,
+  top_docs_collector_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::directory<&tests::memory_directory>,
+      &tests::directory<&tests::fs_directory>),
+    ::testing::Values("1_0", "1_4")),
+  top_docs_collector_test_case::to_string
+);
+
+}
@@ -409,6 +409,101 @@ void vencode_from_array(T expected_value, size_t expected_length) {
   }
 }
 
+// returns size of the written block
+size_t read_write_block_patched(const std::vector<uint32_t>& src) {
+  static constexpr size_t BLOCK_SIZE = 128;
+  EXPECT_EQ(BLOCK_SIZE, src.size());
+  uint32_t encoded[BLOCK_SIZE];
+  std::fill_n(encoded, BLOCK_SIZE, std::numeric_limits<uint32_t>::max());
+
+  auto pack = [](const uint32_t* decoded, uint32_t* encoded, const uint32_t bits) {
+    irs::packed::pack(decoded, decoded + BLOCK_SIZE, encoded, bits);
+  };
+
+  auto unpack = [](uint32_t* decoded, const uint32_t* encoded, const uint32_t bits) {
+    irs::packed::unpack(decoded, decoded + BLOCK_SIZE, encoded, bits);
+  };
+
+  irs::bstring buf;
+  irs::bytes_output out(buf);
+  irs::bitpack::write_block32_patched<BLOCK_SIZE>(pack, out, src.data(), encoded);
+  const size_t size = buf.size();
+  out.write_byte(42);
+
+  {
+    irs::bytes_ref_input in(buf);
+    std::vector<uint32_t> read(BLOCK_SIZE);
+    irs::bitpack::read_block32_patched<BLOCK_SIZE>(unpack, in, encoded, read.data());
+    EXPECT_EQ(src, read);
+    EXPECT_EQ(42, in.read_byte());
+  }
+
+  {
+    irs::bytes_ref_input in(buf);
+    irs::bitpack::skip_block32_patched(in, BLOCK_SIZE);
+    EXPECT_EQ(42, in.read_byte());
+  }
+
+  return size;
+}
+
+size_t read_write_block_dense(const std::vector<uint32_t>& src) {
+  static constexpr size_t BLOCK_SIZE = 128;
+  EXPECT_EQ(BLOCK_SIZE, src.size());
+  uint32_t encoded[BLOCK_SIZE];
+  std::fill_n(encoded, BLOCK_SIZE, std::numeric_limits<uint32_t>::max());
+
+  auto pack = [](const uint32_t* decoded, uint32_t* encoded, const uint32_t bits) {
+    irs::packed::pack(decoded, decoded + BLOCK_SIZE, encoded, bits);
+  };
+
+  auto unpack = [](uint32_t* decoded, const uint32_t* encoded, const uint32_t bits) {
+    irs::packed::unpack(decoded, decoded + BLOCK_SIZE, encoded, bits);
+  };
+
+  irs::bstring buf;
+  irs::bytes_output out(buf);
+  const auto bits = irs::bitpack::write_block32_dense<BLOCK_SIZE>(
+    pack, out, src.data(), encoded);
+  const size_t size = buf.size();
+  out.write_byte(42);
+
+  {
+    irs::bytes_ref_input in(buf);
+    std::vector<uint32_t> read(BLOCK_SIZE);
+    irs::bitpack::read_block32_dense<BLOCK_SIZE>(unpack, in, encoded, read.data());
+    EXPECT_EQ(src, read);
+    EXPECT_EQ(42, in.read_byte());
+  }
+
+  // bitmap words denote prefix sums of the deltas
+  {
+    std::vector<uint64_t> expected;
+    uint64_t sum = 0;
+    for (const auto delta : src) {
+      sum += delta;
+      expected.resize(sum / 64 + 1);
+      expected[sum / 64] |= uint64_t(1) << (sum % 64);
+    }
+
+    irs::bytes_ref_input in(buf);
+    std::vector<uint32_t> read(BLOCK_SIZE);
+    std::vector<uint64_t> words;
+    const bool dense = irs::bitpack::visit_block32_dense<BLOCK_SIZE>(
+      unpack, in, encoded, read.data(),
+      [&words](uint64_t word) { words.emplace_back(word); });
+    EXPECT_EQ(irs::bitpack::BITMAP == bits, dense);
+    if (dense) {
+      EXPECT_EQ(expected, words);
+    } else {
+      EXPECT_EQ(src, read);
+    }
+    EXPECT_EQ(42, in.read_byte());
+  }
+
+  return size;
+}
+
 #ifdef IRESEARCH_SSE2
 
 template<size_t N>
@@ -838,6 +933,89 @@ TEST(store_utils_tests, read_write_block) {
   }
 }
 
+TEST(store_utils_tests, read_write_block_patched) {
+  const size_t block_size = 128;
+
+  // small values with a few outliers
+  {
+    std::vector<uint32_t> data(block_size);
+    for (size_t i = 0; i < block_size; ++i) {
+      data[i] = uint32_t(i % 7);
+    }
+    data[3] = 1000000;
+    data[64] = std::numeric_limits<uint32_t>::max();
+    data[127] = 100;
+
+    const auto size = tests::detail::read_write_block_patched(data);
+    // 3 bits per value + exceptions, rather than 32 bits per value
+    ASSERT_LT(size, irs::packed::bytes_required_32(block_size, 8));
+  }
+
+  // outliers only
+  {
+    std::vector<uint32_t> data(block_size, 0);
+    data[0] = 17;
+    // header + 1 bit per value + single exception
+    ASSERT_EQ(2 + 16 + 2, tests::detail::read_write_block_patched(data));
+  }
+
+  // no outliers, block is stored as is
+  {
+    std::vector<uint32_t> data(block_size);
+    for (size_t i = 0; i < block_size; ++i) {
+      data[i] = uint32_t(i);
+    }
+
+    ASSERT_EQ(1 + irs::packed::bytes_required_32(block_size, 7),
+              tests::detail::read_write_block_patched(data));
+  }
+
+  // all equal
+  ASSERT_EQ(2, tests::detail::read_write_block_patched(
+    std::vector<uint32_t>(block_size, 5)));
+}
+
+TEST(store_utils_tests, read_write_block_dense) {
+  const size_t block_size = 128;
+
+  // mostly contiguous deltas are stored as a bitmap
+  {
+    std::vector<uint32_t> data(block_size);
+    for (size_t i = 0; i < block_size; ++i) {
+      data[i] = 9 == i % 10 ? 3 : 1;
+    }
+    data[0] = 0; // the very first document of a term
+
+    // header + number of words + 3 words
+    ASSERT_EQ(2 + 3*sizeof(uint64_t), tests::detail::read_write_block_dense(data));
+  }
+
+  // contiguous deltas
+  ASSERT_EQ(2, tests::detail::read_write_block_dense(
+    std::vector<uint32_t>(block_size, 1)));
+
+  // sparse deltas are stored as a patched block
+  {
+    std::vector<uint32_t> data(block_size);
+    for (size_t i = 0; i < block_size; ++i) {
+      data[i] = uint32_t(1 + i * 1000);
+    }
+
+    ASSERT_EQ(tests::detail::read_write_block_patched(data),
+              tests::detail::read_write_block_dense(data));
+  }
+
+  // zero deltas can't be stored as a bitmap
+  {
+    std::vector<uint32_t> data(block_size, 1);
+    data[64] = 0;
+    data[65] = 2;
+
+    ASSERT_EQ(tests::detail::read_write_block_patched(data),
+              tests::detail::read_write_block_dense(data));
+  }
+}
+
 TEST(store_utils_tests, shift_pack_unpack_32) {
   tests::detail::shift_pack_unpack_core_32(2343242, true);
   tests::detail::shift_pack_unpack_core_32(2343242, false);
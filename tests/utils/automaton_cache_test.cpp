@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2022 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+
+#include <thread>
+
+#include "utils/automaton_cache.hpp"
+#include "utils/automaton_utils.hpp"
+#include "utils/levenshtein_default_pdp.hpp"
+#include "utils/levenshtein_utils.hpp"
+
+namespace {
+
+irs::bytes_ref ref(irs::string_ref value) {
+  return irs::ref_cast<irs::byte_type>(value);
+}
+
+bool accept(const irs::automaton& a, irs::string_ref value) {
+  return bool(irs::accept<irs::byte_type>(a, ref(value)));
+}
+
+}
+
+TEST(automaton_cache_test, wildcard) {
+  irs::automaton_cache cache;
+  ASSERT_EQ(irs::automaton_cache::kDefaultMaxBytes, cache.max_bytes());
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(0, cache.bytes());
+
+  auto a0 = cache.wildcard(ref("%rc%"));
+  ASSERT_NE(nullptr, a0);
+  ASSERT_TRUE(irs::validate(*a0, false));
+  ASSERT_TRUE(accept(*a0, "corrction"));
+  ASSERT_FALSE(accept(*a0, "correction"));
+  ASSERT_EQ(0, cache.hits());
+  ASSERT_EQ(1, cache.misses());
+  ASSERT_EQ(1, cache.size());
+  ASSERT_LT(0, cache.bytes());
+
+  auto a1 = cache.wildcard(ref("%rc%"));
+  ASSERT_EQ(a0, a1);
+  ASSERT_EQ(1, cache.hits());
+  ASSERT_EQ(1, cache.misses());
+
+  auto a2 = cache.wildcard(ref("%rc_"));
+  ASSERT_NE(a0, a2);
+  ASSERT_TRUE(accept(*a2, "corrcx"));
+  ASSERT_EQ(2, cache.misses());
+  ASSERT_EQ(2, cache.size());
+
+  cache.clear();
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(0, cache.bytes());
+
+  // entries outlive the cache
+  ASSERT_TRUE(accept(*a0, "corrction"));
+}
+
+TEST(automaton_cache_test, levenshtein) {
+  irs::automaton_cache cache;
+
+  const auto& d1 = irs::default_pdp(1, false);
+  const auto& d2 = irs::default_pdp(2, false);
+  const auto& d1t = irs::default_pdp(1, true);
+
+  auto a0 = cache.levenshtein(d1, false, ref("pre"), ref("fix"));
+  ASSERT_NE(nullptr, a0);
+  ASSERT_TRUE(accept(*a0, "prefix"));
+  ASSERT_TRUE(accept(*a0, "prefex"));
+  ASSERT_FALSE(accept(*a0, "prefxx"));
+  ASSERT_FALSE(accept(*a0, "perfix"));
+
+  ASSERT_EQ(a0, cache.levenshtein(d1, false, ref("pre"), ref("fix")));
+  // same word, different split or distance
+  ASSERT_NE(a0, cache.levenshtein(d1, false, ref("pref"), ref("ix")));
+  auto a1 = cache.levenshtein(d2, false, ref("pre"), ref("fix"));
+  ASSERT_NE(a0, a1);
+  ASSERT_TRUE(accept(*a1, "prefxx"));
+  // same distance, transpositions
+  auto a2 = cache.levenshtein(d1t, true, ref("pre"), ref("fix"));
+  ASSERT_NE(a0, a2);
+  ASSERT_TRUE(accept(*a2, "perfix"));
+  // same pattern, different kind
+  ASSERT_NE(a0, cache.wildcard(ref("prefix")));
+
+  // equal description at a different address
+  const auto d1_copy = irs::make_parametric_description(1, false);
+  ASSERT_EQ(d1, d1_copy);
+  ASSERT_EQ(a0, cache.levenshtein(d1_copy, false, ref("pre"), ref("fix")));
+
+  ASSERT_EQ(2, cache.hits());
+  ASSERT_EQ(5, cache.misses());
+  ASSERT_EQ(5, cache.size());
+}
+
+TEST(automaton_cache_test, eviction) {
+  irs::automaton_cache cache;
+
+  auto a0 = cache.wildcard(ref("a%"));
+  const size_t bytes = cache.bytes();
+  ASSERT_LT(0, bytes);
+
+  // room for a single entry only
+  cache.max_bytes(bytes + bytes / 2);
+  ASSERT_EQ(1, cache.size());
+
+  auto a1 = cache.wildcard(ref("b%"));
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(a1, cache.wildcard(ref("b%")));
+  ASSERT_NE(a0, cache.wildcard(ref("a%"))); // evicted
+  ASSERT_EQ(1, cache.size());
+
+  // least recently used entry goes first
+  cache.max_bytes(2 * bytes + bytes / 2);
+  auto a2 = cache.wildcard(ref("a%"));
+  auto a3 = cache.wildcard(ref("c%"));
+  ASSERT_EQ(a2, cache.wildcard(ref("a%")));
+  cache.wildcard(ref("d%"));
+  ASSERT_EQ(a2, cache.wildcard(ref("a%")));
+  ASSERT_NE(a3, cache.wildcard(ref("c%")));
+
+  // caching disabled
+  cache.max_bytes(0);
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(0, cache.bytes());
+  auto a4 = cache.wildcard(ref("a%"));
+  ASSERT_TRUE(accept(*a4, "abc"));
+  ASSERT_EQ(0, cache.size());
+}
+
+TEST(automaton_cache_test, concurrent) {
+  irs::automaton_cache cache;
+
+  constexpr size_t kThreads = 8;
+  constexpr size_t kPatterns = 16;
+
+  std::vector<std::thread> threads;
+  threads.reserve(kThreads);
+
+  for (size_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&cache]() {
+      for (size_t j = 0; j < 10 * kPatterns; ++j) {
+        const std::string pattern = std::to_string(j % kPatterns) + "%";
+        auto a = cache.wildcard(ref(irs::string_ref(pattern)));
+        auto matcher = irs::make_automaton_matcher(*a, false);
+        EXPECT_TRUE(accept(*a, std::to_string(j % kPatterns) + "abc"));
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(kPatterns, cache.size());
+  ASSERT_EQ(kThreads * 10 * kPatterns, cache.hits() + cache.misses());
+}
@@ -24,6 +24,7 @@
 #include <fstream>
 #include <list>
 #include <set>
+#include <thread>
 #include <map>
 
 #include "tests_shared.hpp"
@@ -1013,3 +1014,89 @@ TEST_F(memory_pool_allocator_test, allocate_shared) {
     ASSERT_EQ(1, dtor_calls);
   }
 }
+
+TEST(pooled_object_test, recycle) {
+  struct pooled : irs::memory::pooled_object<pooled, 2> {
+    explicit pooled(int value) : value(value) { }
+    virtual ~pooled() = default;
+    int value;
+  };
+
+  struct derived : pooled {
+    derived() : pooled(42) { }
+    char buf[64];
+  };
+
+  std::thread([]() {
+    auto* p0 = new pooled(1);
+    auto* p1 = new pooled(2);
+    auto* p2 = new pooled(3);
+    ASSERT_EQ(1, p0->value);
+    delete p0;
+    delete p1;
+    delete p2; // exceeds capacity, goes back to the heap
+
+    // recycled in LIFO order
+    auto* p3 = new pooled(4);
+    ASSERT_EQ(static_cast<void*>(p1), static_cast<void*>(p3));
+    ASSERT_EQ(4, p3->value);
+    auto* p4 = new pooled(5);
+    ASSERT_EQ(static_cast<void*>(p0), static_cast<void*>(p4));
+
+    // derived types aren't pooled
+    std::unique_ptr<pooled> d = std::make_unique<derived>();
+    ASSERT_EQ(42, d->value);
+    d.reset();
+    auto* p5 = new pooled(6);
+
+    // freed on a different thread
+    std::thread([p3, p4, p5]() {
+      delete p3;
+      delete p4;
+      delete p5;
+    }).join();
+  }).join();
+}
+
+TEST(vector_pool_test, recycle) {
+  using pool = irs::memory::vector_pool<std::shared_ptr<int>, 2, 16>;
+
+  std::thread([]() {
+    auto v0 = pool::make(4);
+    ASSERT_TRUE(v0.empty());
+    ASSERT_LE(4, v0.capacity());
+    auto value = std::make_shared<int>(1);
+    v0.emplace_back(value);
+    const auto* buf0 = v0.data();
+
+    // elements are destroyed, the buffer is kept
+    pool::release(v0);
+    ASSERT_EQ(1, value.use_count());
+
+    auto v1 = pool::make(2);
+    ASSERT_TRUE(v1.empty());
+    ASSERT_EQ(buf0, v1.data());
+
+    // buffer is grown if needed
+    pool::release(v1);
+    auto v2 = pool::make(8);
+    ASSERT_LE(8, v2.capacity());
+
+    // too large buffers aren't cached
+    auto v3 = pool::make(17);
+    pool::release(v3);
+    auto v4 = pool::make(0);
+    ASSERT_EQ(0, v4.capacity());
+
+    // exceeds capacity
+    auto v5 = pool::make(1);
+    auto v6 = pool::make(1);
+    auto v7 = pool::make(1);
+    pool::release(v5);
+    pool::release(v6);
+    pool::release(v7);
+    ASSERT_NE(0, pool::make(0).capacity());
+    ASSERT_NE(0, pool::make(0).capacity());
+    ASSERT_EQ(0, pool::make(0).capacity());
+  }).join();
+}
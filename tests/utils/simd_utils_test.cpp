@@ -24,8 +24,10 @@
 
 #include <cstring>
 
+#include "utils/cpuinfo.hpp"
 #include "utils/misc.hpp"
 #include "utils/std.hpp"
+#include "utils/simd_dispatch.hpp"
 #include "utils/simd_utils.hpp"
 
 TEST(simd_utils_test, delta32) {
@@ -203,3 +205,70 @@ TEST(simd_utils_test, maxbits) {
     ASSERT_EQ(irs::packed::maxbits64(max), irs::simd::maxbits<true>(values, IRESEARCH_COUNTOF(values)));
   }
 }
+
+TEST(simd_utils_test, dispatch) {
+  constexpr size_t BLOCK_SIZE = irs::simd::dispatch::kDeltaBlockSize;
+
+  uint32_t values[BLOCK_SIZE];
+  std::iota(std::begin(values), std::end(values), 42);
+  uint32_t freqs[irs::simd::dispatch::kScoreBlockSize];
+  std::iota(std::begin(freqs), std::end(freqs), 1);
+  float_t norms[IRESEARCH_COUNTOF(freqs)];
+  std::fill(std::begin(norms), std::end(norms), 0.5f);
+
+  // every kernel must yield the same results regardless of the target
+  for (const uint32_t target : hwy::SupportedAndGeneratedTargets()) {
+    hwy::SetSupportedTargetsForTest(target);
+    ASSERT_STREQ(hwy::TargetName(target), irs::cpuinfo::simd_target());
+
+    ASSERT_EQ(0, irs::simd::dispatch::count_less(values, BLOCK_SIZE, 42));
+    ASSERT_EQ(57, irs::simd::dispatch::count_less(values, BLOCK_SIZE, 99));
+    ASSERT_EQ(BLOCK_SIZE, irs::simd::dispatch::count_less(values, BLOCK_SIZE, 1000));
+    ASSERT_EQ((std::pair<uint32_t, uint32_t>(42, 42 + BLOCK_SIZE - 2)),
+              irs::simd::dispatch::maxmin(values, BLOCK_SIZE - 1));
+    ASSERT_EQ(irs::packed::maxbits32(42 + BLOCK_SIZE - 1),
+              irs::simd::dispatch::maxbits(values, BLOCK_SIZE));
+    ASSERT_FALSE(irs::simd::dispatch::all_equal(values, BLOCK_SIZE));
+    ASSERT_TRUE(irs::simd::dispatch::all_equal(values, 1));
+
+    {
+      uint32_t encoded[BLOCK_SIZE];
+      std::memcpy(encoded, values, sizeof values);
+      irs::simd::dispatch::delta_encode(encoded, 40);
+      ASSERT_EQ(2, encoded[0]);
+      ASSERT_TRUE(std::all_of(std::begin(encoded) + 1, std::end(encoded),
+                              [](auto v) { return 1 == v; }));
+    }
+
+    {
+      // tail of a block is processed separately
+      constexpr size_t count = IRESEARCH_COUNTOF(freqs) - 3;
+      float_t scores[IRESEARCH_COUNTOF(freqs)]{};
+
+      irs::simd::dispatch::score_tfidf(freqs, norms, count, scores, 2.f);
+      for (size_t i = 0; i < count; ++i) {
+        ASSERT_FLOAT_EQ(2.f * std::sqrt(float_t(freqs[i])) * 0.5f, scores[i]);
+      }
+      ASSERT_EQ(0.f, scores[count]);
+
+      irs::simd::dispatch::score_bm25(freqs, count, scores, 3.f, 2.f);
+      for (size_t i = 0; i < count; ++i) {
+        ASSERT_FLOAT_EQ(3.f - 3.f / (1.f + freqs[i] / 2.f), scores[i]);
+      }
+
+      irs::simd::dispatch::score_bm25_inv(freqs, norms, count, scores, 3.f);
+      for (size_t i = 0; i < count; ++i) {
+        ASSERT_FLOAT_EQ(3.f - 3.f / (1.f + freqs[i] * 0.5f), scores[i]);
+      }
+
+      irs::simd::dispatch::score_bm25_norm(freqs, norms, count, scores,
+                                           3.f, 1.f, 2.f, true);
+      for (size_t i = 0; i < count; ++i) {
+        const float_t tf = std::sqrt(float_t(freqs[i]));
+        ASSERT_FLOAT_EQ(3.f - 3.f * 2.f / (2.f + tf), scores[i]);
+      }
+    }
+  }
+
+  hwy::SetSupportedTargetsForTest(0);
+}
@@ -59,6 +59,7 @@
 #include "search/prefix_filter.hpp"
 #include "search/score.hpp"
 #include "search/term_filter.hpp"
+#include "search/top_docs_collector.hpp"
 #include "search/wildcard_filter.hpp"
 #include "search/ngram_similarity_filter.hpp"
 #include "store/fs_directory.hpp"
@@ -586,8 +587,7 @@ int search(
       const timers_t building_timers("building");
       const timers_t execution_timers("execution");
 
-      std::vector<std::pair<float_t, irs::doc_id_t>> sorted;
-      sorted.reserve(limit);
+      irs::top_docs_collector top_docs(order, limit);
 
       // process a single task
       for (const task_t* task; (task = task_provider.pop()) != nullptr;) {
@@ -596,10 +596,11 @@ int search(
         std::this_thread::sleep_for(
             std::chrono::milliseconds(
                 static_cast<unsigned>(100. * (static_cast<double>(rand()) / static_cast<double>(RAND_MAX)))));
-        size_t doc_count = 0;
+        size_t doc_count = 0; // number of matched documents
+        size_t visited_count = 0; // number of documents visited by collector
         const auto start = std::chrono::system_clock::now();
 
-        sorted.clear();
+        top_docs.clear();
 
         // parse task
         {
@@ -615,73 +616,27 @@ int search(
         {
           irs::timer_utils::scoped_timer timer(*(execution_timers.stat[size_t(task->category)]));
 
-          for (auto& segment: reader) {
-            auto docs = filter->execute(segment, order); // query segment
-            const irs::score* score = irs::get<irs::score>(*docs);
-            assert(score);
-            const irs::document* doc = irs::get<irs::document>(*docs);
-            assert(doc);
-
-            while (docs->next()) {
-              ++doc_count;
-              const float_t score_value = *reinterpret_cast<const float_t*>(score->evaluate());
-
-              if (sorted.size() < limit) {
-                sorted.emplace_back(score_value, doc->value);
-
-                std::push_heap(
-                  sorted.begin(), sorted.end(),
-                  [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                     const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                    return lhs.first < rhs.first;
-                });
-              } else if (sorted.front().first < score_value) {
-                std::pop_heap(
-                  sorted.begin(), sorted.end(),
-                  [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                     const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                    return lhs.first < rhs.first;
-                });
-
-                auto& back = sorted.back();
-                back.first = score_value;
-                back.second = doc->value;
-
-                std::push_heap(
-                  sorted.begin(), sorted.end(),
-                  [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                     const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                    return lhs.first < rhs.first;
-                });
-              }
-            }
-          }
-
-          auto end = sorted.end();
-          for (auto begin = sorted.begin(); begin != end; --end) {
-            std::pop_heap(
-              begin, end,
-              [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                 const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                return lhs.first < rhs.first;
-            });
-          }
+          visited_count = top_docs.collect(reader, *filter);
         }
 
         const auto tdiff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
 
+        // collector skips non-competitive documents, count all matches
+        // separately to not affect the measured time
+        doc_count = filter->count(reader, std::numeric_limits<uint64_t>::max()).value;
+
         // output task results
         {
           std::stringstream ss;
           if (csv) {
-            ss << stringCategory(task->category) << "," << task->text << "," << doc_count << "," << tdiff.count() / 1000. << "," << tdiff.count() << '\n';
+            ss << stringCategory(task->category) << "," << task->text << "," << doc_count << "," << tdiff.count() / 1000. << "," << tdiff.count() << "," << visited_count << '\n';
           } else {
-            ss << "TASK: cat=" << stringCategory(task->category) << " q='body:" << task->text << "' hits=" << doc_count << '\n'
+            ss << "TASK: cat=" << stringCategory(task->category) << " q='body:" << task->text << "' hits=" << doc_count << " visited=" << visited_count << '\n'
                 << "  " << tdiff.count() / 1000. << " msec\n"
                 << "  thread " << std::this_thread::get_id() << '\n';
 
-            for (auto& entry : sorted) {
-              ss << "  doc=" << entry.second << " score=" << entry.first << '\n';
+            for (auto& entry : top_docs.sorted()) {
+              ss << "  doc=" << entry.doc << " score=" << order.get<float_t>(entry.score, 0) << '\n';
             }
 
             ss << '\n';